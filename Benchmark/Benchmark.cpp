@@ -0,0 +1,746 @@
+/**
+ * @file Benchmark.cpp
+ * @brief Micro-benchmark suite for the DSP modules and the full AudioEngine.
+ *
+ * Every benchmark streams the same seeded white noise through one object, block by block, and
+ * measures the time per processed stereo sample. Three groups are measured:
+ * - **module**: single DSP building blocks in isolation (filters, delays, convolver, sample rate converters,
+ *   early reflections, decay, bitcrusher, silence detector)
+ * - **effect**: the Reverb (each reverb type), the Granulator and the RingModulator (each oversampling ratio)
+ * - **engine**: the full AudioEngine in each effect order, with each reverb type and each oversampling ratio,
+ *   and a custom effect graph
+ *
+ * Reported per benchmark:
+ * - ns/sample: median over all repeats (the minimum is reported as well)
+ * - cycles/sample: read from the time stamp counter on x86, estimated from `--cpu-ghz` on other targets
+ * - budget: percentage of the real-time budget of the BELA default setup (44.1 kHz, 16 frames per block)
+ *
+ * The results are written as JSON, so that runs of different commits can be compared, either by hand
+ * or with `--compare`.
+ *
+ * Build (from the repository root, on ARM or x86, see Simd.h):
+ *
+ *     g++ -std=c++17 -O2 -DGRAINMOTHER_OFFLINE -ICode -o grainmother-benchmark \
+ *         $(find Benchmark Code -name '*.cpp')
+ *
+ * Usage:
+ *
+ *     grainmother-benchmark [--output <file.json>] [--compare <baseline.json>] [--filter <text>]
+ *                           [--seconds <seconds>] [--repeats <count>] [--blocksize <frames>] [--cpu-ghz <GHz>]
+ *
+ * - output: the JSON result file, default benchmark.json
+ * - compare: a result file of an earlier run, the change of every benchmark is printed
+ * - filter: only runs benchmarks whose "group/name" contains the text
+ * - seconds: length of the noise input, default 2
+ * - repeats: number of timed passes over the input, default 5
+ * - blocksize: frames per block, default 16 (the BELA default)
+ * - cpu-ghz: clock rate used to estimate cycles where no cycle counter is available, default 1 (BeagleBone)
+ */
+
+#include "../Code/Engine.h"
+
+#include <chrono>
+#include <fstream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// =======================================================================================
+// MARK: - VARIABLES
+// =======================================================================================
+
+namespace BenchmarkVariables
+{
+
+static const float SAMPLE_RATE = 44100.f;
+static const uint DEFAULT_BLOCKSIZE = 16;
+
+// the real-time budget every result is related to: one 16 frame block at 44.1 kHz
+static const float BUDGET_SAMPLE_RATE = 44100.f;
+static const uint BUDGET_BLOCKSIZE = 16;
+static const double BUDGET_NS_PER_BLOCK = 1e9 * BUDGET_BLOCKSIZE / BUDGET_SAMPLE_RATE;
+
+// the input is always the same seeded noise
+static const uint NOISE_SEED = 7;
+static const float NOISE_AMPLITUDE = 0.3f;
+
+// warm up passes are not timed, they fill delay lines and let ramps settle
+static const float WARMUP_SECONDS = 0.25f;
+
+#if defined(__x86_64__) || defined(__i386__)
+static const bool HAS_CYCLE_COUNTER = true;
+#else
+static const bool HAS_CYCLE_COUNTER = false;
+#endif
+
+#if defined(GRAINMOTHER_SIMD_NEON)
+static const String SIMD_BACKEND = "neon";
+#elif defined(GRAINMOTHER_SIMD_SSE)
+static const String SIMD_BACKEND = "sse";
+#else
+static const String SIMD_BACKEND = "scalar";
+#endif
+
+/**
+ * @struct Settings
+ * @brief The command line options.
+ */
+struct Settings
+{
+    String outputPath = "benchmark.json";
+    String comparePath;
+    String filter;
+    float seconds = 2.f;
+    uint repeats = 5;
+    uint blockSize = DEFAULT_BLOCKSIZE;
+    double cpuGHz = 1.0;
+};
+
+Settings settings;
+std::vector<float> input[2], output[2];
+json results = json::array();
+
+AudioEngine engine;
+
+} // namespace BenchmarkVariables
+
+using namespace BenchmarkVariables;
+
+
+// =======================================================================================
+// MARK: - HELPERS
+// =======================================================================================
+
+void printUsage()
+{
+    rt_printf("usage: grainmother-benchmark [--output <file.json>] [--compare <baseline.json>] [--filter <text>] "
+              "[--seconds <seconds>] [--repeats <count>] [--blocksize <frames>] [--cpu-ghz <GHz>]\n");
+}
+
+
+/** @brief Reads the time stamp counter, returns 0 where there is none. */
+inline uint64_t readCycleCounter()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+
+/** @brief Returns the median of a (copied) vector. */
+double median(std::vector<double> values_)
+{
+    std::sort(values_.begin(), values_.end());
+    const size_t mid = values_.size() / 2;
+    return (values_.size() % 2) ? values_[mid] : 0.5 * (values_[mid - 1] + values_[mid]);
+}
+
+
+/**
+ * @brief Runs a per-sample process function over a block, for the modules without a block path.
+ *
+ * @param input_ Pointers to the left and right input channel.
+ * @param output_ Pointers to the left and right output channel.
+ * @param numFrames_ The number of samples per channel.
+ * @param process_ Called with the stereo input sample and the sample index, returns the stereo output sample.
+ */
+template <class ProcessSample>
+inline void processSamplewise(const float* const input_[2], float* const output_[2], const uint numFrames_, ProcessSample&& process_)
+{
+    for (uint n = 0; n < numFrames_; ++n)
+    {
+        float32x2_t out = process_(makeStereo(input_[0][n], input_[1][n]), n);
+        output_[0][n] = vget_lane_f32(out, 0);
+        output_[1][n] = vget_lane_f32(out, 1);
+    }
+}
+
+
+/**
+ * @brief Times a process function over the noise input and stores the result.
+ *
+ * The process function is called once per block with the same signature as `processAudioBlock()`.
+ * Before the block is processed, `update_` is called, like render() calls `updateAudioBlock()`.
+ *
+ * @param group_ The benchmark group (module, effect or engine).
+ * @param name_ The name of the benchmark, unique within its group.
+ * @param config_ Additional settings that describe the benchmark, copied into the JSON result.
+ * @param update_ Called once before each block.
+ * @param process_ Processes one block.
+ */
+template <class Update, class Process>
+void runBenchmark(const String& group_, const String& name_, const json& config_, Update&& update_, Process&& process_)
+{
+    const String key = group_ + "/" + name_;
+    if (!settings.filter.empty() && key.find(settings.filter) == String::npos) return;
+    
+    const uint blockSize = settings.blockSize;
+    const size_t numFrames = input[0].size() / blockSize * blockSize;
+    
+    auto processPass = [&](const size_t numPassFrames_)
+    {
+        for (size_t frame = 0; frame < numPassFrames_; frame += blockSize)
+        {
+            const float* const in[2] = { input[0].data() + frame, input[1].data() + frame };
+            float* const out[2] = { output[0].data() + frame, output[1].data() + frame };
+            
+            update_();
+            process_(in, out, blockSize);
+        }
+    };
+    
+    // warm up
+    processPass(std::min(numFrames, (size_t)(WARMUP_SECONDS * SAMPLE_RATE) / blockSize * blockSize));
+    
+    std::vector<double> nsPerSample, cyclesPerSample;
+    double checksum = 0.0;
+    
+    for (uint r = 0; r < settings.repeats; ++r)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+        uint64_t startCycles = readCycleCounter();
+        
+        processPass(numFrames);
+        
+        uint64_t endCycles = readCycleCounter();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+        
+        nsPerSample.push_back(ns / numFrames);
+        cyclesPerSample.push_back(HAS_CYCLE_COUNTER ? (double)(endCycles - startCycles) / numFrames
+                                                    : ns * settings.cpuGHz / numFrames);
+        
+        // reading the output keeps the compiler from dropping the processing,
+        // the sum of the last pass also shows if a change altered the output
+        checksum = 0.0;
+        for (uint ch = 0; ch < 2; ++ch)
+            for (size_t n = 0; n < numFrames; ++n) checksum += std::abs(output[ch][n]);
+    }
+    
+    json result;
+    result["group"] = group_;
+    result["name"] = name_;
+    result["config"] = config_;
+    result["nsPerSample"] = median(nsPerSample);
+    result["nsPerSampleMin"] = *std::min_element(nsPerSample.begin(), nsPerSample.end());
+    result["cyclesPerSample"] = median(cyclesPerSample);
+    result["budgetPercent"] = 100.0 * median(nsPerSample) * BUDGET_BLOCKSIZE / BUDGET_NS_PER_BLOCK;
+    result["checksum"] = checksum;
+    results.push_back(result);
+    
+    rt_printf("%-56s %9.2f ns/sample %9.1f cycles/sample %7.2f %% budget\n", key.c_str(),
+              result["nsPerSample"].get<double>(), result["cyclesPerSample"].get<double>(),
+              result["budgetPercent"].get<double>());
+}
+
+
+/** @brief Shorthand for benchmarks without an update function. */
+template <class Process>
+void runBenchmark(const String& group_, const String& name_, const json& config_, Process&& process_)
+{
+    runBenchmark(group_, name_, config_, [] {}, std::forward<Process>(process_));
+}
+
+
+/** @brief The oversampling values that select the ratios 2, 4, 8 and 16, see RingModulator::setOversampling(). */
+static const uint OVERSAMPLING_VALUES[] = { 1, 2, 3, 4 };
+
+/** @brief Maps an oversampling value to the oversampling ratio. */
+uint getOversamplingRatio(const uint value_) { return 1u << value_; }
+
+
+// =======================================================================================
+// MARK: - MODULES
+// =======================================================================================
+
+void benchmarkModules()
+{
+    using namespace Reverberation;
+    
+    {
+        Granulation::FilterStereo filter;
+        filter.setup(SAMPLE_RATE, 5000.f);
+        
+        runBenchmark("module", "granulation/filter_stereo", { { "cutoff", 5000.f } },
+                     [&](const float* const in_[2], float* const out_[2], const uint numFrames_)
+        {
+            processSamplewise(in_, out_, numFrames_, [&](float32x2_t x_, uint) { return filter.processAudioSamples(x_); });
+        });
+    }
+    
+    {
+        Granulation::HighPassFilter filter;
+        filter.setup(80.f, SAMPLE_RATE);
+        
+        runBenchmark("module", "granulation/highpass_filter", { { "cutoff", 80.f } },
+                     [&](const float* const in_[2], float* const out_[2], const uint numFrames_)
+        {
+            for (uint n = 0; n < numFrames_; ++n)
+            {
+                StereoFloat out = filter.process({ in_[0][n], in_[1][n] });
+                out_[0][n] = out.leftSample;
+                out_[1][n] = out.rightSample;
+            }
+        });
+    }
+    
+    {
+        Granulation::Delay delay;
+        delay.setup(SAMPLE_RATE);
+        
+        runBenchmark("module", "granulation/delay", json::object(),
+                     [&](const float* const in_[2], float* const out_[2], const uint numFrames_)
+        {
+            processSamplewise(in_, out_, numFrames_, [&](float32x2_t x_, uint n_) { return delay.processAudioSamples(x_, n_); });
+        });
+    }
+    
+    {
+        static ConvolverStereo convolver;
+        convolver.setup(RingModulation::OVERSAMPLING_FILTER_LENGTH, LPF_64_882);
+        
+        runBenchmark("module", "ringmodulation/convolver_stereo", { { "taps", RingModulation::OVERSAMPLING_FILTER_LENGTH } },
+                     [&](const float* const in_[2], float* const out_[2], const uint numFrames_)
+        {
+            processSamplewise(in_, out_, numFrames_, [&](float32x2_t x_, uint) { return convolver.processAudioSamples(x_); });
+        });
+    }
+    
+    // interpolator and decimator back to back, as in the RingModulator
+    for (uint ratio : { 2, 4, 8, 16 })
+    {
+        static InterpolatorStereo interpolator;
+        static DecimatorStereo decimator;
+        interpolator.setup(SAMPLE_RATE, ratio, RingModulation::OVERSAMPLING_FILTER_LENGTH);
+        decimator.setup(SAMPLE_RATE, ratio, RingModulation::OVERSAMPLING_FILTER_LENGTH);
+        
+        runBenchmark("module", "ringmodulation/resampler_x" + std::to_string(ratio),
+                     { { "ratio", ratio }, { "taps", RingModulation::OVERSAMPLING_FILTER_LENGTH } },
+                     [&](const float* const in_[2], float* const out_[2], const uint numFrames_)
+        {
+            processSamplewise(in_, out_, numFrames_, [&](float32x2_t x_, uint)
+            {
+                InterpolatorStereoOutput upsampled = interpolator.interpolateAudio(x_);
+                DecimatorStereoInput decimatorInput;
+                std::copy(upsampled.audioData, upsampled.audioData + ratio, decimatorInput.audioData);
+                return decimator.decimateAudio(decimatorInput);
+            });
+        });
+    }
+    
+    // the same, a whole block at a time, as in RingModulator::processAudioBlock
+    for (uint ratio : { 2, 4, 8, 16 })
+    {
+        static InterpolatorStereo interpolator;
+        static DecimatorStereo decimator;
+        interpolator.setup(SAMPLE_RATE, ratio, RingModulation::OVERSAMPLING_FILTER_LENGTH);
+        decimator.setup(SAMPLE_RATE, ratio, RingModulation::OVERSAMPLING_FILTER_LENGTH);
+        std::vector<float32x2_t> upsampled(settings.blockSize * ratio);
+        
+        runBenchmark("module", "ringmodulation/resampler_block_x" + std::to_string(ratio),
+                     { { "ratio", ratio }, { "taps", RingModulation::OVERSAMPLING_FILTER_LENGTH } },
+                     [&](const float* const in_[2], float* const out_[2], const uint numFrames_)
+        {
+            interpolator.interpolateBlock(in_, upsampled.data(), numFrames_);
+            decimator.decimateBlock(upsampled.data(), out_, numFrames_);
+        });
+    }
+    
+    // a cascade of half-band stages, the first one with the length of the polyphase filters, linear phase above 2x
+    for (uint ratio : { 2, 4, 8, 16 })
+    {
+        static HalfbandInterpolatorStereo interpolator;
+        static HalfbandDecimatorStereo decimator;
+        interpolator.setup(ratio, RingModulation::OVERSAMPLING_FILTER_LENGTH);
+        decimator.setup(ratio, RingModulation::OVERSAMPLING_FILTER_LENGTH);
+        std::vector<float32x2_t> upsampled(settings.blockSize * ratio);
+        
+        runBenchmark("module", "ringmodulation/halfband_block_x" + std::to_string(ratio),
+                     { { "ratio", ratio }, { "taps", RingModulation::OVERSAMPLING_FILTER_LENGTH } },
+                     [&](const float* const in_[2], float* const out_[2], const uint numFrames_)
+        {
+            interpolator.interpolateBlock(in_, upsampled.data(), numFrames_);
+            decimator.decimateBlock(upsampled.data(), out_, numFrames_);
+        });
+    }
+    
+    // a cascade of allpass half-band stages, the low latency resampler of the ring modulator
+    for (uint ratio : { 2, 4, 8, 16 })
+    {
+        static AllpassInterpolatorStereo interpolator;
+        static AllpassDecimatorStereo decimator;
+        interpolator.setup(ratio);
+        decimator.setup(ratio);
+        std::vector<float32x2_t> upsampled(settings.blockSize * ratio);
+        
+        runBenchmark("module", "ringmodulation/allpass_block_x" + std::to_string(ratio), { { "ratio", ratio } },
+                     [&](const float* const in_[2], float* const out_[2], const uint numFrames_)
+        {
+            interpolator.interpolateBlock(in_, upsampled.data(), numFrames_);
+            decimator.decimateBlock(upsampled.data(), out_, numFrames_);
+        });
+    }
+    
+    {
+        BitCrusher bitcrusher;
+        bitcrusher.setBitResolution(6.f);
+        bitcrusher.setSmoothing(50.f);
+        
+        runBenchmark("module", "ringmodulation/bitcrusher", { { "bits", 6 }, { "smoothing", 50 } },
+                     [&] { bitcrusher.updateAudioBlock(); },
+                     [&](const float* const in_[2], float* const out_[2], const uint numFrames_)
+        {
+            processSamplewise(in_, out_, numFrames_, [&](float32x2_t x_, uint) { return bitcrusher.processAudioSample(x_); });
+        });
+    }
+    
+    // the output clipper of the granulator, driven into saturation
+    runBenchmark("module", "helpers/tanh_table", { { "drive", 4 } },
+                 [&](const float* const in_[2], float* const out_[2], const uint numFrames_)
+    {
+        processSamplewise(in_, out_, numFrames_, [&](float32x2_t x_, uint)
+        {
+            return makeStereo(approximateTanh(4.f * vget_lane_f32(x_, 0)), approximateTanh(4.f * vget_lane_f32(x_, 1)));
+        });
+    });
+    
+    runBenchmark("module", "helpers/tanh_rational", { { "drive", 4 } },
+                 [&](const float* const in_[2], float* const out_[2], const uint numFrames_)
+    {
+        processSamplewise(in_, out_, numFrames_, [&](float32x2_t x_, uint) { return approximateTanh(vmul_n_f32(x_, 4.f)); });
+    });
+    
+    // the noise ring modulation of the ring modulator
+    {
+        NoiseGenerator noise;
+        std::vector<float32x2_t> noiseBuffer(settings.blockSize);
+        
+        runBenchmark("module", "helpers/noise_block", json::object(),
+                     [&](const float* const in_[2], float* const out_[2], const uint numFrames_)
+        {
+            noise.fillBlock(noiseBuffer.data(), numFrames_);
+            processSamplewise(in_, out_, numFrames_, [&](float32x2_t x_, uint n_) { return vmul_f32(x_, noiseBuffer[n_]); });
+        });
+    }
+    
+    // the detector only observes the signal, the input is passed through
+    {
+        SilenceDetector detector;
+        detector.setup(SAMPLE_RATE);
+        
+        runBenchmark("module", "helpers/silence_detector", { { "hold", SilenceDetector::DEFAULT_HOLD_TIME } },
+                     [&](const float* const in_[2], float* const out_[2], const uint numFrames_)
+        {
+            detector.processAudioBlock(in_, numFrames_);
+            std::copy(in_[0], in_[0] + numFrames_, out_[0]);
+            std::copy(in_[1], in_[1] + numFrames_, out_[1]);
+        });
+    }
+    
+    // the reverb modules use the type parameters of the church (see Reverb::createType())
+    {
+        using Room = EarlyReflectionsTypeParameters::Room;
+        
+        // the early reflections don't copy their type parameters, they have to outlive them
+        static EarlyReflections::EarlyReflectionsTypeParametersPtr typeParameters = EarlyReflections::createTypeParameters(
+            EarlyReflectionsTypeParameters(Room::CHURCH, -0.42f, 0.67f, earliesLatestDelaySamples[Room::CHURCH]));
+        
+        static EarlyReflections earlyReflections;
+        earlyReflections.setTypeParameters(*typeParameters);
+        earlyReflections.setup(SAMPLE_RATE, settings.blockSize);
+        
+        runBenchmark("module", "reverberation/early_reflections", { { "reverb_type", reverbTypeNames[0] } },
+                     [&](const float* const in_[2], float* const out_[2], const uint numFrames_)
+        {
+            processSamplewise(in_, out_, numFrames_, [&](float32x2_t x_, uint n_) { return earlyReflections.processAudioSamples(x_, n_); });
+        });
+    }
+    
+    {
+        DecayTypeParameters decayTypeParams
+        ("Church", -0.83f, 0.27f,
+         8, { 3391, 3637, 3881, 4127, 4363, 4603, 4861, 5087 },
+         0, {},
+         4, { 264, 74, 423, 105 },
+         0.68f, 0.59f, 6.12f, SAMPLE_RATE);
+        
+        auto decay = std::make_unique<Decay>(decayTypeParams);
+        decay->setup(DecayParameters(), SAMPLE_RATE, settings.blockSize);
+        
+        runBenchmark("module", "reverberation/decay", { { "reverb_type", reverbTypeNames[0] } },
+                     [&](const float* const in_[2], float* const out_[2], const uint numFrames_)
+        {
+            processSamplewise(in_, out_, numFrames_, [&](float32x2_t x_, uint n_) { return decay->processAudioSamples(x_, n_); });
+        });
+    }
+}
+
+
+// =======================================================================================
+// MARK: - EFFECTS
+// =======================================================================================
+
+void benchmarkEffects()
+{
+    for (uint type = 0; type < Reverberation::NUM_TYPES; ++type)
+    {
+        auto reverb = std::make_unique<Reverberation::Reverb>();
+        reverb->setup(SAMPLE_RATE, settings.blockSize);
+        reverb->parameterChanged(Reverberation::Parameters::TYPE, type);
+        
+        runBenchmark("effect", "reverb[" + Reverberation::reverbTypeNames[type] + "]",
+                     { { "reverb_type", Reverberation::reverbTypeNames[type] } },
+                     [&](const float* const in_[2], float* const out_[2], const uint numFrames_)
+        {
+            reverb->processAudioBlock(in_, out_, numFrames_);
+        });
+    }
+    
+    {
+        auto granulator = std::make_unique<Granulation::Granulator>();
+        granulator->setup(SAMPLE_RATE, settings.blockSize);
+        
+        runBenchmark("effect", "granulator", json::object(),
+                     [&](const float* const in_[2], float* const out_[2], const uint numFrames_)
+        {
+            granulator->processAudioBlock(in_, out_, numFrames_);
+        });
+    }
+    
+    // the worst case: the longest grains at the highest density
+    {
+        auto granulator = std::make_unique<Granulation::Granulator>();
+        granulator->setup(SAMPLE_RATE, settings.blockSize);
+        granulator->parameterChanged(Granulation::Parameters::GRAINLENGTH, Granulation::MAX_GRAINLENGTH_MS);
+        granulator->parameterChanged(Granulation::Parameters::DENSITY, Granulation::MAX_DENSITY);
+        
+        runBenchmark("effect", "granulator[max density]",
+                     { { "density", Granulation::MAX_DENSITY }, { "grainlength_ms", Granulation::MAX_GRAINLENGTH_MS } },
+                     [&](const float* const in_[2], float* const out_[2], const uint numFrames_)
+        {
+            granulator->processAudioBlock(in_, out_, numFrames_);
+        });
+    }
+    
+    for (uint resampler = 0; resampler < RingModulation::NUM_RESAMPLERS; ++resampler)
+    {
+        for (uint oversampling : OVERSAMPLING_VALUES)
+        {
+            const uint ratio = getOversamplingRatio(oversampling);
+            
+            // the crossfades to the selected ratio and resampler finish during the warm up
+            auto ringModulator = std::make_unique<RingModulation::RingModulator>();
+            ringModulator->setup(SAMPLE_RATE, settings.blockSize);
+            ringModulator->setOversampling(oversampling);
+            ringModulator->setResampler(resampler);
+            
+            String name = "ringmodulator[x" + std::to_string(ratio) + "]";
+            if (resampler == RingModulation::RingModulator::LOW_LATENCY) name += "[low latency]";
+            
+            runBenchmark("effect", name, { { "oversampling", ratio }, { "resampler", RingModulation::resamplerNames[resampler] } },
+                         [&] { ringModulator->updateAudioBlock(); },
+                         [&](const float* const in_[2], float* const out_[2], const uint numFrames_)
+            {
+                ringModulator->processAudioBlock(in_, out_, numFrames_);
+            });
+        }
+    }
+}
+
+
+// =======================================================================================
+// MARK: - ENGINE
+// =======================================================================================
+
+void benchmarkEngine()
+{
+    engine.setup(SAMPLE_RATE, settings.blockSize);
+    
+    ChoiceParameter* effectOrder = static_cast<ChoiceParameter*>(engine.getParameter("effect_order"));
+    AudioParameter* reverbType = engine.getParameter("reverb", "reverb_type");
+    RingModulatorProcessor* ringModulator = static_cast<RingModulatorProcessor*>(engine.getEffect(ENUM2INT(EffectOrder::RINGMODULATOR)));
+    
+    for (uint type = 0; type < Reverberation::NUM_TYPES; ++type)
+    {
+        reverbType->setValue((int)type);
+        
+        for (uint oversampling : OVERSAMPLING_VALUES)
+        {
+            const uint ratio = getOversamplingRatio(oversampling);
+            ringModulator->getRingModulator().setOversampling(oversampling);
+            
+            for (uint order = 0; order < effectOrder->getNumChoices(); ++order)
+            {
+                effectOrder->setValue((int)order);
+                engine.setEffectOrder();
+                
+                String orderName = effectOrder->getChoiceNames()[order];
+                
+                runBenchmark("engine", "[" + orderName + "][" + Reverberation::reverbTypeNames[type] + "][x" + std::to_string(ratio) + "]",
+                             { { "effect_order", orderName }, { "reverb_type", Reverberation::reverbTypeNames[type] },
+                               { "oversampling", ratio } },
+                             [&] { engine.updateAudioBlock(); },
+                             [&](const float* const in_[2], float* const out_[2], const uint numFrames_)
+                {
+                    engine.processAudioBlock(in_, out_, numFrames_);
+                });
+            }
+        }
+    }
+    
+    // a graph beyond the effect orders: two granulators in parallel into the reverb
+    {
+        std::unique_ptr<EffectGraph> graph(new EffectGraph);
+        
+        const int granulator = graph->addSlot(engine.getEffect(ENUM2INT(EffectOrder::GRANULATOR)), EffectOrder::GRANULATOR);
+        const int granulator2 = graph->addSlot(engine.createEffect(EffectOrder::GRANULATOR, "granulator2"), EffectOrder::GRANULATOR);
+        const int reverb = graph->addSlot(engine.getEffect(ENUM2INT(EffectOrder::REVERB)), EffectOrder::REVERB);
+        
+        graph->connect(EffectGraph::GRAPH_INPUT, granulator);
+        graph->connect(EffectGraph::GRAPH_INPUT, granulator2, 0.5f);
+        graph->connect(granulator, reverb);
+        graph->connect(granulator2, reverb);
+        graph->connect(reverb, EffectGraph::GRAPH_OUTPUT);
+        
+        engine.setEffectGraph((uint)engine.addEffectGraph(std::move(graph)));
+        
+        runBenchmark("engine", "graph[2 granulators - reverb]", { { "effect_graph", "2 granulators - reverb" } },
+                     [&] { engine.updateAudioBlock(); },
+                     [&](const float* const in_[2], float* const out_[2], const uint numFrames_)
+        {
+            engine.processAudioBlock(in_, out_, numFrames_);
+        });
+    }
+}
+
+
+// =======================================================================================
+// MARK: - COMPARE
+// =======================================================================================
+
+/**
+ * @brief Prints the change in ns/sample of every benchmark that is also part of the baseline.
+ * @param path_ The path of the baseline result file.
+ */
+void compareResults(const String& path_)
+{
+    std::ifstream file(path_);
+    if (!file.is_open())
+    {
+        rt_printf("could not open %s\n", path_.c_str());
+        return;
+    }
+    
+    json baseline = json::parse(file, nullptr, false);
+    if (baseline.is_discarded() || !baseline.contains("results"))
+    {
+        rt_printf("%s is not a benchmark result file\n", path_.c_str());
+        return;
+    }
+    
+    std::map<String, double> baselineNsPerSample;
+    for (const json& result : baseline["results"])
+        baselineNsPerSample[result["group"].get<String>() + "/" + result["name"].get<String>()] = result["nsPerSample"].get<double>();
+    
+    rt_printf("\nchange against %s:\n", path_.c_str());
+    
+    for (const json& result : results)
+    {
+        const String key = result["group"].get<String>() + "/" + result["name"].get<String>();
+        auto match = baselineNsPerSample.find(key);
+        if (match == baselineNsPerSample.end()) continue;
+        
+        const double change = 100.0 * (result["nsPerSample"].get<double>() / match->second - 1.0);
+        rt_printf("%-56s %9.2f -> %9.2f ns/sample %+7.1f %%\n", key.c_str(), match->second,
+                  result["nsPerSample"].get<double>(), change);
+    }
+}
+
+
+// =======================================================================================
+// MARK: - MAIN
+// =======================================================================================
+
+int main(int argc, char* argv[])
+{
+    // parse the options
+    for (int n = 1; n < argc; ++n)
+    {
+        String option = argv[n];
+        
+        if (n + 1 >= argc)
+        {
+            printUsage();
+            return 1;
+        }
+        
+        String value = argv[++n];
+        
+        if (option == "--output") settings.outputPath = value;
+        else if (option == "--compare") settings.comparePath = value;
+        else if (option == "--filter") settings.filter = value;
+        else if (option == "--seconds") settings.seconds = std::stof(value);
+        else if (option == "--repeats") settings.repeats = (uint)std::stoul(value);
+        else if (option == "--blocksize") settings.blockSize = (uint)std::stoul(value);
+        else if (option == "--cpu-ghz") settings.cpuGHz = std::stod(value);
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+    
+    if (settings.blockSize == 0 || settings.repeats == 0 || settings.seconds * SAMPLE_RATE < settings.blockSize)
+    {
+        printUsage();
+        return 1;
+    }
+    
+    // fixed noise input, the same for every benchmark and every run
+    std::mt19937 generator(NOISE_SEED);
+    std::uniform_real_distribution<float> distribution(-NOISE_AMPLITUDE, NOISE_AMPLITUDE);
+    
+    const size_t numFrames = (size_t)(settings.seconds * SAMPLE_RATE);
+    for (uint ch = 0; ch < 2; ++ch)
+    {
+        input[ch].resize(numFrames);
+        output[ch].assign(numFrames, 0.f);
+        for (float& sample : input[ch]) sample = distribution(generator);
+    }
+    
+    rt_printf("simd: %s, cycles: %s, block size: %u, %u x %.2f s of noise\n\n", SIMD_BACKEND.c_str(),
+              HAS_CYCLE_COUNTER ? "time stamp counter" : "estimated", settings.blockSize, settings.repeats, settings.seconds);
+    
+    benchmarkModules();
+    benchmarkEffects();
+    benchmarkEngine();
+    
+    // write the results
+    json document;
+    document["simd"] = SIMD_BACKEND;
+    document["compiler"] = __VERSION__;
+    document["cycleSource"] = HAS_CYCLE_COUNTER ? "tsc" : "estimated";
+    document["cpuGHz"] = settings.cpuGHz;
+    document["sampleRate"] = SAMPLE_RATE;
+    document["blockSize"] = settings.blockSize;
+    document["seconds"] = settings.seconds;
+    document["repeats"] = settings.repeats;
+    document["budget"] = { { "sampleRate", BUDGET_SAMPLE_RATE }, { "blockSize", BUDGET_BLOCKSIZE }, { "nsPerBlock", BUDGET_NS_PER_BLOCK } };
+    document["results"] = results;
+    
+    std::ofstream file(settings.outputPath);
+    if (!file.is_open())
+    {
+        rt_printf("could not create %s\n", settings.outputPath.c_str());
+        return 1;
+    }
+    file << document.dump(4) << std::endl;
+    
+    rt_printf("\nwrote %zu results to %s\n", results.size(), settings.outputPath.c_str());
+    
+    if (!settings.comparePath.empty()) compareResults(settings.comparePath);
+    
+    return 0;
+}
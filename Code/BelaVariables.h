@@ -5,6 +5,7 @@
 #include <libraries/Midi/Midi.h>
 
 #include "Engine.h"
+#include "TaskScheduler.hpp"
 
 //#define SCOPE_ACTIVE
 
@@ -12,10 +13,9 @@
 #include <libraries/Scope/Scope.h>
 #endif
 
+void runControlTasks(void* arg_);
+void readControls();
 void updateLEDs();
-void updateUserInterface(void* arg_);
-void updateAudioBlock(void* arg_);
-void updateNonAudioTasks(void* arg_);
 void midiInputMessageCallback(MidiChannelMessage message, void* arg);
 void midiOutputMessageCallback(uint ccIndex_, uint ccValue_);
 
@@ -24,6 +24,10 @@ namespace BelaVariables
 
 unsigned int sampleIndex = 0;
 
+// non-interleaved audio buffers for the blockwise processing of the engine
+std::vector<float> audioInputBuffer[2];
+std::vector<float> audioOutputBuffer[2];
+
 // hardware pins for potentiometers, buttons and leds
 static const int HARDWARE_PIN_POTENTIOMETER[] = { 6, 5, 4, 3, 7, 0, 1, 2 };
 static const int HARDWARE_PIN_BUTTON[] = { 2, 4, 0, 5, 3, 1, 15, 13, 14, 12 };
@@ -35,20 +39,21 @@ static const unsigned int DISPLAY_FRAMERATE = 12;
 static const unsigned int LED_FRAMERATE = 200;
 static const unsigned int UI_FRAMERATE = 120;
 static const unsigned int SCROLLING_FRAMERATE = 30;
+static const unsigned int MIDI_FRAMERATE = 200;
 
-// the variables for blocks per frame and corresponding counters manage when an update function is gonna be called
-unsigned int DISPLAY_BLOCKS_PER_FRAME;
-int displayBlockCtr;
-
-unsigned int LED_BLOCKS_PER_FRAME;
-int ledBlockCtr;
-std::array<float, NUM_LEDS> ledCache;
+// the control thread is woken up at most this often, a task runs at most one wakeup period after it is due
+// twice the fastest framerate, so a late wakeup delays the fastest tasks, but doesn't make them miss a frame
+static const unsigned int CONTROL_WAKEUP_RATE = 400;
 
-unsigned int UI_BLOCKS_PER_FRAME;
-int uiBlockCtr;
+// runs the control tasks at their framerates on one auxiliary task
+TaskScheduler scheduler;
+unsigned int TASK_readControls;
 
-unsigned int SCROLLING_BLOCKS_PER_FRAME;
-int scrollingBlockCtr;
+// the hardware is read and written on the audio thread only,
+// the control thread reads the inputs and writes the leds through these caches
+std::array<std::atomic<int>, NUM_BUTTONS> buttonCache;
+std::array<std::atomic<float>, NUM_POTENTIOMETERS> potentiometerCache;
+std::array<std::atomic<float>, NUM_LEDS> ledCache;
 
 #ifdef SCOPE_ACTIVE
 Scope scope;
@@ -63,9 +68,7 @@ AudioEngine engine;
 UserInterface userinterface;
 
 // threads
-AuxiliaryTask THREAD_updateUserInterface;
-AuxiliaryTask THREAD_updateNonAudioTasks;
-AuxiliaryTask THREAD_updateAudioBlock;
+AuxiliaryTask THREAD_runControlTasks;
 
 }; // namespace BelaVariables
 
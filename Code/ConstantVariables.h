@@ -1,6 +1,9 @@
 #pragma once
 
+// the offline renderer (see Offline/) builds the engine without the BELA libraries
+#ifndef GRAINMOTHER_OFFLINE
 #define BELA_CONNECTED
+#endif
 
 #include <iostream>
 #include <vector>
@@ -16,7 +19,7 @@
 #include <mutex>
 #include <numeric>
 #include <cstring>
-#include <arm_neon.h>
+#include "Simd.h"
 #include <random>
 
 #ifdef BELA_CONNECTED
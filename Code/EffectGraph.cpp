@@ -0,0 +1,258 @@
+#include "EffectGraph.hpp"
+
+// =======================================================================================
+// MARK: - EFFECT GRAPH
+// =======================================================================================
+
+const int EffectGraph::GRAPH_INPUT = -1;
+const int EffectGraph::GRAPH_OUTPUT = -2;
+
+int EffectGraph::addSlot(EffectProcessor* effect_, const EffectOrder type_)
+{
+    for (const Slot& slot : slots)
+    {
+        if (slot.effect == effect_)
+            engine_rt_error("an effect processor can only be placed in one slot of a graph", __FILE__, __LINE__, true);
+    }
+    
+    slots.push_back({ effect_, Telemetry::getEffectProbe(ENUM2INT(type_)) });
+    compiled = false;
+    
+    return (int)slots.size() - 1;
+}
+
+
+void EffectGraph::connect(const int source_, const int destination_, const float gain_)
+{
+    const int numSlots = (int)slots.size();
+    
+    if (source_ != GRAPH_INPUT && (source_ < 0 || source_ >= numSlots))
+        engine_rt_error("invalid source of a connection: " + TOSTRING(source_), __FILE__, __LINE__, true);
+    
+    if (destination_ != GRAPH_OUTPUT && (destination_ < 0 || destination_ >= numSlots))
+        engine_rt_error("invalid destination of a connection: " + TOSTRING(destination_), __FILE__, __LINE__, true);
+    
+    connections.push_back({ source_, destination_, gain_ });
+    compiled = false;
+}
+
+
+bool EffectGraph::compile(const uint blockSize_)
+{
+    compiled = false;
+    schedule.clear();
+    inputs.clear();
+    
+    const uint numSlots = (uint)slots.size();
+    
+    // find the slots that can be reached from the input and the slots that reach the output
+    std::vector<bool> fromInput(numSlots, false), toOutput(numSlots, false);
+    
+    for (bool changed = true; changed; )
+    {
+        changed = false;
+        
+        for (const Connection& connection : connections)
+        {
+            if (connection.destination >= 0 && !fromInput[connection.destination]
+                && (connection.source == GRAPH_INPUT || (connection.source >= 0 && fromInput[connection.source])))
+            {
+                fromInput[connection.destination] = changed = true;
+            }
+            
+            if (connection.source >= 0 && !toOutput[connection.source]
+                && (connection.destination == GRAPH_OUTPUT || (connection.destination >= 0 && toOutput[connection.destination])))
+            {
+                toOutput[connection.source] = changed = true;
+            }
+        }
+    }
+    
+    // only the slots on a path from the input to the output are processed
+    std::vector<bool> isProcessed(numSlots);
+    for (uint n = 0; n < numSlots; ++n) isProcessed[n] = fromInput[n] && toOutput[n];
+    
+    auto isProcessedConnection = [&](const Connection& connection_)
+    {
+        return (connection_.source == GRAPH_INPUT || isProcessed[connection_.source])
+            && (connection_.destination == GRAPH_OUTPUT || isProcessed[connection_.destination]);
+    };
+    
+    // number of incoming connections of every slot and of the output
+    std::vector<uint> numIncoming(numSlots, 0);
+    uint numOutputIncoming = 0;
+    
+    for (const Connection& connection : connections)
+    {
+        if (!isProcessedConnection(connection)) continue;
+        
+        if (connection.destination == GRAPH_OUTPUT) ++numOutputIncoming;
+        else ++numIncoming[connection.destination];
+    }
+    
+    // topological sort, slots that are ready at the same time are scheduled in the order they were added
+    std::vector<uint> numPending(numIncoming);
+    std::vector<int> bufferIndex(numSlots, -1);
+    std::vector<uint> order;
+    
+    for (uint n = 0; n < numSlots; ++n)
+    {
+        if (!isProcessed[n]) continue;
+        
+        for (const Connection& connection : connections)
+        {
+            if (connection.source == GRAPH_INPUT && connection.destination == (int)n) --numPending[n];
+        }
+    }
+    
+    for (bool scheduled = true; scheduled; )
+    {
+        scheduled = false;
+        
+        for (uint n = 0; n < numSlots; ++n)
+        {
+            if (!isProcessed[n] || bufferIndex[n] >= 0 || numPending[n] > 0) continue;
+            
+            bufferIndex[n] = (int)order.size();
+            order.push_back(n);
+            scheduled = true;
+            
+            for (const Connection& connection : connections)
+            {
+                if (connection.source == (int)n && connection.destination >= 0 && isProcessed[connection.destination])
+                    --numPending[connection.destination];
+            }
+            
+            break;
+        }
+    }
+    
+    uint numProcessed = 0;
+    for (uint n = 0; n < numSlots; ++n) numProcessed += isProcessed[n];
+    
+    if (order.size() < numProcessed)
+    {
+        engine_rt_error("the effect graph has a cycle", __FILE__, __LINE__, false);
+        return false;
+    }
+    
+    // the inputs of every step, in the order the connections were made
+    auto addInputs = [&](const int destination_)
+    {
+        uint numInputs = 0;
+        
+        for (const Connection& connection : connections)
+        {
+            if (connection.destination != destination_ || !isProcessedConnection(connection)) continue;
+            
+            inputs.push_back({ (connection.source == GRAPH_INPUT) ? GRAPH_INPUT : bufferIndex[connection.source], connection.gain });
+            ++numInputs;
+        }
+        
+        return numInputs;
+    };
+    
+    for (uint n : order)
+    {
+        Step step;
+        step.effect = slots[n].effect;
+        step.probe = slots[n].probe;
+        step.buffer = bufferIndex[n];
+        step.firstInput = (uint)inputs.size();
+        step.numInputs = addInputs((int)n);
+        
+        // processed in parallel if the output is summed with other signals
+        step.flow = EffectProcessor::SERIES;
+        
+        for (const Connection& connection : connections)
+        {
+            if (connection.source != (int)n || !isProcessedConnection(connection)) continue;
+            
+            const uint numSummed = (connection.destination == GRAPH_OUTPUT) ? numOutputIncoming : numIncoming[connection.destination];
+            if (numSummed > 1) step.flow = EffectProcessor::PARALLEL;
+        }
+        
+        schedule.push_back(step);
+    }
+    
+    firstOutputInput = (uint)inputs.size();
+    numOutputInputs = addInputs(GRAPH_OUTPUT);
+    
+    // allocate the buffers, the audio thread never resizes them
+    for (uint ch = 0; ch < 2; ++ch)
+    {
+        buffers[ch].assign(schedule.size(), std::vector<float>(blockSize_, 0.f));
+        mixBuffer[ch].assign(blockSize_, 0.f);
+        outputBuffer[ch].assign(blockSize_, 0.f);
+    }
+    
+    compiled = true;
+    return true;
+}
+
+
+bool EffectGraph::processAudioBlock(const float* const input_[2], const float* output_[2], const uint numFrames_, Telemetry::CpuMeter& cpuMeter_)
+{
+    for (const Step& step : schedule)
+    {
+        const float* stepInput[2];
+        float* const stepOutput[2] = { buffers[0][step.buffer].data(), buffers[1][step.buffer].data() };
+        
+        Telemetry::CpuMeter::Measurement measurement(cpuMeter_, step.probe);
+        
+        mixInputs(step.firstInput, step.numInputs, input_, mixBuffer, stepInput, numFrames_);
+        step.effect->processAudioBlock(stepInput, stepOutput, numFrames_);
+    }
+    
+    if (numOutputInputs == 0)
+    {
+        output_[0] = input_[0];
+        output_[1] = input_[1];
+        return false;
+    }
+    
+    mixInputs(firstOutputInput, numOutputInputs, input_, outputBuffer, output_, numFrames_);
+    return true;
+}
+
+
+void EffectGraph::mixInputs(const uint first_, const uint numInputs_, const float* const input_[2], std::vector<float> (&sum_)[2],
+                            const float* output_[2], const uint numFrames_)
+{
+    // a single input without gain is passed on without copying
+    if (numInputs_ == 1 && inputs[first_].gain == 1.f)
+    {
+        for (uint ch = 0; ch < 2; ++ch) output_[ch] = getChannel(inputs[first_].buffer, ch, input_);
+        return;
+    }
+    
+    for (uint ch = 0; ch < 2; ++ch)
+    {
+        float* sum = sum_[ch].data();
+        
+        for (uint n = first_; n < first_ + numInputs_; ++n)
+        {
+            const float* source = getChannel(inputs[n].buffer, ch, input_);
+            const float gain = inputs[n].gain;
+            
+            if (n == first_)
+                for (uint k = 0; k < numFrames_; ++k) sum[k] = source[k] * gain;
+            else
+                for (uint k = 0; k < numFrames_; ++k) sum[k] += source[k] * gain;
+        }
+        
+        output_[ch] = sum;
+    }
+}
+
+
+void EffectGraph::updateAudioBlock()
+{
+    for (const Step& step : schedule) step.effect->updateAudioBlock();
+}
+
+
+void EffectGraph::applyExecutionFlow()
+{
+    for (const Step& step : schedule) step.effect->setExecutionFlow(step.flow);
+}
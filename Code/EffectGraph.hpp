@@ -0,0 +1,165 @@
+#ifndef effectgraph_hpp
+#define effectgraph_hpp
+
+#include "Functions.h"
+#include "EffectProcessor.hpp"
+#include "Telemetry.hpp"
+
+/**
+ * @file EffectGraph.hpp
+ * @brief A routing graph of effect slots, compiled into a flat execution schedule.
+ *
+ * Every slot holds one effect processor of any type. Connections lead from the engine input or a slot
+ * to a slot or the engine output and carry a gain, signals that meet at a slot or the output are summed.
+ * `compile()` drops the slots that don't lie on a path from the input to the output, sorts the remaining
+ * ones topologically and allocates a stereo block buffer for each of them. Processing a block then just
+ * walks the schedule, it doesn't allocate and doesn't branch on the routing.
+ */
+
+// =======================================================================================
+// MARK: - EFFECT GRAPH
+// =======================================================================================
+
+/**
+ * @class EffectGraph
+ * @brief A directed acyclic graph of effect slots between the engine input and output.
+ *
+ * Build and compile the graph on a control thread, `processAudioBlock()` and `updateAudioBlock()` are the only
+ * functions that may be called once the graph is in use. An effect processor can be placed in one slot only, since
+ * it holds the state of its effect.
+ *
+ * A slot is processed in parallel (see `EffectProcessor::ExecutionFlow`) if its output is summed with other
+ * signals at one of its destinations, otherwise in series.
+ */
+class EffectGraph
+{
+public:
+    static const int GRAPH_INPUT; ///< the engine input, can only be a source
+    static const int GRAPH_OUTPUT; ///< the engine output, can only be a destination
+    
+    /**
+     * @brief Adds a slot.
+     * @param effect_ the effect processor of the slot, must not be used by another slot
+     * @param type_ the type of the effect, selects the probe of the CPU meter, slots of the same type share it
+     * @return the index of the slot, which is used to connect it
+     */
+    int addSlot(EffectProcessor* effect_, const EffectOrder type_);
+    
+    /**
+     * @brief Connects a source to a destination.
+     * @param source_ a slot index or GRAPH_INPUT
+     * @param destination_ a slot index or GRAPH_OUTPUT
+     * @param gain_ the gain of the connection
+     */
+    void connect(const int source_, const int destination_, const float gain_ = 1.f);
+    
+    /**
+     * @brief Compiles the graph into the execution schedule and allocates the buffers.
+     * @param blockSize_ the maximum number of frames per processed block
+     * @return false if the graph has a cycle, the graph can't be used then
+     */
+    bool compile(const uint blockSize_);
+    
+    /**
+     * @brief Processes a block through the schedule.
+     *
+     * @param input_ Pointers to the left and right input channel.
+     * @param output_ Receives the pointers to the left and right output of the graph, which stay valid until the next call.
+     * Points to the input if no slot is connected to the output.
+     * @param numFrames_ The number of samples per channel, at most the block size given to `compile()`.
+     * @param cpuMeter_ The CPU meter, which times every slot.
+     * @return false if no slot is connected to the output
+     */
+    bool processAudioBlock(const float* const input_[2], const float* output_[2], const uint numFrames_, Telemetry::CpuMeter& cpuMeter_);
+    
+    /** @brief Calls the blockwise update of the effect of every scheduled slot. */
+    void updateAudioBlock();
+    
+    /** @brief Tells the effect of every scheduled slot whether it is processed in series or in parallel. */
+    void applyExecutionFlow();
+    
+    bool isCompiled() const { return compiled; }
+    
+    /** @brief Returns the number of slots in the schedule, which are the slots that are processed. */
+    uint getNumScheduledSlots() const { return (uint)schedule.size(); }
+
+private:
+    /**
+     * @struct Connection
+     * @brief A source, its gain and its destination.
+     */
+    struct Connection
+    {
+        int source;
+        int destination;
+        float gain;
+    };
+    
+    /**
+     * @struct Slot
+     * @brief An effect processor and the probe it is timed with.
+     */
+    struct Slot
+    {
+        EffectProcessor* effect;
+        Telemetry::Probe probe;
+    };
+    
+    /**
+     * @struct Step
+     * @brief A slot in the schedule, its inputs are `inputs[firstInput]` to `inputs[firstInput + numInputs - 1]`.
+     */
+    struct Step
+    {
+        EffectProcessor* effect;
+        Telemetry::Probe probe;
+        EffectProcessor::ExecutionFlow flow;
+        uint firstInput;
+        uint numInputs;
+        uint buffer;
+    };
+    
+    /**
+     * @struct Input
+     * @brief A buffer that is summed into the input of a step or the output, GRAPH_INPUT is the engine input.
+     */
+    struct Input
+    {
+        int buffer;
+        float gain;
+    };
+    
+    /** @brief Returns the left or right channel of a buffer, GRAPH_INPUT is the engine input. */
+    const float* getChannel(const int buffer_, const uint channel_, const float* const input_[2]) const
+    {
+        return (buffer_ == GRAPH_INPUT) ? input_[channel_] : buffers[channel_][buffer_].data();
+    }
+    
+    /**
+     * @brief Points to a single input without gain, otherwise sums the inputs into the given buffer.
+     * @param first_ the first input
+     * @param numInputs_ the number of inputs
+     * @param input_ the engine input
+     * @param sum_ the buffer the inputs are summed in
+     * @param output_ receives the pointers to the left and right channel
+     * @param numFrames_ the number of samples per channel
+     */
+    void mixInputs(const uint first_, const uint numInputs_, const float* const input_[2], std::vector<float> (&sum_)[2],
+                   const float* output_[2], const uint numFrames_);
+    
+    std::vector<Slot> slots;
+    std::vector<Connection> connections;
+    
+    std::vector<Step> schedule;  ///< the scheduled slots, topologically sorted
+    std::vector<Input> inputs;  ///< the inputs of all steps, followed by the inputs of the output
+    uint firstOutputInput = 0;
+    uint numOutputInputs = 0;
+    
+    std::vector<std::vector<float>> buffers[2];  ///< [channel][step] the output of every step
+    std::vector<float> mixBuffer[2];  ///< the summed inputs of a step
+    std::vector<float> outputBuffer[2];  ///< the summed inputs of the output
+    
+    bool compiled = false;
+};
+
+#endif /* effectgraph_hpp */
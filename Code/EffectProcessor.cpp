@@ -6,8 +6,10 @@
 
 const uint EffectProcessor::RAMP_BLOCKSIZE = 1;
 const uint EffectProcessor::RAMP_BLOCKSIZE_WRAP = RAMP_BLOCKSIZE - 1;
+const uint EffectProcessor::ENGAGE_CHANGE = UINT16_MAX;
+const uint EffectProcessor::SYNCHRONIZE_CHANGE = UINT16_MAX - 1;
 
-EffectProcessor::EffectProcessor(AudioParameterGroup* engineParameters_,
+EffectProcessor::EffectProcessor(AudioParameterGroup* engineParameters_, ParameterQueue* parameterQueue_,
                 const unsigned int numParameters_, const String& name_,
                 const float sampleRate_, const unsigned int blockSize_)
     : id(name_)
@@ -15,11 +17,21 @@ EffectProcessor::EffectProcessor(AudioParameterGroup* engineParameters_,
     , blockSize(blockSize_)
     , parameters(name_, numParameters_)
     , engineParameters(engineParameters_)
+    , parameterQueue(parameterQueue_)
 {
     wetGain.setup(1.f, sampleRate, RAMP_BLOCKSIZE);
     dryGain = 0.f;
 
     muteGain.setup(1.f, sampleRate, RAMP_BLOCKSIZE);
+    
+    outputSilence.setup(sampleRate);
+    inputSilence.setup(sampleRate);
+    
+    // allocate the block buffers, the audio thread never resizes them
+    muteGainBuffer.resize(blockSize, 1.f);
+    wetGainBuffer.resize(blockSize, 1.f);
+    dryGainBuffer.resize(blockSize, 0.f);
+    for (uint ch = 0; ch < 2; ++ch) effectBuffer[ch].resize(blockSize, 0.f);
 }
 
 
@@ -32,7 +44,30 @@ void EffectProcessor::parameterChanged(AudioParameter *param_)
         engine_rt_error("The Parameter with ID: " + paramID + " is not allowed to change the engagement of an effect.",
                         __FILE__, __LINE__, true);
         
-    engage(param_->getValueAsInt());
+    pushParameterChange(ENGAGE_CHANGE, param_->getValueAsInt());
+}
+
+
+void EffectProcessor::applyParameterChange(const uint index_, const float value_)
+{
+    if (index_ == ENGAGE_CHANGE) engage(value_ != 0.f);
+    
+    else if (index_ == SYNCHRONIZE_CHANGE) synchronize();
+}
+
+
+void EffectProcessor::requestSynchronize()
+{
+    pushParameterChange(SYNCHRONIZE_CHANGE, 0.f);
+}
+
+
+void EffectProcessor::pushParameterChange(const uint index_, const float value_)
+{
+    // without a queue, i.e. outside of an engine, there is no audio thread to hand over to
+    if (!parameterQueue) applyParameterChange(index_, value_);
+    
+    else parameterQueue->push(this, index_, value_);
 }
 
 
@@ -69,12 +104,114 @@ void EffectProcessor::updateRamps()
 }
 
 
+void EffectProcessor::updateRampsBlock(const uint numFrames_)
+{
+    // steady state: constant gains for the whole block
+    if (muteGain.rampFinished && wetGain.rampFinished)
+    {
+        std::fill(muteGainBuffer.begin(), muteGainBuffer.begin() + numFrames_, muteGain());
+        std::fill(wetGainBuffer.begin(), wetGainBuffer.begin() + numFrames_, wetGain());
+        std::fill(dryGainBuffer.begin(), dryGainBuffer.begin() + numFrames_, dryGain);
+        return;
+    }
+    
+    // ramping: step the ramps samplewise, exactly like the samplewise path
+    for (uint n = 0; n < numFrames_; ++n)
+    {
+        updateRamps();
+        
+        muteGainBuffer[n] = muteGain();
+        wetGainBuffer[n] = wetGain();
+        dryGainBuffer[n] = dryGain;
+    }
+}
+
+
+void EffectProcessor::processAudioBlock(const float* const input_[2], float* const output_[2], const uint numFrames_)
+{
+    if (numFrames_ > blockSize)
+        engine_rt_error("Effect Processor with ID '" + id + "' can't process more than " + TOSTRING(blockSize) + " samples per block",
+                        __FILE__, __LINE__, true);
+    
+    updateRampsBlock(numFrames_);
+    
+    // the effect can be skipped if it is muted or fully dry and, in case it has a tail, has faded out
+    if (muteGain.rampFinished && wetGain.rampFinished && (muteGain() <= 0.f || wetGain() <= 0.f))
+    {
+        if (!hasTail || outputSilence.isSilent())
+        {
+            processBypassBlock(input_, output_, numFrames_);
+            return;
+        }
+    }
+    
+    // an idle effect sleeps: processing it would only produce silence
+    if (canSleep)
+    {
+        inputSilence.processAudioBlock(input_, numFrames_);
+        
+        if (inputSilence.isSilent() && (!hasTail || outputSilence.isSilent()))
+        {
+            processBypassBlock(input_, output_, numFrames_);
+            return;
+        }
+    }
+    
+    float* const effect[2] = { effectBuffer[0].data(), effectBuffer[1].data() };
+    
+    if (isProcessedIn == PARALLEL)
+    {
+        // input = input * muteGain * wetGain
+        for (uint ch = 0; ch < 2; ++ch)
+            for (uint n = 0; n < numFrames_; ++n)
+                effect[ch][n] = input_[ch][n] * muteGainBuffer[n] * wetGainBuffer[n];
+        
+        // output = process(input)
+        processEffectBlock(effect, output_, numFrames_);
+        
+        // silence detector
+        if (hasTail) outputSilence.processAudioBlock(output_, numFrames_);
+    }
+    else // if (isProcessedIN == SERIES)
+    {
+        // input = input * muteGain
+        for (uint ch = 0; ch < 2; ++ch)
+            for (uint n = 0; n < numFrames_; ++n)
+                effect[ch][n] = input_[ch][n] * muteGainBuffer[n];
+        
+        // output = process(input) * wetgain + input_ * dryGain;
+        processEffectBlock(effect, effect, numFrames_);
+        
+        if (hasTail) outputSilence.processAudioBlock(effect, numFrames_);
+        
+        for (uint ch = 0; ch < 2; ++ch)
+            for (uint n = 0; n < numFrames_; ++n)
+                output_[ch][n] = effect[ch][n] * wetGainBuffer[n] + input_[ch][n] * dryGainBuffer[n];
+    }
+}
+
+
+void EffectProcessor::processBypassBlock(const float* const input_[2], float* const output_[2], const uint numFrames_)
+{
+    for (uint ch = 0; ch < 2; ++ch)
+    {
+        if (isProcessedIn == PARALLEL)
+            std::fill(output_[ch], output_[ch] + numFrames_, 0.f);
+        else
+            for (uint n = 0; n < numFrames_; ++n) output_[ch][n] = input_[ch][n] * dryGainBuffer[n];
+    }
+}
+
+
 // =======================================================================================
 // MARK: - REVERB
 // =======================================================================================
 
 void ReverbProcessor::setup()
 {
+    // once its input and its tail are silent, the reverb has nothing left to do
+    canSleep = true;
+    
     reverb.setup(sampleRate, blockSize);
     
     initializeParameters();
@@ -90,7 +227,7 @@ float32x2_t ReverbProcessor::processAudioSamples(const float32x2_t input_, const
     if (isProcessedIn == PARALLEL)
     {
         if (muteGain() <= 0.f || wetGain() <= 0.f)
-            if (averager.isNearZero())
+            if (outputSilence.isSilent())
                 return vdup_n_f32(0.f);
         
         // input = input * muteGain * wetGain
@@ -100,15 +237,15 @@ float32x2_t ReverbProcessor::processAudioSamples(const float32x2_t input_, const
         // output = process(input)
         float32x2_t output = reverb.processAudioSamples(input, sampleIndex_);
         
-        // averager
-        averager.processAudioSamples(output);
+        // silence detector
+        outputSilence.processAudioSamples(output);
         
         return output;
     }
     else // if (isProcessedIN == SERIES)
     {
         if (muteGain() <= 0.f || wetGain() <= 0.f)
-            if (averager.isNearZero())
+            if (outputSilence.isSilent())
                 return vmul_n_f32(input_, dryGain);
         
         // input = input * muteGain
@@ -117,7 +254,7 @@ float32x2_t ReverbProcessor::processAudioSamples(const float32x2_t input_, const
         // output = process(input) * wetgain + input_ * dryGain;
         float32x2_t output = reverb.processAudioSamples(input, sampleIndex_);
         
-        averager.processAudioSamples(output);
+        outputSilence.processAudioSamples(output);
         
         output = vmul_n_f32(output, wetGain());
         return vmla_n_f32(output, input_, dryGain);
@@ -125,6 +262,12 @@ float32x2_t ReverbProcessor::processAudioSamples(const float32x2_t input_, const
 }
 
 
+void ReverbProcessor::processEffectBlock(const float* const input_[2], float* const output_[2], const uint numFrames_)
+{
+    reverb.processAudioBlock(input_, output_, numFrames_);
+}
+
+
 void ReverbProcessor::initializeParameters()
 {
     using namespace Reverberation;
@@ -172,35 +315,38 @@ void ReverbProcessor::initializeParameters()
 
 void ReverbProcessor::initializeListeners()
 {
-    for (unsigned int n = 0; n < Reverberation::NUM_PARAMETERS; ++n)
+    using namespace Reverberation;
+    
+    for (unsigned int n = 0; n < NUM_PARAMETERS; ++n)
     {
+        // the change is queued with the parameter index, the audio thread dispatches it without comparing strings
         auto param = parameters.getParameter(n);
         
-        if (param->getID() != "reverb_mix")
+        if (n != ENUM2INT(Parameters::MIX))
         {
-            param->onChange.push_back([this, param] {
-                reverb.parameterChanged(param->getID(), param->getValueAsFloat());
+            param->onChange.push_back([this, n, param] {
+                pushParameterChange(n, param->getValueAsFloat());
             });
         }
     }
     
-    parameters.getParameter("reverb_mix")->addListener(this);
+    parameters.getParameter(ENUM2INT(Parameters::MIX))->addListener(this);
 }
 
 
 void ReverbProcessor::parameterChanged(AudioParameter *param_)
 {
-    if (param_->getID() == "effect3_engaged")
+    if (param_ == engineParameters->getParameter(Engine::EFFECT3_ENGAGED))
     {
-        engage(param_->getValueAsInt());
+        pushParameterChange(ENGAGE_CHANGE, param_->getValueAsInt());
     }
     
-    else if (param_->getID() == "reverb_mix")
+    else if (param_ == parameters.getParameter(ENUM2INT(Reverberation::Parameters::MIX)))
     {
         float raw = param_->getValueAsFloat() * 0.01f;
         float wet = sinf_neon(raw * PIo2);
         
-        setMix(wet);
+        pushParameterChange(ENUM2INT(Reverberation::Parameters::MIX), wet);
     }
     
     else
@@ -211,6 +357,20 @@ void ReverbProcessor::parameterChanged(AudioParameter *param_)
 }
 
 
+void ReverbProcessor::applyParameterChange(const uint index_, const float value_)
+{
+    using namespace Reverberation;
+    
+    if (index_ == ENGAGE_CHANGE) engage(value_ != 0.f);
+    
+    else if (index_ == SYNCHRONIZE_CHANGE) synchronize();
+    
+    else if (index_ == ENUM2INT(Parameters::MIX)) setMix(value_);
+    
+    else reverb.parameterChanged(static_cast<Parameters>(index_), value_);
+}
+
+
 // =======================================================================================
 // MARK: - GRANULATOR
 // =======================================================================================
@@ -233,7 +393,7 @@ float32x2_t GranulatorProcessor::processAudioSamples(const float32x2_t input_, c
     if (isProcessedIn == PARALLEL)
     {
         if (muteGain() <= 0.f || wetGain() <= 0.f)
-            if (averager.isNearZero())
+            if (outputSilence.isSilent())
                 return vdup_n_f32(0.f);
         
         // input = input * muteGain * wetGain
@@ -243,15 +403,15 @@ float32x2_t GranulatorProcessor::processAudioSamples(const float32x2_t input_, c
         // output = process(input)
         float32x2_t output = granulator.processAudioSamples(input, sampleIndex_);
         
-        // averager
-        averager.processAudioSamples(output);
+        // silence detector
+        outputSilence.processAudioSamples(output);
         
         return output;
     }
     else // if (isProcessedIN == SERIES)
     {
         if (muteGain() <= 0.f || wetGain() <= 0.f)
-            if (averager.isNearZero())
+            if (outputSilence.isSilent())
                 return vmul_n_f32(input_, dryGain);
         
         // input = input * muteGain
@@ -260,16 +420,16 @@ float32x2_t GranulatorProcessor::processAudioSamples(const float32x2_t input_, c
         // output = process(input) * wetgain + input_ * dryGain;
         float32x2_t output = granulator.processAudioSamples(input, sampleIndex_);
         
-        averager.processAudioSamples(output);
+        outputSilence.processAudioSamples(output);
         
         output = vmul_n_f32(output, wetGain());
         return vmla_n_f32(output, input_, dryGain);
     }
 }
 
-void GranulatorProcessor::updateAudioBlock()
+void GranulatorProcessor::processEffectBlock(const float* const input_[2], float* const output_[2], const uint numFrames_)
 {
-    granulator.update();
+    granulator.processAudioBlock(input_, output_, numFrames_);
 }
 
 
@@ -279,6 +439,12 @@ void GranulatorProcessor::synchronize()
 }
 
 
+void GranulatorProcessor::setRandomSeed(const uint32_t seed_)
+{
+    granulator.setRandomSeed(seed_);
+}
+
+
 void GranulatorProcessor::initializeParameters()
 {
     using namespace Granulation;
@@ -341,35 +507,38 @@ void GranulatorProcessor::initializeParameters()
 
 void GranulatorProcessor::initializeListeners()
 {
-    for (unsigned int n = 0; n < Granulation::NUM_PARAMETERS; ++n)
+    using namespace Granulation;
+    
+    for (unsigned int n = 0; n < NUM_PARAMETERS; ++n)
     {
+        // the change is queued with the parameter index, the audio thread dispatches it without comparing strings
         auto param = parameters.getParameter(n);
         
-        if (param->getID() != "granulator_mix")
+        if (n != ENUM2INT(Parameters::MIX))
         {
-            param->onChange.push_back([this, param] {
-                granulator.parameterChanged(param->getID(), param->getValueAsFloat());
+            param->onChange.push_back([this, n, param] {
+                pushParameterChange(n, param->getValueAsFloat());
             });
         }
     }
     
-    parameters.getParameter("granulator_mix")->addListener(this);
+    parameters.getParameter(ENUM2INT(Parameters::MIX))->addListener(this);
 }
 
 
 void GranulatorProcessor::parameterChanged(AudioParameter *param_)
 {
-    if (param_->getID() == "effect2_engaged")
+    if (param_ == engineParameters->getParameter(Engine::EFFECT2_ENGAGED))
     {
-        engage(param_->getValueAsInt());
+        pushParameterChange(ENGAGE_CHANGE, param_->getValueAsInt());
     }
     
-    else if (param_->getID() == "granulator_mix")
+    else if (param_ == parameters.getParameter(ENUM2INT(Granulation::Parameters::MIX)))
     {
         float raw = param_->getValueAsFloat() * 0.01f;
         float wet = sinf_neon(raw * PIo2);
         
-        setMix(wet);
+        pushParameterChange(ENUM2INT(Granulation::Parameters::MIX), wet);
     }
     
     else
@@ -380,12 +549,31 @@ void GranulatorProcessor::parameterChanged(AudioParameter *param_)
 }
 
 
+void GranulatorProcessor::applyParameterChange(const uint index_, const float value_)
+{
+    using namespace Granulation;
+    
+    if (index_ == ENGAGE_CHANGE) engage(value_ != 0.f);
+    
+    else if (index_ == SYNCHRONIZE_CHANGE) synchronize();
+    
+    else if (index_ == ENUM2INT(Parameters::MIX)) setMix(value_);
+    
+    else granulator.parameterChanged(static_cast<Parameters>(index_), value_);
+}
+
+
 // =======================================================================================
 // MARK: - RINGMODULATOR
 // =======================================================================================
 
 void RingModulatorProcessor::setup()
 {
+    // since this effect doesnt have any feedbacks or delays, it can be skipped right away when muted
+    hasTail = false;
+    // the carrier is multiplied with the input, a silent input can't produce any output
+    canSleep = true;
+    
     ringModulator.setup(sampleRate, blockSize);
     
     initializeParameters();
@@ -428,6 +616,12 @@ float32x2_t RingModulatorProcessor::processAudioSamples(const float32x2_t input_
 }
 
 
+void RingModulatorProcessor::processEffectBlock(const float* const input_[2], float* const output_[2], const uint numFrames_)
+{
+    ringModulator.processAudioBlock(input_, output_, numFrames_);
+}
+
+
 void RingModulatorProcessor::updateAudioBlock()
 {
     ringModulator.updateAudioBlock();
@@ -440,6 +634,12 @@ void RingModulatorProcessor::synchronize()
 }
 
 
+void RingModulatorProcessor::setRandomSeed(const uint32_t seed_)
+{
+    ringModulator.setRandomSeed(seed_);
+}
+
+
 void RingModulatorProcessor::initializeParameters()
 {
     using namespace RingModulation;
@@ -461,6 +661,15 @@ void RingModulatorProcessor::initializeParameters()
                                              parameterName[NUM_POTENTIOMETERS],
                                              waveformNames, NUM_WAVEFORMS);
     
+    // parameter controlled by menu (index 9), starts at the initial ratio instead of the first choice
+    uint n = ENUM2INT(Parameters::OVERSAMPLING);
+    parameters.addParameter<ChoiceParameter>(n, parameterID[n], parameterName[n], oversamplingNames, NUM_RATE_CONVERSION_RATIOS);
+    parameters.getParameter(n)->setValue((int)parameterInitialValue[n], false);
+    
+    // parameter controlled by menu (index 10)
+    n = ENUM2INT(Parameters::RESAMPLER);
+    parameters.addParameter<ChoiceParameter>(n, parameterID[n], parameterName[n], resamplerNames, NUM_RESAMPLERS);
+    
     // special cases: scaling
     static_cast<SlideParameter*>(parameters.getParameter("ringmod_tune"))->setScaling(SlideParameter::Scaling::FREQ);
     static_cast<SlideParameter*>(parameters.getParameter("ringmod_rate"))->setScaling(SlideParameter::Scaling::FREQ);
@@ -473,35 +682,38 @@ void RingModulatorProcessor::initializeParameters()
 
 void RingModulatorProcessor::initializeListeners()
 {
-    for (unsigned int n = 0; n < RingModulation::NUM_PARAMETERS; ++n)
+    using namespace RingModulation;
+    
+    for (unsigned int n = 0; n < NUM_PARAMETERS; ++n)
     {
+        // the change is queued with the parameter index, the audio thread dispatches it without comparing strings
         auto param = parameters.getParameter(n);
         
-        if (param->getID() != "ringmod_mix")
+        if (n != ENUM2INT(Parameters::MIX))
         {
-            param->onChange.push_back([this, param] {
-                ringModulator.parameterChanged(param->getID(), param->getValueAsFloat());
+            param->onChange.push_back([this, n, param] {
+                pushParameterChange(n, param->getValueAsFloat());
             });
         }
     }
     
-    parameters.getParameter("ringmod_mix")->addListener(this);
+    parameters.getParameter(ENUM2INT(Parameters::MIX))->addListener(this);
 }
 
 
 void RingModulatorProcessor::parameterChanged(AudioParameter *param_)
 {
-    if (param_->getID() == "effect1_engaged")
+    if (param_ == engineParameters->getParameter(Engine::EFFECT1_ENGAGED))
     {
-        engage(param_->getValueAsInt());
+        pushParameterChange(ENGAGE_CHANGE, param_->getValueAsInt());
     }
     
-    else if (param_->getID() == "ringmod_mix")
+    else if (param_ == parameters.getParameter(ENUM2INT(RingModulation::Parameters::MIX)))
     {
         float raw = param_->getValueAsFloat() * 0.01f;
         float wet = sinf_neon(raw * PIo2);
         
-        setMix(wet);
+        pushParameterChange(ENUM2INT(RingModulation::Parameters::MIX), wet);
     }
     
     else
@@ -510,3 +722,17 @@ void RingModulatorProcessor::parameterChanged(AudioParameter *param_)
                         __FILE__, __LINE__, false);
     }
 }
+
+
+void RingModulatorProcessor::applyParameterChange(const uint index_, const float value_)
+{
+    using namespace RingModulation;
+    
+    if (index_ == ENGAGE_CHANGE) engage(value_ != 0.f);
+    
+    else if (index_ == SYNCHRONIZE_CHANGE) synchronize();
+    
+    else if (index_ == ENUM2INT(Parameters::MIX)) setMix(value_);
+    
+    else ringModulator.parameterChanged(static_cast<Parameters>(index_), value_);
+}
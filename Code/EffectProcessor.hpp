@@ -3,6 +3,7 @@
 
 #include "Functions.h"
 #include "Parameters.hpp"
+#include "ParameterQueue.hpp"
 #include "Reverberation/Reverberation.h"
 #include "Granulation/Granulation.h"
 #include "RingModulation/RingModulator.h"
@@ -15,9 +16,10 @@
  * @class EffectProcessor
  * @brief A base class representing an audio effect processor, with setup and processing capabilities.
  *
- * This class wraps the actual effect class, handling dry/wet and mute processing and the parameter layout
+ * This class wraps the actual effect class, handling dry/wet and mute processing and the parameter layout.
+ * Parameter changes are pushed into the engines `ParameterQueue` and applied to the effect on the audio thread.
  */
-class EffectProcessor : public AudioParameter::Listener
+class EffectProcessor : public AudioParameter::Listener, public ParameterReceiver
 {
 public:
     /**
@@ -32,12 +34,14 @@ public:
     /**
      * @brief Constructs an Effect with specified engine parameters and name.
      * @param engineParameters_ Pointer to the AudioParameterGroup containing engine parameters.
+     * @param parameterQueue_ The queue that hands parameter changes over to the audio thread,
+     * if nullptr, changes are applied right away.
      * @param numParameters_ the number of parameters for this effect
      * @param name_ The name of the effect processor = ID
      * @param sampleRate_ The sample rate
      * @param blockSize_ The audio block size
      */
-    EffectProcessor(AudioParameterGroup* engineParameters_,
+    EffectProcessor(AudioParameterGroup* engineParameters_, ParameterQueue* parameterQueue_,
            const unsigned int numParameters_, const String& name_,
            const float sampleRate_, const unsigned int blockSize_);
 
@@ -54,6 +58,22 @@ public:
      * @return The processed stereo output sample.
      */
     virtual float32x2_t processAudioSamples(const float32x2_t input_, const uint sampleIndex_) = 0;
+    
+    /**
+     * @brief Processes a block of non-interleaved stereo audio samples.
+     *
+     * Block counterpart of `processAudioSamples()`. Gain ramps are rendered into per-block gain buffers,
+     * the bypass decision and the silence detectors are evaluated once per block and the wrapped effect is called
+     * once with the whole block.
+     *
+     * An effect that is allowed to sleep (`canSleep`) isn't processed while its input and its output have been silent
+     * for the hold time of the silence detectors, it wakes up as soon as the input sounds again.
+     *
+     * @param input_ Pointers to the left and right input channel.
+     * @param output_ Pointers to the left and right output channel, must not alias the input.
+     * @param numFrames_ The number of samples per channel, must not exceed the block size.
+     */
+    virtual void processAudioBlock(const float* const input_[2], float* const output_[2], const uint numFrames_);
 
     /** @brief Updates the audio block for the effect. */
     virtual void updateAudioBlock() {}
@@ -79,15 +99,34 @@ public:
      */
     void setMix(const float mixGain_);
     
-    /** @brief Synchronizes the effect state, typically used to align with external changes. i.e. phase reset */
+    /**
+     * @brief Synchronizes the effect state, typically used to align with external changes. i.e. phase reset
+     * @note Writes into the DSP state, call it on the audio thread only, `requestSynchronize()` from the other threads.
+     */
     virtual void synchronize() {}
     
+    /** @brief Synchronizes the effect at the start of the next audio block, safe to call from any thread. */
+    void requestSynchronize();
+    
+    /**
+     * @brief Restarts the random sequences of the effect, the same seed reproduces the same output.
+     * @param seed_ The seed, see `RandomGenerator::setSeed()`.
+     */
+    virtual void setRandomSeed(const uint32_t /*seed_*/) {}
+    
     /**
      * @brief Callback for when a parameter is changed.
      * @param param_ The parameter that has been changed.
      */
     void parameterChanged(AudioParameter *param_) override;
     
+    /**
+     * @brief Applies a queued parameter change, on the audio thread.
+     * @param index_ The index of the effect parameter, `ENGAGE_CHANGE` or `SYNCHRONIZE_CHANGE`.
+     * @param value_ The new value.
+     */
+    void applyParameterChange(const uint index_, const float value_) override;
+    
     /**
      * @brief Gets the parameter group associated with the effect.
      * @return A pointer to the AudioParameterGroup for the effect.
@@ -115,11 +154,44 @@ public:
     String getId() const { return id; }
 
 protected:
+    /**
+     * @brief Processes a block with the wrapped effect only, no gains applied.
+     * @param input_ Pointers to the left and right input channel.
+     * @param output_ Pointers to the left and right output channel, may alias the input.
+     * @param numFrames_ The number of samples per channel.
+     */
+    virtual void processEffectBlock(const float* const input_[2], float* const output_[2], const uint numFrames_) = 0;
+    
+    /**
+     * @brief Renders the mute, wet and dry gains of the next block into the gain buffers.
+     * @param numFrames_ The number of samples per channel.
+     */
+    void updateRampsBlock(const uint numFrames_);
+    
+    /**
+     * @brief Writes the output of a skipped effect: silence in parallel flow, the dry input in series flow.
+     * @param input_ Pointers to the left and right input channel.
+     * @param output_ Pointers to the left and right output channel.
+     * @param numFrames_ The number of samples per channel.
+     */
+    void processBypassBlock(const float* const input_[2], float* const output_[2], const uint numFrames_);
+    
+    /**
+     * @brief Hands a parameter change over to the audio thread.
+     * @param index_ The index of the effect parameter, `ENGAGE_CHANGE` or `SYNCHRONIZE_CHANGE`.
+     * @param value_ The new value.
+     */
+    void pushParameterChange(const uint index_, const float value_);
+    
+    static const uint ENGAGE_CHANGE; /**< The change index of the engagement, which is an engine parameter. */
+    static const uint SYNCHRONIZE_CHANGE; /**< The change index of a synchronization, which carries no value. */
+    
     String id; /**< The unique identifier of the effect processor. */
     float sampleRate = 44100.f; /**< The sample rate for audio processing. */
     unsigned int blockSize = 128; /**< The block size for audio processing. */
     AudioParameterGroup parameters; /**< The group of parameters specific to this effect. */
     AudioParameterGroup* engineParameters = nullptr; /**< Pointer to engine-wide parameters. */
+    ParameterQueue* parameterQueue = nullptr; /**< Pointer to the queue of parameter changes of the engine. */
     
     ExecutionFlow isProcessedIn = PARALLEL; /**< Specifies the execution flow (parallel or series). */
     
@@ -127,7 +199,15 @@ protected:
     LinearRamp wetGain; /**< Linear ramp for the wet (processed) signal gain. */
     LinearRamp muteGain; /**< Linear ramp for muting transitions. */
     
-    EffectAverager averager; /**< a small helper class to determine whether the effect can be bypassed or not */
+    SilenceDetector outputSilence; /**< detects a silent effect output, to determine whether the effect can be bypassed or not */
+    SilenceDetector inputSilence; /**< detects a silent effect input, to determine whether the effect can sleep or not */
+    bool hasTail = true; /**< whether the effect keeps sounding after its input is muted, i.e. delays or feedbacks */
+    bool canSleep = false; /**< whether silent input and output mean the effect has nothing left to do, i.e. no internal sound sources */
+    
+    std::vector<float> muteGainBuffer; /**< mute gain for every sample of the current block */
+    std::vector<float> wetGainBuffer; /**< wet gain for every sample of the current block */
+    std::vector<float> dryGainBuffer; /**< dry gain for every sample of the current block */
+    std::vector<float> effectBuffer[2]; /**< scratch buffer the wrapped effect is processed in */
     
     static const uint RAMP_BLOCKSIZE; /**< Block size used for ramp transitions. */
     static const uint RAMP_BLOCKSIZE_WRAP; /**< Wrapped block size for ramp transitions. */
@@ -150,6 +230,11 @@ public:
         
     void parameterChanged(AudioParameter *param_) override;
     
+    void applyParameterChange(const uint index_, const float value_) override;
+    
+protected:
+    void processEffectBlock(const float* const input_[2], float* const output_[2], const uint numFrames_) override;
+    
 private:
     void initializeParameters();
     void initializeListeners();
@@ -173,12 +258,17 @@ public:
     
     float32x2_t processAudioSamples(const float32x2_t input_, const uint sampleIndex_) override;
     
-    void updateAudioBlock() override;
-    
     void synchronize() override;
     
+    void setRandomSeed(const uint32_t seed_) override;
+    
     void parameterChanged(AudioParameter *param_) override;
     
+    void applyParameterChange(const uint index_, const float value_) override;
+    
+protected:
+    void processEffectBlock(const float* const input_[2], float* const output_[2], const uint numFrames_) override;
+    
 private:
     void initializeParameters();
     void initializeListeners();
@@ -206,8 +296,18 @@ public:
     
     void synchronize() override;
     
+    void setRandomSeed(const uint32_t seed_) override;
+    
     void parameterChanged(AudioParameter *param_) override;
+    
+    void applyParameterChange(const uint index_, const float value_) override;
+    
+    /** @brief Direct access to the ring modulator, e.g. to set the oversampling ratio without the parameter queue. */
+    RingModulation::RingModulator& getRingModulator() { return ringModulator; }
 
+protected:
+    void processEffectBlock(const float* const input_[2], float* const output_[2], const uint numFrames_) override;
+    
 private:
     void initializeParameters();
     void initializeListeners();
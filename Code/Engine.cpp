@@ -9,6 +9,7 @@
 
 const uint AudioEngine::RAMP_BLOCKSIZE = 8;
 const uint AudioEngine::RAMP_BLOCKSIZE_WRAP = RAMP_BLOCKSIZE - 1;
+const uint AudioEngine::EFFECT_GRAPH_CHANGE = UINT16_MAX;
 
 
 AudioEngine::AudioEngine() : engineParameters("engine", Engine::NUM_PARAMETERS)
@@ -22,31 +23,18 @@ void AudioEngine::setup(const float sampleRate_, const unsigned int blockSize_)
     
     initializeEngineParameters();
     
-    // get the indexi of the predfined effect order
-    uint revEffectIndex = ENUM2INT(EffectOrder::REVERB);
-    uint granEffectIndex = ENUM2INT(EffectOrder::GRANULATOR);
-    uint ringEffectIndex = ENUM2INT(EffectOrder::RINGMODULATOR);
-    
-    // Define the alignment - 16 bytes for SIMD types
-    constexpr std::size_t alignment = 16;
-
-    // Aligned allocation and object construction for effects
-    void* revEffect = nullptr;
-    void* granEffect = nullptr;
-    void* ringEffect = nullptr;
-    
-    if (posix_memalign(&revEffect, alignment, sizeof(ReverbProcessor)) != 0) { throw std::bad_alloc(); }
-    if (posix_memalign(&granEffect, alignment, sizeof(GranulatorProcessor)) != 0) { throw std::bad_alloc(); }
-    if (posix_memalign(&ringEffect, alignment, sizeof(RingModulatorProcessor)) != 0) { throw std::bad_alloc(); }
-    
-    effectProcessor[revEffectIndex] = new (revEffect) ReverbProcessor(&engineParameters, Reverberation::NUM_PARAMETERS, "reverb", sampleRate, blockSize);
-    effectProcessor[granEffectIndex] = new (granEffect) GranulatorProcessor(&engineParameters, Granulation::NUM_PARAMETERS, "granulator", sampleRate, blockSize);
-    effectProcessor[ringEffectIndex] = new (ringEffect) RingModulatorProcessor(&engineParameters, RingModulation::NUM_PARAMETERS, "ringmodulator", sampleRate, blockSize);
+    // the predefined effects, one of every type
+    effectProcessor[ENUM2INT(EffectOrder::REVERB)] = allocateEffect(EffectOrder::REVERB, "reverb");
+    effectProcessor[ENUM2INT(EffectOrder::GRANULATOR)] = allocateEffect(EffectOrder::GRANULATOR, "granulator");
+    effectProcessor[ENUM2INT(EffectOrder::RINGMODULATOR)] = allocateEffect(EffectOrder::RINGMODULATOR, "ringmodulator");
     
     // The setup functions of the effect processors create a set of parameters and initialize the listener connections.
     // They also initialize the actual effect objects.
     for (uint n = 0; n < NUM_EFFECTS; ++n) effectProcessor[n]->setup();
     
+    // every effect draws from its own generators, seeded from the engine's seed
+    setRandomSeed(randomSeed);
+    
     // Add all parameters to a vector of AudioParameterGroups, which holds all program parameters
     programParameters.at(0) = (&engineParameters);
     for (unsigned int n = 1; n < NUM_EFFECTS + 1; ++n)
@@ -56,6 +44,128 @@ void AudioEngine::setup(const float sampleRate_, const unsigned int blockSize_)
     globalWet.setup(1.f, sampleRate, RAMP_BLOCKSIZE);
     globalWetCache = globalWet();
     globalDry = getDryAmount(globalWet());
+    
+    // compile a graph for every effect order, the effect order parameter selects one of them
+    for (uint n = 0; n < NUM_EFFECT_CHAINS; ++n)
+        addEffectGraph(createChainGraph(static_cast<EffectChain>(n)));
+    
+    // a valid graph until the effect order parameter is applied
+    applyEffectOrder(effectChain);
+    
+    // time budget and cycle counter rate of the CPU meter
+    cpuMeter.setup(sampleRate, blockSize);
+    
+    // map the MIDI CC indices, all parameters are created and connected by now
+    updateCCTable();
+}
+
+
+EffectProcessor* AudioEngine::allocateEffect(const EffectOrder type_, const String& name_)
+{
+    // Define the alignment - 16 bytes for SIMD types
+    constexpr std::size_t alignment = 16;
+    
+    // Aligned allocation and object construction
+    void* memory = nullptr;
+    
+    switch (type_)
+    {
+        case EffectOrder::REVERB:
+        {
+            if (posix_memalign(&memory, alignment, sizeof(ReverbProcessor)) != 0) { throw std::bad_alloc(); }
+            return new (memory) ReverbProcessor(&engineParameters, &parameterQueue, Reverberation::NUM_PARAMETERS, name_, sampleRate, blockSize);
+        }
+            
+        case EffectOrder::GRANULATOR:
+        {
+            if (posix_memalign(&memory, alignment, sizeof(GranulatorProcessor)) != 0) { throw std::bad_alloc(); }
+            return new (memory) GranulatorProcessor(&engineParameters, &parameterQueue, Granulation::NUM_PARAMETERS, name_, sampleRate, blockSize);
+        }
+            
+        case EffectOrder::RINGMODULATOR:
+        default:
+        {
+            if (posix_memalign(&memory, alignment, sizeof(RingModulatorProcessor)) != 0) { throw std::bad_alloc(); }
+            return new (memory) RingModulatorProcessor(&engineParameters, &parameterQueue, RingModulation::NUM_PARAMETERS, name_, sampleRate, blockSize);
+        }
+    }
+}
+
+
+EffectProcessor* AudioEngine::createEffect(const EffectOrder type_, const String& name_)
+{
+    EffectProcessor* effect = allocateEffect(type_, name_);
+    effect->setup();
+    effect->setRandomSeed(randomSeed + NUM_EFFECTS + (uint32_t)additionalEffects.size());
+    
+    additionalEffects.push_back(effect);
+    
+    return effect;
+}
+
+
+void AudioEngine::setRandomSeed(const uint32_t seed_)
+{
+    randomSeed = seed_;
+    
+    for (uint n = 0; n < NUM_EFFECTS; ++n) effectProcessor[n]->setRandomSeed(randomSeed + n);
+    
+    for (uint n = 0; n < additionalEffects.size(); ++n)
+        additionalEffects[n]->setRandomSeed(randomSeed + NUM_EFFECTS + n);
+}
+
+
+std::unique_ptr<EffectGraph> AudioEngine::createChainGraph(const EffectChain chain_)
+{
+    std::unique_ptr<EffectGraph> graph(new EffectGraph);
+    
+    const int (&processIndex)[NUM_EFFECTS][NUM_EFFECTS] = effectChainLayouts[ENUM2INT(chain_)];
+    
+    // every effect of a stage is fed by all effects of the previous stage, the first one by the input
+    std::vector<int> previousStage { EffectGraph::GRAPH_INPUT };
+    
+    for (uint m = 0; m < NUM_EFFECTS; ++m)
+    {
+        std::vector<int> stage;
+        
+        for (uint n = 0; n < NUM_EFFECTS; ++n)
+        {
+            if (processIndex[m][n] < 0) continue;
+            
+            const int slot = graph->addSlot(effectProcessor[processIndex[m][n]], static_cast<EffectOrder>(processIndex[m][n]));
+            for (int source : previousStage) graph->connect(source, slot);
+            
+            stage.push_back(slot);
+        }
+        
+        if (!stage.empty()) previousStage = stage;
+    }
+    
+    for (int source : previousStage) graph->connect(source, EffectGraph::GRAPH_OUTPUT);
+    
+    return graph;
+}
+
+
+int AudioEngine::addEffectGraph(std::unique_ptr<EffectGraph> graph_)
+{
+    if (numEffectGraphs == MAX_EFFECT_GRAPHS)
+    {
+        engine_rt_error("AudioEngine can't hold more than " + TOSTRING(MAX_EFFECT_GRAPHS) + " effect graphs", __FILE__, __LINE__, false);
+        return -1;
+    }
+    
+    if (!graph_->isCompiled() && !graph_->compile(blockSize)) return -1;
+    
+    effectGraphs[numEffectGraphs] = std::move(graph_);
+    
+    return (int)numEffectGraphs++;
+}
+
+
+void AudioEngine::setEffectGraph(const uint index_)
+{
+    parameterQueue.push(this, EFFECT_GRAPH_CHANGE, index_);
 }
 
 
@@ -92,14 +202,7 @@ void AudioEngine::initializeEngineParameters()
     // effect order
     engineParameters.addParameter<ChoiceParameter>
     (MENUPARAMETER, parameterID[EFFECT_ORDER], parameterName[EFFECT_ORDER],
-     std::initializer_list<String>{
-        "1 - 2 - 3",
-        "1 | 2 | 3",
-        "3 - 2 - 1",
-        "3 - 1 - 2",
-        "2 - 3 - 1",
-        "2 - 1 - 3",
-        "1 - 3 - 2"});
+     effectChainNames, NUM_EFFECT_CHAINS);
     
     // set tempo to?
     engineParameters.addParameter<ChoiceParameter>
@@ -119,47 +222,29 @@ void AudioEngine::initializeEngineParameters()
 
 float32x2_t AudioEngine::processAudioSamples(float32x2_t input_, uint sampleIndex_)
 {
+    // apply the parameter changes of the control threads once per block
+    if (sampleIndex_ == 0) parameterQueue.applyChanges();
+    
     // process ramps in a certain rate
     if ((sampleIndex_ & RAMP_BLOCKSIZE_WRAP) == 0) updateRamps();
     
     // don't process anything if the bypassed flag is set true
     if (bypassed) return input_;
     
-    float32x2_t input = input_;
-    float32x2_t output = vdup_n_f32(0.f);
+    const int (&processIndex)[NUM_EFFECTS][NUM_EFFECTS] = effectChainLayouts[ENUM2INT(effectChain)];
     
-    // Counter to keep track of how many effects have been processed.
-    uint processedEffects = 0;
+    float32x2_t input = input_;
+    float32x2_t output = input_;
     
-    // Iterate through all effects in series to apply processing functions.
-    for (uint m = 0; m < NUM_EFFECTS; ++m)
+    // the stages in series, the effects of a stage in parallel, their outputs are summed
+    for (uint m = 0; m < NUM_EFFECTS && processIndex[m][0] >= 0; ++m)
     {
-        // Iterate through all effects in parallel to apply processing functions.
-        for (uint n = 0; n < NUM_EFFECTS; ++n)
-        {
-            // Check if there is a valid processing function for the current combination of effects.
-            if (processFunction[m][n])
-            {
-                // Apply the processing function to the input, and accumulate the result into 'output'.
-                output = vadd_f32(output, processFunction[m][n](input, sampleIndex_));
-                
-                // Increment the processed effects counter.
-                // Exit if all effects have been processed.
-                if (++processedEffects == NUM_EFFECTS) break;
-            }
-        }
+        output = vdup_n_f32(0.f);
         
-        // Exit the outer loop if all effects have been processed.
-        if (processedEffects == NUM_EFFECTS) break;
+        for (uint n = 0; n < NUM_EFFECTS && processIndex[m][n] >= 0; ++n)
+            output = vadd_f32(output, effectProcessor[processIndex[m][n]]->processAudioSamples(input, sampleIndex_));
         
-        else
-        {
-            // If not all effects have been processed, set the input to the current output.
-            input = output;
-            
-            // Reset the output for the next iteration of processing.
-            output = vdup_n_f32(0.f);
-        }
+        input = output;
     }
 
     // Return the final output after applying the global wet/dry mix.
@@ -170,141 +255,142 @@ float32x2_t AudioEngine::processAudioSamples(float32x2_t input_, uint sampleInde
 }
 
 
-void AudioEngine::updateAudioBlock()
+void AudioEngine::processAudioBlock(const float* const input_[2], float* const output_[2], const uint numFrames_)
 {
-    // granulator update function
-    effectProcessor[ENUM2INT(EffectOrder::GRANULATOR)]->updateAudioBlock();
+    Telemetry::CpuMeter::Measurement measurement(cpuMeter, Telemetry::ENGINE);
     
-    // ringmodulator update function
-    effectProcessor[ENUM2INT(EffectOrder::RINGMODULATOR)]->updateAudioBlock();
-}
-
-
-void AudioEngine::setEffectOrder()
-{
-    // clear the effect order array and the effect index array
-    for (uint n = 0; n < NUM_EFFECTS; ++n)
-    {
-        for (uint m = 0; m < NUM_EFFECTS; ++m)
-        {
-            processFunction[n][m] = nullptr;
-            
-            // if effect index not set, than this slot is -1
-            processIndex[n][m] = -1;
-        }
-    }
-    
-    // retrieve the current choice of effect order
-    // this is a string like '1 - 2 - 3' for series processing or '1 | 2 | 3' for parallel processing
-    String effectOrder = getParameter("effect_order")->getValueAsString();
-    
-    // Split the effectOrder string into parallel segments
-    std::stringstream stringStream(effectOrder);
-    
-    std::string segment;
+    // apply the parameter changes of the control threads before any audio is processed
+    parameterQueue.applyChanges();
     
-    uint row = 0;
-    
-    // split string into the rows = into every series processing
-    while (std::getline(stringStream, segment, '-'))
+    // blocks larger than the allocated block size are processed in chunks
+    for (uint offset = 0; offset < numFrames_; offset += blockSize)
     {
-        // Split the segment string into parallel segments
-        std::stringstream segmentSegment(segment);
+        const uint numFrames = std::min(blockSize, numFrames_ - offset);
+        const float* const input[2] = { input_[0] + offset, input_[1] + offset };
+        float* const output[2] = { output_[0] + offset, output_[1] + offset };
+        
+        // the graph output points to the input if no effect has been processed
+        const float* chainOutput[2] = { input[0], input[1] };
+        bool chainProcessed = false;
         
-        std::string effectID;
+        EffectGraph* graph = activeGraph.load(std::memory_order_relaxed);
         
-        uint col = 0;
+        if (!bypassed) chainProcessed = graph->processAudioBlock(input, chainOutput, numFrames, cpuMeter);
         
-        // split string into the columns of rows = into every parallel processing
-        while (std::getline(segmentSegment, effectID, '|'))
+        // global wet/dry mix, the ramps are processed in their own rate
+        for (uint start = 0; start < numFrames; start += RAMP_BLOCKSIZE)
         {
-            // trim any whitespace from the extracted effect ID string
-            effectID = trimWhiteSpace(effectID);
+            updateRamps();
+            
+            const uint end = std::min(start + RAMP_BLOCKSIZE, numFrames);
             
-            // effectID shouldnt be empty or any other than a digit
-            if (!effectID.empty() && std::all_of(effectID.begin(), effectID.end(), ::isdigit))
+            for (uint ch = 0; ch < 2; ++ch)
             {
-                // effect index is one less than the effect ID
-                int effectIndex = std::stoi(effectID) - 1;
-                
-                // check if effect Index is in valid range
-                if (effectIndex >= 0 && effectIndex < NUM_EFFECTS)
-                {
-                    
-                    // insert the process function of this effect to the precise array slot
-                    processFunction[row][col] = [this, effectIndex](float32x2_t input, uint sampleIndex) {
-                        return effectProcessor[effectIndex]->processAudioSamples(input, sampleIndex);
-                    };
-                    
-                    // insert the process effect index to the precise array slot
-                    processIndex[row][col] = effectIndex;
-                    
-                    // need to tell the effect how it is getting processed. this affects how the wet variable is used
-                    // in the process function. parallel: wet controls the input gain, series: wet controls dry/wet
-                    // if the column in the process index array is greater than one = processed in parallel and all
-                    // other effects in the same row are processed in parallel too
-                    if (col > 0)
-                    {
-                        effectProcessor[effectIndex]->setExecutionFlow(EffectProcessor::PARALLEL);
-                        
-                        if (col == 1)
-                            effectProcessor[processIndex[row][0]]->setExecutionFlow(EffectProcessor::PARALLEL);
-                        if (col == 2)
-                            effectProcessor[processIndex[row][1]]->setExecutionFlow(EffectProcessor::PARALLEL);
-                    }
-                    
-                    // otherwise: processed in series
-                    else
-                        effectProcessor[effectIndex]->setExecutionFlow(EffectProcessor::SERIES);
-                    
-                    // increment column for the next parallel effect
-                    ++col;
-                }
+                if (bypassed || !chainProcessed)
+                    std::copy(input[ch] + start, input[ch] + end, output[ch] + start);
                 else
-                {
-                    engine_rt_error("Effect index out of range: " + TOSTRING(effectIndex), __FILE__, __LINE__, true);
-                }
-            }
-            else
-            {
-                engine_rt_error("Invalid effect id: " + effectID, __FILE__, __LINE__, true);
+                    for (uint k = start; k < end; ++k)
+                        output[ch][k] = chainOutput[ch][k] * globalWet() + input[ch][k] * globalDry;
             }
         }
-        // increment row for the next series effect(s)
-        ++row;
     }
 }
 
 
-void AudioEngine::setBypass(bool bypassed_)
+void AudioEngine::updateAudioBlock()
 {
-    // If bypass is enabled, ramp down the wet signal to below one
-    // this is needed to set the bypassed flag correctly
-    if (bypassed_)
-    {
-        globalWetCache = globalWet();
-        globalWet.setRampTo(-0.01f, 0.05f);
-    }
-    // If bypass is disabled, ramp up the wet signal to the cache value and set bypassed to false.
-    else
-    {
-        globalWet.setRampTo(globalWetCache, 0.05f);
-        bypassed = false;
-    }
+    // the blockwise update functions of the effects in the current graph
+    EffectGraph* graph = activeGraph.load(std::memory_order_acquire);
     
-    // Update the dry signal to be the cosine inverse of the wet signal.
-    globalDry = getDryAmount(globalWet());
+    if (graph) graph->updateAudioBlock();
+}
+
+
+void AudioEngine::setEffectOrder()
+{
+    // the choice index of the effect order is the effect chain
+    parameterQueue.push(this, Engine::EFFECT_ORDER, getParameter(Engine::EFFECT_ORDER)->getValueAsInt());
+}
+
+
+void AudioEngine::applyEffectOrder(const EffectChain chain_)
+{
+    effectChain = chain_;
+    
+    // the graphs of the effect orders are the first ones
+    applyEffectGraph(ENUM2INT(chain_));
+}
+
+
+void AudioEngine::applyEffectGraph(const uint index_)
+{
+    if (index_ >= MAX_EFFECT_GRAPHS || !effectGraphs[index_]) return;
+    
+    EffectGraph* graph = effectGraphs[index_].get();
+    
+    // need to tell the effect how it is getting processed. this affects how the wet variable is used
+    // in the process function. parallel: wet controls the input gain, series: wet controls dry/wet
+    graph->applyExecutionFlow();
+    
+    activeGraph.store(graph, std::memory_order_release);
+}
+
+
+void AudioEngine::setBypass(bool bypassed_)
+{
+    parameterQueue.push(this, Engine::GLOBAL_BYPASS, bypassed_);
 }
 
 
 void AudioEngine::setGlobalMix()
 {
     // scale linear raw value to sine value
-    float raw = getParameter("global_mix")->getValueAsFloat() * 0.01f;
+    float raw = getParameter(Engine::GLOBAL_MIX)->getValueAsFloat() * 0.01f;
     float wet = sinf_neon(raw * PIo2);
     
-    // set the ramps target to the new value
-    globalWet.setRampTo(wet, 0.01f);
+    parameterQueue.push(this, Engine::GLOBAL_MIX, wet);
+}
+
+
+void AudioEngine::applyParameterChange(const uint index_, const float value_)
+{
+    if (index_ == Engine::GLOBAL_BYPASS)
+    {
+        // If bypass is enabled, ramp down the wet signal to below one
+        // this is needed to set the bypassed flag correctly
+        if (value_ != 0.f)
+        {
+            globalWetCache = globalWet();
+            globalWet.setRampTo(-0.01f, 0.05f);
+        }
+        // If bypass is disabled, ramp up the wet signal to the cache value and set bypassed to false.
+        else
+        {
+            globalWet.setRampTo(globalWetCache, 0.05f);
+            bypassed = false;
+        }
+        
+        // Update the dry signal to be the cosine inverse of the wet signal.
+        globalDry = getDryAmount(globalWet());
+    }
+    
+    else if (index_ == Engine::GLOBAL_MIX)
+    {
+        // set the ramps target to the new value
+        globalWet.setRampTo(value_, 0.01f);
+    }
+    
+    else if (index_ == Engine::EFFECT_ORDER)
+    {
+        const uint chain = (uint)value_;
+        
+        if (chain < NUM_EFFECT_CHAINS) applyEffectOrder(static_cast<EffectChain>(chain));
+    }
+    
+    else if (index_ == EFFECT_GRAPH_CHANGE)
+    {
+        applyEffectGraph((uint)value_);
+    }
 }
 
 
@@ -328,7 +414,7 @@ void AudioEngine::updateRamps()
 }
 
 
-AudioParameter* AudioEngine::getParameter(const String parameterID_)
+AudioParameter* AudioEngine::getParameter(const String& parameterID_)
 {
     AudioParameter* parameter = nullptr;
     
@@ -356,7 +442,7 @@ AudioParameter* AudioEngine::getParameter(const unsigned int paramgroup_, const
 }
 
 
-AudioParameter* AudioEngine::getParameter(const String paramGroup_, const String paramID_)
+AudioParameter* AudioEngine::getParameter(const String& paramGroup_, const String& paramID_)
 {
     AudioParameterGroup* parametergroup = nullptr;
     
@@ -396,29 +482,40 @@ AudioParameter* AudioEngine::getParameter(const String& paramGroup_, const uint
 }
 
 
+AudioParameter* AudioEngine::getParameter(const EffectOrder effect_, const uint paramIndex_)
+{
+    return getEffect(ENUM2INT(effect_))->getParameter(paramIndex_);
+}
+
+
 AudioParameter* AudioEngine::getParameterFromCCIndex(const uint ccIndex_)
 {
-    AudioParameter* parameter = nullptr;
-    bool found = false;
+    AudioParameter* parameter = ccIndex_ < NUM_MIDI_CC ? ccTable[ccIndex_] : nullptr;
+    
+    if (!parameter)
+        engine_rt_error("AudioEngine couldnt find Parameter with CC Index " + TOSTRING(ccIndex_), __FILE__, __LINE__, false);
+    
+    return parameter;
+}
+
+
+void AudioEngine::updateCCTable()
+{
+    ccTable.fill(nullptr);
     
     for (auto i : programParameters)
     {
         for (uint n = 0; n < i->getNumParametersInGroup(); ++n)
         {
-            if (i->getParameter(n)->getCCIndex() == ccIndex_)
-            {
-                parameter = i->getParameter(n);
-                found = true;
-                break;
-            }
+            AudioParameter* parameter = i->getParameter(n);
+            uint ccIndex = parameter->getCCIndex();
+            
+            // CC index 0 means not connected, the first parameter with a CC index owns it
+            if (ccIndex == 0 || ccIndex >= NUM_MIDI_CC || ccTable[ccIndex]) continue;
+            
+            ccTable[ccIndex] = parameter;
         }
-        if (found) break;
     }
-    
-    if (!parameter)
-        engine_rt_error("AudioEngine couldnt find Parameter with CC Index " + TOSTRING(ccIndex_), __FILE__, __LINE__, false);
-    
-    return parameter;
 }
 
 
@@ -479,6 +576,9 @@ void UserInterface::setup(AudioEngine* engine_, const float sampleRate_)
     // Set up the display: establish the OSC connection for the OLED display and set the
     // initial page to be displayed on startup.
     display.setup(menu.getPage("load_preset"));
+    
+    // Enable the CPU meter if it is switched on in the global settings.
+    engine->getCpuMeter().setEnabled(menu.getPage("cpu_meter_enabled")->getCurrentChoiceIndex() == 1);
 
     // Configure the tempo tapper.
     tempoTapper.setup(engine->getParameter("tempo")->getMin(), engine->getParameter("tempo")->getMax(), sampleRate_);
@@ -540,6 +640,9 @@ void UserInterface::initializeMenu()
     menu.addPage<Menu::ParameterPage>("granulator_envelopetype", engine->getParameter("granulator", "granulator_envelopetype"));
     menu.addPage<Menu::ParameterPage>("granulator_glide", engine->getParameter("granulator", "granulator_glide"));
     
+    menu.addPage<Menu::ParameterPage>("ringmod_oversampling", engine->getParameter("ringmodulator", "ringmod_oversampling"));
+    menu.addPage<Menu::ParameterPage>("ringmod_resampler", engine->getParameter("ringmodulator", "ringmod_resampler"));
+    
     // Configure the menu: pass in the complete set of parameters.
     menu.setup(engine->getProgramParameters());
 }
@@ -663,7 +766,7 @@ void UserInterface::initializeListeners()
     
     // Engine sets a small Ramp if the Global Bypass button is pressed
     engine->getParameter("global_bypass")->onChange.push_back([this] {
-        engine->setBypass(engine->getParameter("global_bypass")->getValueAsFloat());
+        engine->setBypass(engine->getParameter(Engine::GLOBAL_BYPASS)->getValueAsFloat());
     });
     
     // Engine calculates internal wet/dry values if Global Mix Parameter changes
@@ -716,6 +819,9 @@ void UserInterface::updateNonAudioTasks()
 {
     // if a Menu Parameter is in Scrolling Mode, scroll it
     if (menu.isScrolling) menu.scroll();
+    
+    // drain the CPU meter, so its ring buffers don't overflow
+    if (engine->getCpuMeter().isEnabled()) updateCpuMeter();
 
     // if a UI Parameter is in Scrolling Mode
     if (scrollingParameter)
@@ -746,6 +852,35 @@ void UserInterface::globalSettingChanged(Menu::Page* page_)
         
         alertLEDs(LED::ALERT);
     }
+    
+    else if (page_->getID() == "cpu_meter_enabled")
+    {
+        engine->getCpuMeter().setEnabled(page_->getCurrentChoiceIndex() == 1);
+        
+        alertLEDs(LED::ALERT);
+    }
+}
+
+
+void UserInterface::updateCpuMeter()
+{
+    Telemetry::CpuMeter& cpuMeter = engine->getCpuMeter();
+    
+    if (!cpuMeter.collect()) return;
+    
+    // rewrite the lines of the menu page
+    Menu::Page* page = menu.getPage("cpu_meter");
+    
+    for (uint n = 0; n < Telemetry::NUM_PROBES; ++n)
+        page->update(cpuMeter.getReportLine(static_cast<Telemetry::Probe>(n)), n);
+    
+    page->update("Xruns " + TOSTRING((int)cpuMeter.getNumXruns()) + " Over " + TOSTRING((int)cpuMeter.getNumOverruns()),
+                 Telemetry::NUM_PROBES);
+    
+    // send the numbers to the OSC receiver and refresh the display if the page is shown
+    display.sendCpuMeter(cpuMeter);
+    
+    if (menu.getCurrentPage() == page) display.menuPageChanged(page);
 }
 
 
@@ -773,6 +908,45 @@ void UserInterface::effectOrderChanged()
 
 
 void UserInterface::handleMidiControlChangeMessage(const uint ccIndex_, const uint ccValue_)
+{
+    if (ccIndex_ >= NUM_MIDI_CC) return;
+    
+    // store the value first, then flag it, so the flag never announces an older value
+    pendingCCValues[ccIndex_].store((uint8_t)ccValue_, std::memory_order_relaxed);
+    pendingCCs[ccIndex_ / 64].fetch_or(1ull << (ccIndex_ % 64), std::memory_order_release);
+}
+
+
+void UserInterface::handleMidiProgramChangeMessage(const uint presetIndex_)
+{
+    pendingProgramChange.store((int)presetIndex_, std::memory_order_release);
+}
+
+
+void UserInterface::processMidiControlChanges()
+{
+    // the preset first, control changes received along with it are applied on top of it
+    int presetIndex = pendingProgramChange.exchange(-1, std::memory_order_acquire);
+    if (presetIndex >= 0) menu.handleMidiProgramChangeMessage(presetIndex);
+    
+    for (uint word = 0; word < NUM_MIDI_CC / 64; ++word)
+    {
+        // take all flags at once, values arriving meanwhile are flagged again for the next call
+        uint64_t pending = pendingCCs[word].exchange(0, std::memory_order_acquire);
+        
+        while (pending)
+        {
+            uint bit = __builtin_ctzll(pending);
+            pending &= pending - 1;
+            
+            uint ccIndex = word * 64 + bit;
+            applyMidiControlChange(ccIndex, pendingCCValues[ccIndex].load(std::memory_order_relaxed));
+        }
+    }
+}
+
+
+void UserInterface::applyMidiControlChange(const uint ccIndex_, const uint ccValue_)
 {
     // Refer to the MIDI implementation PDF for more details.
     // All values above 100 correspond to a program change where certain effects are engaged or bypassed.
@@ -790,9 +964,9 @@ void UserInterface::handleMidiControlChangeMessage(const uint ccIndex_, const ui
             int reverbEngaged = (ccIndex_ == 101 || ccIndex_ == 105 || ccIndex_ == 107 || ccIndex_ == 108);
             
             // Update the engagement state of the effects.
-            engine->getParameter("engine", "effect1_engaged")->setValue(ringmodEngaged);
-            engine->getParameter("engine", "effect2_engaged")->setValue(granulatorEngaged);
-            engine->getParameter("engine", "effect3_engaged")->setValue(reverbEngaged);
+            engine->getParameter(Engine::EFFECT1_ENGAGED)->setValue(ringmodEngaged);
+            engine->getParameter(Engine::EFFECT2_ENGAGED)->setValue(granulatorEngaged);
+            engine->getParameter(Engine::EFFECT3_ENGAGED)->setValue(reverbEngaged);
         }
         
         return;
@@ -811,7 +985,7 @@ void UserInterface::handleMidiControlChangeMessage(const uint ccIndex_, const ui
     // decouple the potentiometer and update its reference value.
     if (param->getIndex() < NUM_POTENTIOMETERS - 1)
     {
-        int currentEffectIndex = engine->getParameter("effect_edit_focus")->getValueAsInt();
+        int currentEffectIndex = engine->getParameter(Engine::EFFECT_EDIT_FOCUS)->getValueAsInt();
         
         if (ccIndex_ <= 20 && currentEffectIndex == (int)EffectOrder::RINGMODULATOR)
             potentiometer[ccIndex_ - 1].decouple(param->getNormalizedValue());
@@ -824,7 +998,7 @@ void UserInterface::handleMidiControlChangeMessage(const uint ccIndex_, const ui
     }
     
     // Special case: Handle the global mix potentiometer separately.
-    if (param->getID() == "global_mix")
+    if (param == engine->getParameter(Engine::GLOBAL_MIX))
         potentiometer[NUM_POTENTIOMETERS - 1].decouple(param->getNormalizedValue());
 }
 
@@ -832,7 +1006,7 @@ void UserInterface::handleMidiControlChangeMessage(const uint ccIndex_, const ui
 void UserInterface::setEffectEditFocus()
 {
     // get a pointer to the effect-edit-focus-parameter
-    auto focusParam = engine->getParameter("effect_edit_focus");
+    auto focusParam = engine->getParameter(Engine::EFFECT_EDIT_FOCUS);
     
     // get a pointer to the effect processor that's currently focussed
     auto effect = engine->getEffect(focusParam->getValueAsInt());
@@ -885,18 +1059,18 @@ void UserInterface::mixPotentiometerChanged()
     // else its the global wet parameter
     AudioParameter* focusedParameter;
     if (button[BUTTON_FX1].getPhase() == Button::LOW)
-        focusedParameter = engine->getParameter("ringmodulator", "ringmod_mix");
+        focusedParameter = engine->getParameter(EffectOrder::RINGMODULATOR, ENUM2INT(RingModulation::Parameters::MIX));
     else if (button[BUTTON_FX2].getPhase() == Button::LOW)
-        focusedParameter = engine->getParameter("granulator", "granulator_mix");
+        focusedParameter = engine->getParameter(EffectOrder::GRANULATOR, ENUM2INT(Granulation::Parameters::MIX));
     else if (button[BUTTON_FX3].getPhase() == Button::LOW)
-        focusedParameter = engine->getParameter("reverb", "reverb_mix");
+        focusedParameter = engine->getParameter(EffectOrder::REVERB, ENUM2INT(Reverberation::Parameters::MIX));
     else
-        focusedParameter = engine->getParameter("global_mix");
+        focusedParameter = engine->getParameter(Engine::GLOBAL_MIX);
     
     // find out if the focussed parameter is the same than the last attached one
     bool sameParameter;
     if (lastAttachedParameter == nullptr) sameParameter = false;
-    else if (focusedParameter->getID() == lastAttachedParameter->getID()) sameParameter = true;
+    else if (focusedParameter == lastAttachedParameter) sameParameter = true;
     else sameParameter = false;
     
     // this is needed to make the pot catching function work correctly
@@ -932,7 +1106,7 @@ void UserInterface::evaluateNewTempo()
     bool newTempoDetected = tempoTapper.tapTempo();
     
     if (newTempoDetected)
-        engine->getParameter("tempo")->setValue(tempoTapper.getTempoInBpm());
+        engine->getParameter(Engine::TEMPO)->setValue(tempoTapper.getTempoInBpm());
 }
 
 
@@ -948,16 +1122,16 @@ void UserInterface::setTempoRelatedParameters()
     }
 
     // Retrieve the current tempo in BPM from the parameter.
-    float tempoBpm = engine->getParameter("tempo")->getValueAsFloat();
+    float tempoBpm = engine->getParameter(Engine::TEMPO)->getValueAsFloat();
     
     // Retrieve the menu setting 'Tempo Set'.
-    String tempoSetOption = engine->getParameter("engine", "tempo_set")->getValueAsString();
+    String tempoSetOption = engine->getParameter(Engine::TEMPO_SET)->getValueAsString();
     
     // check for the two valid options of 'Tempo Set'
     if (tempoSetOption == "Current Effect" || tempoSetOption == "All Effects")
     {
         // Get the index of the currently focused effect.
-        int effectIndex = engine->getParameter("effect_edit_focus")->getValueAsInt();
+        int effectIndex = engine->getParameter(Engine::EFFECT_EDIT_FOCUS)->getValueAsInt();
         
         // Get a pointer to the current effect.
         auto effect = engine->getEffect(effectIndex);
@@ -966,7 +1140,7 @@ void UserInterface::setTempoRelatedParameters()
         if (effect->getId() == "reverb" || tempoSetOption == "All Effects")
         {
             // Get a pointer to the Predelay parameter.
-            auto predelay = engine->getParameter("reverb", "reverb_predelay");
+            auto predelay = engine->getParameter(EffectOrder::REVERB, ENUM2INT(Reverberation::Parameters::PREDELAY));
             
             // Convert BPM to milliseconds.
             // * 8.f: Fit the BPM range to the range of the predelay.
@@ -984,15 +1158,15 @@ void UserInterface::setTempoRelatedParameters()
         if (effect->getId() == "granulator" || tempoSetOption == "All Effects")
         {
             // Retrieve the Grain Length parameter for the granulator effect.
-            auto density = engine->getParameter("granulator", "granulator_density");
+            auto density = engine->getParameter(EffectOrder::GRANULATOR, ENUM2INT(Granulation::Parameters::DENSITY));
             
             // Convert BPM to milliseconds.
             float tempoMs = bpm2msec(tempoBpm);
             float tempoRate = 1000.f / tempoMs;
             tempoRate *= 2.f;
             
-            // Set the new density value without triggering a print notification.
-            effect->synchronize();
+            // Restart the grain onsets on the audio thread, then set the new density value without triggering a print notification.
+            engine->getEffect(ENUM2INT(EffectOrder::GRANULATOR))->requestSynchronize();
             density->setValue(tempoRate, false);
             
             // Decouple the corresponding potentiometer and set its cache to the new normalized value.
@@ -1003,7 +1177,7 @@ void UserInterface::setTempoRelatedParameters()
         if (effect->getId() == "ringmodulator" || tempoSetOption == "All Effects")
         {
             // Retrieve the Rate parameter for the granulator effect.
-            auto rate = engine->getParameter("ringmodulator", "ringmod_rate");
+            auto rate = engine->getParameter(EffectOrder::RINGMODULATOR, ENUM2INT(RingModulation::Parameters::RATE));
             
             // Convert BPM to milliseconds.
             float tempoMs = bpm2msec(tempoBpm);
@@ -1012,8 +1186,8 @@ void UserInterface::setTempoRelatedParameters()
             
             boundValue(tempoRate, rate->getMin(), rate->getMax());
             
-            // Set the new density value without triggering a print notification.
-            effect->synchronize();
+            // Restart the LFO phases on the audio thread, then set the new rate value without triggering a print notification.
+            engine->getEffect(ENUM2INT(EffectOrder::RINGMODULATOR))->requestSynchronize();
             rate->setValue(tempoRate, false);
             
             // Decouple the corresponding potentiometer and set its cache to the new normalized value.
@@ -1142,7 +1316,7 @@ void UserInterface::displayTouchedParameter(uint paramIndex_)
     }
 
     // Retrieve the index of the currently focused effect.
-    int focus = engine->getParameter("effect_edit_focus")->getValueAsInt();
+    int focus = engine->getParameter(Engine::EFFECT_EDIT_FOCUS)->getValueAsInt();
 
     // Get a pointer to the focused effect.
     auto effect = engine->getEffect(focus);
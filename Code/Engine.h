@@ -17,6 +17,7 @@
 #include "Functions.h"
 #include "UIElements.hpp"
 #include "EffectProcessor.hpp"
+#include "EffectGraph.hpp"
 #include "Parameters.hpp"
 #include "Menu.hpp"
 #include "Outputs.hpp"
@@ -25,8 +26,6 @@
 // MARK: - AUDIO ENGINE
 // =======================================================================================
 
-typedef std::function<float32x2_t(float32x2_t, uint)> ProcessFunctionPointer;
-
 /**
  * @class AudioEngine
  * @brief Manages audio processing, effects, and parameters.
@@ -35,8 +34,11 @@ typedef std::function<float32x2_t(float32x2_t, uint)> ProcessFunctionPointer;
  * audio parameters, processing audio samples, and handling bypass and ramping for effects. It is responsible
  * for coordinating the signal flow through various effects, updating parameter values, and ensuring that
  * audio processing occurs in a smooth and controlled manner.
+ *
+ * Parameter changes of the engine and the effects are queued by the control threads and applied at the start
+ * of the next audio block, so the DSP state is only ever written by the audio thread.
  */
-class AudioEngine
+class AudioEngine : public ParameterReceiver
 {
 public:
     /**
@@ -74,6 +76,20 @@ public:
      */
     float32x2_t processAudioSamples(float32x2_t input_, uint sampleIndex_);
     
+    /**
+     * @brief Processes a block of non-interleaved stereo audio samples.
+     *
+     * Block counterpart of `processAudioSamples()`, which stays as the samplewise reference of the effect orders.
+     * The queued parameter changes are applied first, then the block is processed through the schedule of the current
+     * `EffectGraph`, the global wet/dry ramp is processed once every RAMP_BLOCKSIZE samples. Blocks larger than the
+     * block size given in `setup()` are split.
+     *
+     * @param input_ Pointers to the left and right input channel.
+     * @param output_ Pointers to the left and right output channel, may alias the input.
+     * @param numFrames_ The number of samples per channel.
+     */
+    void processAudioBlock(const float* const input_[2], float* const output_[2], const uint numFrames_);
+    
     /** 
      * @brief updates internal blockwise processing
      *
@@ -84,17 +100,59 @@ public:
     /**
      * @brief Sets the processing order for the effects.
      *
-     * This function determines the order in which effects are processed, based on internal logic and
-     * configuration. It is crucial for managing the signal flow within the audio engine.
+     * The current choice of the `effect_order` parameter selects one of the `EffectChain`s and its graph. The new order
+     * is applied at the start of the next audio block.
      */
     void setEffectOrder();
     
+    /**
+     * @brief Creates an additional effect processor, e.g. to place a second granulator in an effect graph.
+     *
+     * Its parameters are not part of the program parameters, they can be reached with
+     * `EffectProcessor::getEffectParameterGroup()`. Allocates, don't call it on the audio thread.
+     *
+     * @param type_ The type of the effect.
+     * @param name_ The name of the effect processor = ID.
+     * @return A pointer to the new effect processor, which lives as long as the engine.
+     */
+    EffectProcessor* createEffect(const EffectOrder type_, const String& name_);
+    
+    /**
+     * @brief Restarts the random sequences of all effects, e.g. the grain properties and the noise.
+     *
+     * Every effect gets its own seed derived from `seed_`, effects created later included. The same seed and the
+     * same input reproduce the same output. `setup()` seeds with DEFAULT_RANDOM_SEED. Call it between blocks.
+     *
+     * @param seed_ The seed.
+     */
+    void setRandomSeed(const uint32_t seed_);
+    
+    /**
+     * @brief Adds an effect graph, compiles it if that didn't happen yet.
+     *
+     * The graphs of the effect orders come first, so the index of the graph of an `EffectChain` is its value.
+     * Allocates, don't call it on the audio thread.
+     *
+     * @param graph_ The graph, its slots have to hold effects of this engine.
+     * @return The index of the graph, or -1 if the graph has a cycle or there is no space left.
+     */
+    int addEffectGraph(std::unique_ptr<EffectGraph> graph_);
+    
+    /**
+     * @brief Processes the blocks through the graph with the given index, from the start of the next audio block.
+     *
+     * `processAudioSamples()` keeps following the effect order.
+     *
+     * @param index_ The index returned by `addEffectGraph()`.
+     */
+    void setEffectGraph(const uint index_);
+    
     /**
      * @brief Sets the bypass state of the audio engine.
      *
      * This function enables or disables bypass for the entire audio engine by ramping the global wet
      * signal up or down. When bypassed, the effects are effectively muted, allowing the original input
-     * to pass through unchanged.
+     * to pass through unchanged. The change is applied at the start of the next audio block.
      *
      * @param bypassed_ Whether to bypass the engine (true to bypass, false to process normally).
      */
@@ -103,9 +161,17 @@ public:
     /** @brief Updates the ramps */
     void updateRamps();
     
-    /** @brief Sets the Dry/Wet Gains for the whole Effect Machine */
+    /** @brief Sets the Dry/Wet Gains for the whole Effect Machine, applied at the start of the next audio block */
     void setGlobalMix();
     
+    /**
+     * @brief Applies a queued change of an engine parameter, on the audio thread.
+     * @param index_ The engine parameter, `Engine::GLOBAL_BYPASS`, `Engine::GLOBAL_MIX`, `Engine::EFFECT_ORDER`
+     * or `EFFECT_GRAPH_CHANGE`.
+     * @param value_ The bypass state, the wet gain, the effect chain or the index of the graph.
+     */
+    void applyParameterChange(const uint index_, const float value_) override;
+    
     /**
      * @brief Retrieves an audio parameter by its ID.
      *
@@ -116,7 +182,27 @@ public:
      * @param parameterID_ The ID of the parameter to retrieve.
      * @return A pointer to the requested AudioParameter.
      */
-    AudioParameter* getParameter(const String parameterID_);
+    AudioParameter* getParameter(const String& parameterID_);
+    
+    /**
+     * @brief Retrieves an engine parameter by its index, without searching by ID.
+     * @param parameter_ The index of the engine parameter.
+     * @return A pointer to the requested AudioParameter.
+     */
+    AudioParameter* getParameter(const Engine::Parameters parameter_) { return engineParameters.getParameter(parameter_); }
+    
+    /**
+     * @brief Retrieves a parameter of an effect by its index, without searching by ID.
+     *
+     * Use this on frequently called paths, the index is one of the effects parameter enums,
+     * i.e. `Reverberation::Parameters`.
+     *
+     * @attention stops running if parameter is not found
+     * @param effect_ The effect the parameter belongs to.
+     * @param paramIndex_ The index of the parameter within the effects parameter group.
+     * @return A pointer to the requested AudioParameter.
+     */
+    AudioParameter* getParameter(const EffectOrder effect_, const uint paramIndex_);
 
     /**
      * @brief Retrieves an audio parameter by its group and index.
@@ -142,7 +228,7 @@ public:
      * @param paramID_ The ID of the parameter within the group.
      * @return A pointer to the requested AudioParameter.
      */
-    AudioParameter* getParameter(const String paramGroup_, const String paramID_);
+    AudioParameter* getParameter(const String& paramGroup_, const String& paramID_);
     
     /**
      * @brief Retrieves an audio parameter by its group name and index.
@@ -160,13 +246,21 @@ public:
     /**
      * @brief Gets an audio parameter by its midi CC index
      *
-     * This functions is saerching for a parameter that is connected to the given CC index.
+     * This functions looks the parameter up in the CC table, without searching the parameter groups.
      *
      * @param ccIndex_ the cc index of the parameter
      * @return A pointer to the requested AudioParameter, or nullptr if not found
      */
     AudioParameter* getParameterFromCCIndex(const uint ccIndex_);
     
+    /**
+     * @brief Rebuilds the table that maps every MIDI CC index to its parameter.
+     *
+     * `setup()` builds the table once all parameters exist. Call it again whenever the CC index of
+     * a parameter changed (`AudioParameter::setupMIDI()`).
+     */
+    void updateCCTable();
+    
     /**
      * @brief Gets the program parameters.
      *
@@ -188,6 +282,21 @@ public:
      * @return A pointer to the requested EffectProcessor.
      */
     EffectProcessor* getEffect(const unsigned int index_);
+    
+    /**
+     * @brief Gets the CPU meter, which times the engine, the effects and the auxiliary tasks.
+     *
+     * The meter is disabled by default, see `Telemetry::CpuMeter`.
+     *
+     * @return A reference to the CPU meter.
+     */
+    Telemetry::CpuMeter& getCpuMeter() { return cpuMeter; }
+    
+    /**
+     * @brief Gets the queue that hands parameter changes from the control threads over to the audio thread.
+     * @return A reference to the parameter queue.
+     */
+    ParameterQueue& getParameterQueue() { return parameterQueue; }
         
 private:
     /**
@@ -198,24 +307,66 @@ private:
      */
     void initializeEngineParameters();
     
+    /**
+     * @brief Allocates an effect processor of the given type, aligned for the SIMD types.
+     * @param type_ The type of the effect.
+     * @param name_ The name of the effect processor = ID.
+     * @return A pointer to the effect processor, which isn't set up yet.
+     */
+    EffectProcessor* allocateEffect(const EffectOrder type_, const String& name_);
+    
+    /**
+     * @brief Builds the graph of an effect order from the layout of its chain.
+     * @param chain_ The effect chain.
+     * @return The graph, not yet compiled.
+     */
+    std::unique_ptr<EffectGraph> createChainGraph(const EffectChain chain_);
+    
+    /**
+     * @brief Switches to the given effect chain and its graph, on the audio thread.
+     * @param chain_ The effect chain.
+     */
+    void applyEffectOrder(const EffectChain chain_);
+    
+    /**
+     * @brief Switches to the given graph, on the audio thread.
+     *
+     * Tells every effect of the graph whether it is processed in series or in parallel.
+     *
+     * @param index_ The index of the graph.
+     */
+    void applyEffectGraph(const uint index_);
+    
     EffectProcessor* effectProcessor[NUM_EFFECTS]; /**< Array of pointers to effect processors. */
     
     std::array<AudioParameterGroup*, NUM_PARAMETERGROUPS> programParameters; /**< Array of program parameter groups. */
     AudioParameterGroup engineParameters; /**< Parameters specific to the audio engine. */
+    std::array<AudioParameter*, NUM_MIDI_CC> ccTable {}; /**< The parameter of every MIDI CC index, nullptr if unassigned. */
     
     bool bypassed = false;  ///< Flag indicating whether the engine is currently bypassed.
     LinearRamp globalWet;  ///< Ramp for controlling the wet signal in the global bypass control.
     float globalWetCache; ///< a small cache variable to not forget the previous wet gain, when global bypass button is pressed
     float globalDry;  ///< Multiplier for the dry signal in the global bypass control.
     
-    ProcessFunctionPointer processFunction[3][3];  ///< Function pointers for processing audio through the effects.
-    int processIndex[3][3];  ///< Indexes associated with the process functions.
+    std::vector<EffectProcessor*> additionalEffects;  ///< Effect processors created with `createEffect()`.
+    uint32_t randomSeed = DEFAULT_RANDOM_SEED;  ///< The seed of the effects, the effect at index n uses randomSeed + n.
+    
+    EffectChain effectChain = EffectChain::RING_GRAN_REV;  ///< The chain the samples are processed in.
+    
+    static const uint MAX_EFFECT_GRAPHS = 16;  ///< The graphs of the effect orders and the added ones.
+    std::array<std::unique_ptr<EffectGraph>, MAX_EFFECT_GRAPHS> effectGraphs;  ///< Only added to, never replaced.
+    uint numEffectGraphs = 0;  ///< Number of added graphs, control thread only.
+    std::atomic<EffectGraph*> activeGraph { nullptr };  ///< The graph the blocks are processed in.
+    
+    Telemetry::CpuMeter cpuMeter;  ///< Per-block timing of the engine, the effects and the auxiliary tasks.
+    ParameterQueue parameterQueue;  ///< Parameter changes waiting to be applied at the start of the next block.
     
     float sampleRate;  ///< Sample rate of the audio engine.
     unsigned int blockSize;  ///< Block size for audio processing.
     
     static const uint RAMP_BLOCKSIZE;  ///< Block size for the wet/dry ramp processing.
     static const uint RAMP_BLOCKSIZE_WRAP;  ///< Wrap size for the wet/dry ramp processing.
+    static const uint EFFECT_GRAPH_CHANGE;  ///< Queued index of a graph change, above all engine parameters.
 };
 
 
@@ -405,7 +556,7 @@ public:
      * This function handles the continuous updating of non-audio tasks within the user interface. It checks if the
      * menu is in scrolling mode and updates the scrolling accordingly. Additionally, if a UI parameter is in scrolling
      * mode, it scrolls the parameter value, ensuring that the corresponding potentiometer is decoupled and refreshed
-     * to reflect the new normalized value.
+     * to reflect the new normalized value. It also collects the measurements of the CPU meter.
      */
     void updateNonAudioTasks();
     
@@ -440,15 +591,34 @@ public:
     /**
      * @brief Handles MIDI control change messages.
      *
-     * This function processes incoming MIDI control change messages by identifying
-     * the parameter associated with the specified control change index (ccIndex)
-     * and applying the corresponding value (ccValue) to it.
+     * This function only stores the value of an incoming MIDI control change message, it can be called
+     * from the MIDI thread. The stored values are applied by `processMidiControlChanges()`. If a controller
+     * sends several values before they are applied, only the latest one is applied.
      *
      * @param ccIndex_ The index of the MIDI control change (Control Change Number).
      * @param ccValue_ The value associated with the MIDI control change (0-127).
      */
     void handleMidiControlChangeMessage(const uint ccIndex_, const uint ccValue_);
     
+    /**
+     * @brief Handles MIDI program change messages.
+     *
+     * Like `handleMidiControlChangeMessage()`, this only stores the preset index and can be called from the
+     * MIDI thread. The preset is loaded by `processMidiControlChanges()`, so the JSON I/O happens on the thread
+     * that handles the other controls. If several program changes arrive before that, only the latest one is loaded.
+     *
+     * @param presetIndex_ The index of the preset (Program Number).
+     */
+    void handleMidiProgramChangeMessage(const uint presetIndex_);
+    
+    /**
+     * @brief Applies the latest program change and the latest value of every MIDI control change received since the last call.
+     *
+     * Call this regularly from the thread that handles the other controls, so a dense CC stream costs
+     * one parameter change per controller and call.
+     */
+    void processMidiControlChanges();
+    
 private:
     /**
      * @brief Initializes all UI elements including buttons, potentiometers, and LEDs.
@@ -580,6 +750,25 @@ private:
      */
     void alertLEDs(LED::State state_);
     
+    /**
+     * @brief Applies a MIDI control change message.
+     *
+     * This function identifies the parameter associated with the specified control change index (ccIndex)
+     * and applies the corresponding value (ccValue) to it.
+     *
+     * @param ccIndex_ The index of the MIDI control change (Control Change Number).
+     * @param ccValue_ The value associated with the MIDI control change (0-127).
+     */
+    void applyMidiControlChange(const uint ccIndex_, const uint ccValue_);
+    
+    /**
+     * @brief Collects the measurements of the CPU meter and publishes every new report.
+     *
+     * A new report rewrites the lines of the CPU Meter menu page (and refreshes the display if the page
+     * is shown) and is sent to the OSC receiver.
+     */
+    void updateCpuMeter();
+    
     AudioEngine* engine = nullptr;  ///< Pointer to the AudioEngine instance, used to link UI components to audio parameters.
 
     TempoTapper tempoTapper;  ///< Instance of the tempo tapper, manages tempo detection and tapping functionality.
@@ -588,6 +777,10 @@ private:
     
     AudioParameter* scrollingParameter = nullptr;  ///< Pointer to the currently scrolling parameter in the UI.
     int scrollingDirection;  ///< Direction in which the parameter is being scrolled (-1 for down, 1 for up).
+    
+    std::array<std::atomic<uint8_t>, NUM_MIDI_CC> pendingCCValues {};  ///< The latest received value of every MIDI CC index.
+    std::atomic<uint64_t> pendingCCs[NUM_MIDI_CC / 64] {};  ///< One bit per MIDI CC index with a value that hasn't been applied yet.
+    std::atomic<int> pendingProgramChange { -1 };  ///< The latest received preset index that hasn't been loaded yet, -1 if none.
 
 public:
     Button button[NUM_BUTTONS];  ///< Array of buttons in the user interface, each mapped to a specific function.
@@ -15,6 +15,7 @@ static const size_t NUM_BUTTONS = 10;
 static const size_t NUM_LEDS = 6;
 static const size_t NUM_EFFECTS = 3;
 static const size_t NUM_PARAMETERGROUPS = 4;
+static const size_t NUM_MIDI_CC = 128;
 
 // MARK: - PRESETS
 // =======================================================================================
@@ -76,6 +77,42 @@ static const String effectNames[NUM_EFFECTS] {
     "Reverb"
 };
 
+// the effect numbers are the EffectOrder + 1, '-' processes in series, '|' in parallel
+enum class EffectChain {
+    RING_GRAN_REV,
+    PARALLEL,
+    REV_GRAN_RING,
+    REV_RING_GRAN,
+    GRAN_REV_RING,
+    GRAN_RING_REV,
+    RING_REV_GRAN,
+    NUM_EFFECT_CHAINS
+};
+
+static const size_t NUM_EFFECT_CHAINS = (size_t)EffectChain::NUM_EFFECT_CHAINS;
+
+static const String effectChainNames[NUM_EFFECT_CHAINS] {
+    "1 - 2 - 3",
+    "1 | 2 | 3",
+    "3 - 2 - 1",
+    "3 - 1 - 2",
+    "2 - 3 - 1",
+    "2 - 1 - 3",
+    "1 - 3 - 2"
+};
+
+// the layout of every effect chain [chain][stage][effect], the stages are processed in series,
+// the effects of a stage in parallel, unused slots are -1
+static const int effectChainLayouts[NUM_EFFECT_CHAINS][NUM_EFFECTS][NUM_EFFECTS] {
+    { { 0, -1, -1 }, { 1, -1, -1 }, { 2, -1, -1 } },
+    { { 0, 1, 2 }, { -1, -1, -1 }, { -1, -1, -1 } },
+    { { 2, -1, -1 }, { 1, -1, -1 }, { 0, -1, -1 } },
+    { { 2, -1, -1 }, { 0, -1, -1 }, { 1, -1, -1 } },
+    { { 1, -1, -1 }, { 2, -1, -1 }, { 0, -1, -1 } },
+    { { 1, -1, -1 }, { 0, -1, -1 }, { 2, -1, -1 } },
+    { { 0, -1, -1 }, { 2, -1, -1 }, { 1, -1, -1 } }
+};
+
 // MARK: - POT BEHAVIOUR
 // =======================================================================================
 
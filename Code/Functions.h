@@ -243,6 +243,29 @@ inline float approximateSine(float angle)
 }
 
 
+/**
+ * @brief approximates the sine of four angles without branches, with the same values as `approximateSine()` of a float
+ *
+ * @param angle the x positions (0.0 to 2PI)
+ *
+ * @return the y positions (-1.0 to 1.0)
+ */
+inline float32x4_t approximateSine(const float32x4_t angle)
+{
+    // fold every quadrant onto the first one, the comparisons replace the branches of the scalar version
+    float32x4_t folded = angle;
+    folded = vbslq_f32(vcgeq_f32(angle, vdupq_n_f32(PIo2)), vsubq_f32(vdupq_n_f32(PI), angle), folded);
+    folded = vbslq_f32(vcgeq_f32(angle, vdupq_n_f32(PI)), vsubq_f32(angle, vdupq_n_f32(PI)), folded);
+    folded = vbslq_f32(vcgeq_f32(angle, vdupq_n_f32(PI3o2)), vsubq_f32(vdupq_n_f32(TWOPI), angle), folded);
+    
+    const float32x4_t x = vsubq_f32(vmulq_n_f32(folded, TWOoPI), vdupq_n_f32(0.5f));
+    const float32x4_t j = vaddq_f32(vsubq_f32(vdupq_n_f32(0.75f), vmulq_f32(x, x)), x);
+    
+    // the second half of the period is the negative of the first one
+    return vbslq_f32(vcgeq_f32(angle, vdupq_n_f32(PI)), vnegq_f32(j), j);
+}
+
+
 /** @brief Determines the sign of a given value.
  *
  * @param value The input value.
@@ -284,6 +307,74 @@ inline float approximateTanh(const float x)
 }
 
 
+/** @brief The input beyond which `approximateTanh()` of a vector returns its limit, where the approximant reaches 1. */
+static const float TANH_RATIONAL_LIMIT = 4.97f;
+
+
+/** @brief Approximates the hyperbolic tangent of four values without branches or table lookups.
+ *
+ * Evaluates the [7/6] Padé approximant of tanh on the input clamped to +-TANH_RATIONAL_LIMIT,
+ * the error stays below 1e-4. The division is a reciprocal estimate refined by two Newton-Raphson steps,
+ * NEON on the Bela has no vector division.
+ *
+ * @param x The input values.
+ * @return The approximated tanh values.
+ */
+inline float32x4_t approximateTanh(const float32x4_t x)
+{
+    const float32x4_t input = vmaxq_f32(vminq_f32(x, vdupq_n_f32(TANH_RATIONAL_LIMIT)), vdupq_n_f32(-TANH_RATIONAL_LIMIT));
+    const float32x4_t x2 = vmulq_f32(input, input);
+    
+    // x * (135135 + 17325 x^2 + 378 x^4 + x^6) / (135135 + 62370 x^2 + 3150 x^4 + 28 x^6)
+    float32x4_t numerator = vaddq_f32(x2, vdupq_n_f32(378.f));
+    numerator = vmlaq_f32(vdupq_n_f32(17325.f), numerator, x2);
+    numerator = vmlaq_f32(vdupq_n_f32(135135.f), numerator, x2);
+    numerator = vmulq_f32(numerator, input);
+    
+    float32x4_t denominator = vmlaq_n_f32(vdupq_n_f32(3150.f), x2, 28.f);
+    denominator = vmlaq_f32(vdupq_n_f32(62370.f), denominator, x2);
+    denominator = vmlaq_f32(vdupq_n_f32(135135.f), denominator, x2);
+    
+    float32x4_t reciprocal = vrecpeq_f32(denominator);
+    reciprocal = vmulq_f32(reciprocal, vrecpsq_f32(denominator, reciprocal));
+    reciprocal = vmulq_f32(reciprocal, vrecpsq_f32(denominator, reciprocal));
+    
+    return vmulq_f32(numerator, reciprocal);
+}
+
+
+/** @brief Approximates the hyperbolic tangent of a stereo pair, see `approximateTanh()` of four values. */
+inline float32x2_t approximateTanh(const float32x2_t x)
+{
+    return vget_low_f32(approximateTanh(vcombine_f32(x, x)));
+}
+
+
+/** @brief Saturates four values with tanh curves of different gains for positive and negative values, without branches.
+ *
+ * For x >= 0: y(x) = tanh(gainPositive * x) * scalePositive
+ * For x <  0: y(x) = tanh(gainNegative * x) * scaleNegative
+ *
+ * The gains and scales are given per lane, so lanes with different curves share a call.
+ *
+ * @param x The input values.
+ * @param gainPositive The gains of the positive values.
+ * @param gainNegative The gains of the negative values.
+ * @param scalePositive The scales of the positive outputs, usually the inverse of tanh(gainPositive).
+ * @param scaleNegative The scales of the negative outputs.
+ * @return The saturated values.
+ */
+inline float32x4_t saturateAsymmetric(const float32x4_t x, const float32x4_t gainPositive, const float32x4_t gainNegative,
+                                      const float32x4_t scalePositive, const float32x4_t scaleNegative)
+{
+    const uint32x4_t isPositive = vcgeq_f32(x, vdupq_n_f32(0.f));
+    
+    const float32x4_t saturated = approximateTanh(vmulq_f32(x, vbslq_f32(isPositive, gainPositive, gainNegative)));
+    
+    return vmulq_f32(saturated, vbslq_f32(isPositive, scalePositive, scaleNegative));
+}
+
+
 /** @brief Converts beats per minute (BPM) to milliseconds. */
 inline float bpm2msec(float bpm)
 {
@@ -538,40 +629,6 @@ inline String trimWhiteSpace(const String& str)
 }
 
 
-/** @brief Generates a random number based on a Gaussian (normal) distribution.
- *
- * Uses the Box-Muller transform to generate a normally distributed random value
- * with a specified mean and standard deviation. The function alternates between
- * using the spare value from the last generation and creating two new random values
- * when needed. This ensures efficient generation of Gaussian-distributed numbers.
- *
- * @param mean The mean (center) of the Gaussian distribution.
- * @param stddev The standard deviation (spread) of the Gaussian distribution.
- * @return A float value sampled from the Gaussian distribution.
- */
-inline float generateGaussian(const float mean, const float stddev)
-{
-    static bool haveSpare = false;
-    static float rand1, rand2;
-
-    if (haveSpare)
-    {
-        haveSpare = false;
-        return mean + stddev * sqrtf_neon(rand1) * sinf_neon(rand2);
-    }
-
-    haveSpare = true;
-
-    rand1 = rand() * RAND_MAX_INVERSED;
-    if (rand1 < 1e-100) rand1 = 1e-100;  // Avoid log(0)
-
-    rand1 = -2.f * logf_neon(rand1);
-    rand2 = (rand() * RAND_MAX_INVERSED) * 2.0f * PI;
-
-    return mean + stddev * sqrtf_neon(rand1) * cosf_neon(rand2);
-}
-
-
 
 /** @} */
 
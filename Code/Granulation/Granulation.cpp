@@ -147,67 +147,6 @@ void FilterStereo::calcResonance()
 }
 
 
-// =======================================================================================
-// MARK: - ENVELOPES
-// =======================================================================================
-
-
-ParabolicEnvelope::ParabolicEnvelope(const uint durationSamples_, const float grainAmplitude_)
-    : Envelope(durationSamples_, grainAmplitude_)
-{
-    float r = 1.f / (float)durationSamples_;
-    float r2 = r * r;
-    slope = 4.f * grainAmplitude * (r - r2);
-    curve = -8.f * grainAmplitude * r2;
-}
-
-
-float ParabolicEnvelope::getNextAmplitude()
-{
-    nextAmplitude += slope;
-    slope += curve;
-    return nextAmplitude;
-}
-
-
-HannEnvelope::HannEnvelope(const uint durationSamples_, const float grainAmplitude_)
-    : Envelope(durationSamples_, grainAmplitude_)
-{
-    phase = 0;
-    invMaxPhase = 1.f / (float)(durationSamples - 1);
-}
-
-
-float HannEnvelope::getNextAmplitude()
-{
-    nextAmplitude = 0.5f * (1.f - cosf_neon(TWOPI * phase * invMaxPhase));
-    nextAmplitude *= grainAmplitude;
-    
-    ++phase;
-    
-    return nextAmplitude;
-}
-
-
-TriangularEnvelope::TriangularEnvelope(const uint durationSamples_, const float grainAmplitude_)
-    : Envelope(durationSamples_, grainAmplitude_)
-{
-    phase = 0;
-    invMaxPhase = 1.f / (float)(durationSamples - 1);
-}
-
-
-float TriangularEnvelope::getNextAmplitude()
-{
-    nextAmplitude = 1.f - fabsf_neon(2.f * phase * invMaxPhase - 1.f);
-    nextAmplitude *= grainAmplitude;
-    
-    ++phase;
-    
-    return nextAmplitude;
-}
-
-
 // =======================================================================================
 // MARK: - GRAIN PROPERTIES MANAGER
 // =======================================================================================
@@ -309,7 +248,7 @@ int GrainPropertiesManager::getNextInterOnset()
         if (max > MAX_INTERONSET) max = MAX_INTERONSET;
         
         // uniform distribution in the range around the predefined center position
-        nextInterOnset = min + rand() * RAND_MAX_INVERSED * (max-min);
+        nextInterOnset = min + random.getUniform() * (max-min);
     }
         
     return nextInterOnset;
@@ -331,7 +270,7 @@ GrainProperties* GrainPropertiesManager::getNextGrainProperties()
         float stddev = initDelayRange * 0.04166667f; // /= 24
         
         // Generate a Gaussian-distributed random number
-        float randomDelay = generateGaussian(initDelayCenter, stddev);
+        float randomDelay = random.getGaussian(initDelayCenter, stddev);
 
         // Clip the value within the bounds [min, max]
         if (randomDelay < min) randomDelay = min;
@@ -353,7 +292,7 @@ GrainProperties* GrainPropertiesManager::getNextGrainProperties()
         float stddev = lengthRange * 0.25f; // /= 4
 
         // Generate a Gaussian-distributed random number
-        float randomLength = generateGaussian(lengthCenter, stddev);
+        float randomLength = random.getGaussian(lengthCenter, stddev);
 
         // Clip the value within the bounds [min, max]
         if (randomLength < min) randomLength = min;
@@ -380,7 +319,7 @@ GrainProperties* GrainPropertiesManager::getNextGrainProperties()
     }
     else
     {
-        float panOffset = panningRange * rand() * RAND_MAX_INVERSED;
+        float panOffset = panningRange * random.getUniform();
         props.panHomeChannel = 1.f - panOffset;
         props.panNeighbourChannel = 1.f - props.panHomeChannel;
     }
@@ -390,16 +329,139 @@ GrainProperties* GrainPropertiesManager::getNextGrainProperties()
 
 
 // =======================================================================================
-// MARK: - GRAIN DATA
+// MARK: - ENVELOPES
 // =======================================================================================
 
 
-GrainData::GrainData(SourceData* sourceData_, GrainProperties* props_)
-    : sourceData(sourceData_)
-    , reverse(props_->reverse)
+namespace
+{
+
+/**
+ * @brief Evaluates an envelope shape in closed form, see `Envelope`.
+ * @param type_ The shape.
+ * @param x_ The normalized grain phase (0...1).
+ * @return The amplitude of the envelope.
+ */
+double evaluateEnvelope(const Envelope::Type type_, const double x_)
+{
+    switch (type_)
+    {
+        case Envelope::Type::PARABOLIC:
+        {
+            return 4.0 * x_ * (1.0 - x_);
+        }
+            
+        case Envelope::Type::HANN:
+        {
+            return 0.5 * (1.0 - std::cos(2.0 * M_PI * x_));
+        }
+            
+        case Envelope::Type::TRIANGULAR:
+        {
+            return 1.0 - std::fabs(2.0 * x_ - 1.0);
+        }
+            
+        case Envelope::Type::TUKEY:
+        {
+            // half of the grain is tapered, a quarter at each end
+            const double taper = 0.25;
+            const double distance = std::min(x_, 1.0 - x_);
+            
+            if (distance >= taper) return 1.0;
+            return 0.5 * (1.0 - std::cos(M_PI * distance / taper));
+        }
+            
+        case Envelope::Type::GAUSSIAN:
+        {
+            // the bell would start and end on 0.004, it is lowered to zero to avoid clicks
+            const double deviation = 0.15;
+            const double edge = std::exp(-0.5 * (0.5 / deviation) * (0.5 / deviation));
+            const double t = (x_ - 0.5) / deviation;
+            
+            return (std::exp(-0.5 * t * t) - edge) / (1.0 - edge);
+        }
+            
+        case Envelope::Type::DECAY:
+        default:
+        {
+            const double attack = 0.05;
+            const double decayRate = 5.0;
+            
+            if (x_ < attack) return 0.5 * (1.0 - std::cos(M_PI * x_ / attack));
+            
+            // the exponential is lowered to end on zero, like the gaussian
+            const double end = std::exp(-decayRate);
+            return (std::exp(-decayRate * (x_ - attack) / (1.0 - attack)) - end) / (1.0 - end);
+        }
+    }
+}
+
+
+/** @brief The tables of all envelope shapes, see `Envelope::getTables()`. */
+struct EnvelopeTables
 {
+    EnvelopeTables()
+    {
+        for (uint type = 0; type < numEnvelopeTypes; ++type)
+        {
+            float* table = values + type * Envelope::TABLE_STRIDE;
+            
+            for (uint k = 0; k <= Envelope::TABLE_SIZE; ++k)
+                table[2 * k] = (float)evaluateEnvelope(INT2ENUM(type, Envelope::Type), (double)k / Envelope::TABLE_SIZE);
+            
+            // a phase on x = 1 has no next point, its slope is zero
+            for (uint k = 0; k < Envelope::TABLE_SIZE; ++k) table[2 * k + 1] = table[2 * k + 2] - table[2 * k];
+            table[2 * Envelope::TABLE_SIZE + 1] = 0.f;
+        }
+    }
+    
+    float values[numEnvelopeTypes * Envelope::TABLE_STRIDE];
+};
+
+}
+
+
+const float* Envelope::getTables()
+{
+    static const EnvelopeTables tables;
+    return tables.values;
+}
+
+
+// =======================================================================================
+// MARK: - GRAIN CLOUD
+// =======================================================================================
+
+
+void GrainCloud::setup(SourceData* sourceData_)
+{
+    sourceData = sourceData_;
+    envelopeTables = Envelope::getTables();
+    
+    numActiveGrains = 0;
+    
+    // the vector loop reads (but doesn't use) the slots behind the last active grain,
+    // so all slots have to hold a valid state
+    for (uint n = 0; n < MAX_NUM_GRAINS; ++n)
+    {
+        readPointer[n] = increment[n] = glideIncrement[n] = 0.f;
+        phase[n] = phaseIncrement[n] = envelopeOffset[n] = 0;
+        amplitude[n] = 0.f;
+        panHomeChannel[n] = panNeighbourChannel[n] = 0.f;
+        lifeCounter[n] = 0;
+    }
+}
+
+
+bool GrainCloud::addGrain(GrainProperties* props_)
+{
+    if (numActiveGrains >= MAX_NUM_GRAINS) return false;
+    
+    uint n = numActiveGrains;
+    
     // set the increment the read pointer should move every other sample
-    incr = props_->pitchIncrement;
+    float incr = props_->pitchIncrement;
+    float glideIncr = 0.f;
     
     // calculate glide increment (the amount that is being added to the pitch increment
     // every other sample
@@ -418,9 +480,9 @@ GrainData::GrainData(SourceData* sourceData_, GrainProperties* props_)
     }
     
     // calculate read pointer position with initial delay
-    // first subtract the initial delay from the write pointer position
-    readPointer = sourceData->getWritePointer() - props_->initDelay;
-    if (readPointer < 0.f) readPointer += BUFFERSIZE;
+    // first subtract the initial delay from the newest sample, right behind the write pointer
+    float pointer = sourceData->getWritePointer() - 1 - props_->initDelay;
+    if (pointer < 0.f) pointer += BUFFERSIZE;
     
     // find out the highest pitchincrement (either the usual pitch increment or the goal where
     // to glide to
@@ -429,101 +491,228 @@ GrainData::GrainData(SourceData* sourceData_, GrainProperties* props_)
     // if pitch or pitchramp exceeds increment size 1.0, the initial delay must be increased
     // to avoid reading faster than writing
     // if we are in reverse mode, this is not necessary since we read into the past anyway
-    if (pitchRampMax > 1.f && !reverse)
+    if (pitchRampMax > 1.f && !props_->reverse)
     {
-        readPointer -= (pitchRampMax - 1.f) * props_->length;
-        if (readPointer < 0.f) readPointer += BUFFERSIZE;
+        pointer -= (pitchRampMax - 1.f) * props_->length;
+        if (pointer < 0.f) pointer += BUFFERSIZE;
     }
-}
-
-
-float GrainData::getNextData(const float envelope_)
-{
-    float data;
     
-    // get data from sourceData with linear interpolation
-    if (readPointer == (int)readPointer)
+    // reverse mode just decrements the read pointer instead of incrementing
+    float direction = props_->reverse ? -1.f : 1.f;
+    
+    readPointer[n] = pointer;
+    increment[n] = direction * incr;
+    glideIncrement[n] = direction * glideIncr;
+    
+    // the parabola starts one step in and ends on zero,
+    // the other shapes start and end on zero
+    // the increments are rounded down, so the phase never runs past the end of the table
+    if (props_->envelopeType == Envelope::Type::PARABOLIC)
     {
-        data = sourceData->get((uint)readPointer);
+        phaseIncrement[n] = Envelope::PHASE_ONE / (uint32_t)props_->length;
+        phase[n] = phaseIncrement[n];
     }
     else
     {
-        int lo = (int)readPointer;
-        int hi = (lo+1) >= BUFFERSIZE ? 0 : lo+1;
-        float frac = readPointer - (float)lo;
-        float loData = sourceData->get(lo);
-        data = loData + frac * (sourceData->get(hi) - loData);
+        phaseIncrement[n] = Envelope::PHASE_ONE / (uint32_t)(props_->length - 1);
+        phase[n] = 0;
     }
+    amplitude[n] = props_->envelopeAmplitude;
+    envelopeOffset[n] = ENUM2INT(props_->envelopeType) * Envelope::TABLE_STRIDE;
     
-    // non-reverse mode
-    if (!reverse)
-    {
-        readPointer += incr;
-        if (readPointer >= BUFFERSIZE) readPointer -= BUFFERSIZE;
+    panHomeChannel[n] = props_->panHomeChannel;
+    panNeighbourChannel[n] = props_->panNeighbourChannel;
+    
+    // set the life counter to the samplelength of the grain
+    lifeCounter[n] = props_->length;
+    
+    ++numActiveGrains;
+    
+    return true;
+}
+
+
+float32x2_t GrainCloud::processAudioSamples()
+{
+    static const uint32_t laneOffsets[4] = { 0, 1, 2, 3 };
+    
+    const float* buffer = sourceData->getBuffer();
+    
+    const float32x4_t zero = vdupq_n_f32(0.f);
+    const float32x4_t bufferSize = vdupq_n_f32((float)BUFFERSIZE);
+    const int32x4_t indexMask = vdupq_n_s32(BUFFERSIZE - 1);
+    const int32x4_t intOne = vdupq_n_s32(1);
+    const uint32x4_t numActive = vdupq_n_u32(numActiveGrains);
+    const uint32x4_t lanes = vld1q_u32(laneOffsets);
+    const uint32x4_t phaseFractionMask = vdupq_n_u32((1u << Envelope::PHASE_FRACTION_BITS) - 1);
+    const uint32x4_t phaseOne = vdupq_n_u32(Envelope::PHASE_ONE);
+    const float phaseFractionScale = 1.f / (float)(1u << Envelope::PHASE_FRACTION_BITS);
+    
+    float32x4_t homeSum = zero;
+    float32x4_t neighbourSum = zero;
+    uint32x4_t deadGrains = vdupq_n_u32(0);
+    
+    // iterate through all active grains, four at a time
+    for (uint n = 0; n < numActiveGrains; n += 4)
+    {
+        // lanes behind the last active grain (free slots)
+        // must neither sound nor advance
+        uint32x4_t active = vcltq_u32(vaddq_u32(lanes, vdupq_n_u32(n)), numActive);
+        
+        // get data from sourceData with linear interpolation
+        // NEON has no gather load, so the eight source samples are loaded lane by lane
+        float32x4_t pointer = vld1q_f32(readPointer + n);
+        int32x4_t index = vcvtq_s32_f32(pointer);
+        float32x4_t frac = vsubq_f32(pointer, vcvtq_f32_s32(index));
+        
+        int32_t lo[4], hi[4];
+        vst1q_s32(lo, vandq_s32(index, indexMask));
+        vst1q_s32(hi, vandq_s32(vaddq_s32(index, intOne), indexMask));
+        
+        float32x4_t loData = zero, hiData = zero;
+        loData = vld1q_lane_f32(buffer + lo[0], loData, 0);
+        loData = vld1q_lane_f32(buffer + lo[1], loData, 1);
+        loData = vld1q_lane_f32(buffer + lo[2], loData, 2);
+        loData = vld1q_lane_f32(buffer + lo[3], loData, 3);
+        hiData = vld1q_lane_f32(buffer + hi[0], hiData, 0);
+        hiData = vld1q_lane_f32(buffer + hi[1], hiData, 1);
+        hiData = vld1q_lane_f32(buffer + hi[2], hiData, 2);
+        hiData = vld1q_lane_f32(buffer + hi[3], hiData, 3);
+        
+        float32x4_t sample = vmlaq_f32(loData, frac, vsubq_f32(hiData, loData));
+        
+        // read the envelope of each grain from the table of its shape, the upper bits
+        // of the fixed-point phase are the index, the lower bits the fraction
+        uint32x4_t x = vld1q_u32(phase + n);
+        
+        // a grain steps beyond PHASE_ONE on its last sample, a free slot keeps that phase
+        // and its masked lane is still gathered, so the index must not pass the end point
+        uint32x4_t tableX = vminq_u32(x, phaseOne);
+        float32x4_t envelopeFrac = vcvtq_f32_s32(vreinterpretq_s32_u32(vandq_u32(tableX, phaseFractionMask)));
+        envelopeFrac = vmulq_n_f32(envelopeFrac, phaseFractionScale);
+        
+        uint32x4_t pointIndex = vshlq_n_u32(vshrq_n_u32(tableX, Envelope::PHASE_FRACTION_BITS), 1);
+        uint32_t envelopeIndex[4];
+        vst1q_u32(envelopeIndex, vaddq_u32(pointIndex, vld1q_u32(envelopeOffset + n)));
+        
+        // one pair of value and slope per grain
+        float32x4x2_t points = vuzpq_f32(vcombine_f32(vld1_f32(envelopeTables + envelopeIndex[0]), vld1_f32(envelopeTables + envelopeIndex[1])),
+                                         vcombine_f32(vld1_f32(envelopeTables + envelopeIndex[2]), vld1_f32(envelopeTables + envelopeIndex[3])));
+        
+        float32x4_t envelope = vmlaq_f32(points.val[0], envelopeFrac, points.val[1]);
+        envelope = vmulq_f32(envelope, vld1q_f32(amplitude + n));
+        
+        // return the evaluated data multiplied with the envelope amplitude
+        sample = vbslq_f32(active, vmulq_f32(sample, envelope), zero);
+        
+        // spatialize it
+        homeSum = vmlaq_f32(homeSum, vld1q_f32(panHomeChannel + n), sample);
+        neighbourSum = vmlaq_f32(neighbourSum, vld1q_f32(panNeighbourChannel + n), sample);
+        
+        // move the read pointers and wrap them around in both directions
+        float32x4_t incr = vld1q_f32(increment + n);
+        float32x4_t nextPointer = vaddq_f32(pointer, incr);
+        nextPointer = vsubq_f32(nextPointer, vbslq_f32(vcgeq_f32(nextPointer, bufferSize), bufferSize, zero));
+        nextPointer = vaddq_f32(nextPointer, vbslq_f32(vcltq_f32(nextPointer, zero), bufferSize, zero));
+        vst1q_f32(readPointer + n, vbslq_f32(active, nextPointer, pointer));
+        
+        // add the increment of gliding to the pitch increment
+        float32x4_t nextIncr = vaddq_f32(incr, vld1q_f32(glideIncrement + n));
+        vst1q_f32(increment + n, vbslq_f32(active, nextIncr, incr));
+        
+        uint32x4_t nextPhase = vaddq_u32(x, vld1q_u32(phaseIncrement + n));
+        vst1q_u32(phase + n, vbslq_u32(active, nextPhase, x));
+        
+        // decrement life counter and remember if a grain died
+        int32x4_t life = vld1q_s32(lifeCounter + n);
+        int32x4_t nextLife = vsubq_s32(life, intOne);
+        deadGrains = vorrq_u32(deadGrains, vandq_u32(active, vceqq_s32(nextLife, vdupq_n_s32(0))));
+        vst1q_s32(lifeCounter + n, vbslq_s32(active, nextLife, life));
     }
-    // reverse mode (just decrement the read pointer instead of incrementing)
-    else
+    
+    // recycle dead grains
+    uint32x2_t dead = vorr_u32(vget_low_u32(deadGrains), vget_high_u32(deadGrains));
+    if (vget_lane_u32(dead, 0) | vget_lane_u32(dead, 1))
     {
-        readPointer -= incr;
-        if (readPointer < 0.f) readPointer += BUFFERSIZE;
+        uint n = 0;
+        while (n < numActiveGrains)
+        {
+            if (lifeCounter[n] <= 0) removeGrain(n);
+            else ++n;
+        }
     }
     
-    // add the increment of gliding to the pitch increment
-    // if glide Ramp is 1 -> glide Increment is 0.f -> nothing happens here
-    incr += glideIncr;
+    // sum the lanes, home channel in lane 0, neighbour channel in lane 1
+    float32x2_t home = vadd_f32(vget_low_f32(homeSum), vget_high_f32(homeSum));
+    float32x2_t neighbour = vadd_f32(vget_low_f32(neighbourSum), vget_high_f32(neighbourSum));
     
-    // return the evaluated data multiplied with the given envelope amplitude
-    return data * envelope_;
+    return vpadd_f32(home, neighbour);
+}
+
+
+void GrainCloud::removeGrain(const uint index_)
+{
+    uint lastActive = numActiveGrains - 1;
+    
+    // move the last active grain into the dead grain's slot
+    moveGrain(lastActive, index_);
+    
+    --numActiveGrains;
+}
+
+
+void GrainCloud::moveGrain(const uint from_, const uint to_)
+{
+    if (from_ == to_) return;
+    
+    readPointer[to_] = readPointer[from_];
+    increment[to_] = increment[from_];
+    glideIncrement[to_] = glideIncrement[from_];
+    phase[to_] = phase[from_];
+    phaseIncrement[to_] = phaseIncrement[from_];
+    envelopeOffset[to_] = envelopeOffset[from_];
+    amplitude[to_] = amplitude[from_];
+    panHomeChannel[to_] = panHomeChannel[from_];
+    panNeighbourChannel[to_] = panNeighbourChannel[from_];
+    lifeCounter[to_] = lifeCounter[from_];
 }
 
 
 // =======================================================================================
-// MARK: - GRAIN
+// MARK: - GRAIN SCHEDULER
 // =======================================================================================
 
 
-Grain::Grain(GrainProperties* props_, SourceData* sourceData_)
-    : panHomeChannel(props_->panHomeChannel)
-    , panNeighbourChannel(props_->panNeighbourChannel)
+void GrainScheduler::setup(GrainPropertiesManager* manager_, GrainCloud* grainClouds_)
 {
-    // create a new data-set object
-    data = new GrainData(sourceData_, props_);
+    manager = manager_;
+    grainClouds = grainClouds_;
     
-    // create an envelope object
-    switch (props_->envelopeType)
-    {
-        case Envelope::Type::PARABOLIC:
-            envelope = new ParabolicEnvelope(props_->length, props_->envelopeAmplitude);
-            break;
-        case Envelope::Type::HANN:
-            envelope = new HannEnvelope(props_->length, props_->envelopeAmplitude);
-            break;
-        case Envelope::Type::TRIANGULAR:
-            envelope = new TriangularEnvelope(props_->length, props_->envelopeAmplitude);
-            break;
-    }
-    
-    // set the life counter to the samplelength of the grain
-    lifeCounter = props_->length;
-    // this grain is just born
-    isAlive = true;
+    for (uint ch = 0; ch < 2; ++ch) onsetCounter[ch] = manager->getNextInterOnset();
+}
+
+
+void GrainScheduler::limitOnsets(const uint interOnset_)
+{
+    for (uint ch = 0; ch < 2; ++ch)
+        if (onsetCounter[ch] > interOnset_) onsetCounter[ch] = interOnset_;
 }
 
 
-Grain::~Grain()
+void GrainScheduler::alignOnsets()
 {
-    delete envelope;
-    delete data;
+    if (onsetCounter[0] > onsetCounter[1]) onsetCounter[1] = onsetCounter[0];
+    else onsetCounter[0] = onsetCounter[1];
 }
 
 
-float Grain::getNextSample()
+void GrainScheduler::startGrain(const uint channel_)
 {
-    // decrement life counter and set flag correspondingly
-    if (--lifeCounter == 0) isAlive = false;
+    // get and save the next interonset time (may be randomized)
+    onsetCounter[channel_] = manager->getNextInterOnset();
     
-    // return the next grain sample (data * envelope)
-    return data->getNextData(envelope->getNextAmplitude());
+    // the properties are drawn at the onset, the grain reads from the newest sample on
+    grainClouds[channel_].addGrain(manager->getNextGrainProperties());
 }
 
 
@@ -537,47 +726,39 @@ bool Granulator::setup(const float sampleRate_, const uint blockSize_)
     sampleRate = sampleRate_;
     blockSize = blockSize_;
     
-    // this has to be checked, since the code only allows one new grain per block
-    // grains will be created blockwise in the update() function
-    if (blockSize > sampleRate / MAX_DENSITY) return false;
-    
     // setup the grain property manager
     manager.setup(sampleRate);
     
     // initialize all manager parameters
-    parameterChanged("granulator_grainlength", parameterInitialValue[(int)Parameters::GRAINLENGTH]);
-    parameterChanged("granulator_density", parameterInitialValue[(int)Parameters::DENSITY]);
-    parameterChanged("granulator_pitch", parameterInitialValue[(int)Parameters::PITCH]);
-    parameterChanged("granulator_glide", parameterInitialValue[(int)Parameters::GLIDE]);
-    parameterChanged("granulator_reverse", parameterInitialValue[(int)Parameters::REVERSE]);
-    parameterChanged("granulator_variation", parameterInitialValue[(int)Parameters::VARIATION]);
-    parameterChanged("granulator_envelopetype", parameterInitialValue[(int)Parameters::ENVELOPE_TYPE]);
-    parameterChanged("granulator_feedback", parameterInitialValue[(int)Parameters::FEEDBACK]);
-    
-    // reserve the necessary space in the grain cloud of each channel
-    grainCloud[LEFT].reserve(MAX_NUM_GRAINS);
-    grainCloud[RIGHT].reserve(MAX_NUM_GRAINS);
+    parameterChanged(Parameters::GRAINLENGTH, parameterInitialValue[(int)Parameters::GRAINLENGTH]);
+    parameterChanged(Parameters::DENSITY, parameterInitialValue[(int)Parameters::DENSITY]);
+    parameterChanged(Parameters::PITCH, parameterInitialValue[(int)Parameters::PITCH]);
+    parameterChanged(Parameters::GLIDE, parameterInitialValue[(int)Parameters::GLIDE]);
+    parameterChanged(Parameters::REVERSE, parameterInitialValue[(int)Parameters::REVERSE]);
+    parameterChanged(Parameters::VARIATION, parameterInitialValue[(int)Parameters::VARIATION]);
+    parameterChanged(Parameters::ENVELOPE_TYPE, parameterInitialValue[(int)Parameters::ENVELOPE_TYPE]);
+    parameterChanged(Parameters::FEEDBACK, parameterInitialValue[(int)Parameters::FEEDBACK]);
+    
+    // setup the grain clouds
+    for (uint ch = 0; ch < 2; ++ch) grainCloud[ch].setup(&data[ch]);
     
     // setup the delay object
     delay.setup(sampleRate);
     
     // initialize all delay parameters
-    parameterChanged("granulator_delay", parameterInitialValue[(int)Parameters::DELAY]);
-    parameterChanged("granulator_delayspeedratio", parameterInitialValue[(int)Parameters::DELAY_SPEED_RATIO]);
+    parameterChanged(Parameters::DELAY, parameterInitialValue[(int)Parameters::DELAY]);
+    parameterChanged(Parameters::DELAY_SPEED_RATIO, parameterInitialValue[(int)Parameters::DELAY_SPEED_RATIO]);
     
     // setup the filter object
     filter.setup(sampleRate);
     
     // initialize all filter parameters
-    parameterChanged("granulator_filtermodel", parameterInitialValue[(int)Parameters::FILTER_MODEL]);
-    parameterChanged("granulator_highcut", parameterInitialValue[(int)Parameters::HIGHCUT]);
-    parameterChanged("granulator_filterresonance", parameterInitialValue[(int)Parameters::FILTER_RESONANCE]);
+    parameterChanged(Parameters::FILTER_MODEL, parameterInitialValue[(int)Parameters::FILTER_MODEL]);
+    parameterChanged(Parameters::HIGHCUT, parameterInitialValue[(int)Parameters::HIGHCUT]);
+    parameterChanged(Parameters::FILTER_RESONANCE, parameterInitialValue[(int)Parameters::FILTER_RESONANCE]);
     
-    for (uint ch = 0; ch < 2; ++ch)
-    {
-        nextInterOnset[ch] = manager.getNextInterOnset();
-        onsetCounter[ch] = nextInterOnset[ch];
-    }
+    // the grains start inside the audio callback, at their exact onsets
+    scheduler.setup(&manager, grainCloud);
     
     feedbackHighpass.setup(80.f, sampleRate);
     
@@ -585,35 +766,6 @@ bool Granulator::setup(const float sampleRate_, const uint blockSize_)
 }
 
 
-void Granulator::update()
-{
-    // add new grain to graincloud if needed
-    // iterate through the channels
-    for (unsigned int ch = 0; ch < 2; ++ch)
-    {
-        // if the onset counter will reach zero in the next sample block
-        if (onsetCounter[ch] <= blockSize)
-        {
-            // get and save the next interonset time (may be randomized)
-            nextInterOnset[ch] = manager.getNextInterOnset();
-            
-            // if there's still a free slot in the grain vector
-            if (grainCloud[ch].size() < grainCloud[ch].capacity())
-            {
-                //create a new grain
-                grainCloud[ch].push_back(new Grain(manager.getNextGrainProperties(), &data[ch]));
-                
-                // since the new grain shouldn't be processed yet, we store the number of active grains
-                // in a separate variable
-                // size of grain cloud should never be zero here, but safety first
-                if (grainCloud[ch].size() == 0) numActiveGrains[ch] = 0;
-                else numActiveGrains[ch] = grainCloud[ch].size() - 1;
-            }
-        }
-    }
-}
-
-
 float32x2_t Granulator::processAudioSamples(const float32x2_t input_, const uint sampleIndex_)
 {
     StereoFloat output = { 0.f, 0.f };
@@ -630,47 +782,13 @@ float32x2_t Granulator::processAudioSamples(const float32x2_t input_, const uint
         }
         
         // counting to next onset of grain
-        // if reached, the pre-added grain (see update() function)
-        // will be included in the sum-calculation of all grains
-        if (--onsetCounter[ch] == 0)
-        {
-            onsetCounter[ch] = nextInterOnset[ch];
-            numActiveGrains[ch] = grainCloud[ch].size();
-        }
-    
-        // sum all active grains and spatialize them
-        // if a grain looses life, its index will be safed for reordering the graincloud-vector later on
-        std::vector<int> deadGrainIndex;
-    
-        // channel indexes used for panning later on
-        uint homeChannel = ch;
-        uint neighbourChannel = (ch == LEFT) ? RIGHT : LEFT;
+        // if reached, the new grain is included in the sum of this sample
+        scheduler.processSample(ch);
         
-        // iterate through all active grains in the cloud
-        for (uint n = 0; n < numActiveGrains[ch]; ++n)
-        {
-            // get the next processed grain sample
-            float grain = grainCloud[ch].at(n)->getNextSample();
-
-            // spatialize it
-            output[homeChannel] += grainCloud[ch].at(n)->getHomeChannelPanning() * grain;
-            output[neighbourChannel] += grainCloud[ch].at(n)->getNeighbourChannelPanning() * grain;
-            
-            // if it looses life, delete the pointer and safe its index
-            if (!grainCloud[ch].at(n)->isAlive)
-            {
-                delete grainCloud[ch].at(n);
-                grainCloud[ch].at(n) = nullptr;
-                deadGrainIndex.push_back(n);
-            }
-        }
-        
-        // erasing empty space in graincloud vector
-        for (uint n = 0; n < deadGrainIndex.size(); ++n)
-        {
-            grainCloud[ch].erase(grainCloud[ch].begin() + deadGrainIndex.at(n) - n);
-            --numActiveGrains[ch];
-        }
+        // sum all active grains and spatialize them
+        float32x2_t grains = grainCloud[ch].processAudioSamples();
+        output[ch] += vget_lane_f32(grains, 0);
+        output[(ch == LEFT) ? RIGHT : LEFT] += vget_lane_f32(grains, 1);
     }
     
     // write the channel outputs into a stereo neon vector
@@ -697,131 +815,169 @@ float32x2_t Granulator::processAudioSamples(const float32x2_t input_, const uint
     float maxOutput = (absOutput[LEFT] >= absOutput[RIGHT]) ? absOutput[LEFT] : absOutput[RIGHT];
     dynamicFeedback = (maxOutput >= 1.f) ? 0.f : feedback * (1.f - maxOutput);
     
-    // saturate the output signal
-    output[LEFT] = approximateTanh(output[LEFT]);
-    output[RIGHT] = approximateTanh(output[RIGHT]);
+    // saturate the output signal, both channels at once
+    output_simd = approximateTanh(output_simd);
+    output[LEFT] = vget_lane_f32(output_simd, 0);
+    output[RIGHT] = vget_lane_f32(output_simd, 1);
     
     previousOutput = feedbackHighpass.process(output);
     
     // return processed wet output + dry input
-    return { output[LEFT], output[RIGHT] };
+    return makeStereo(output[LEFT], output[RIGHT]);
+}
+
+
+void Granulator::processAudioBlock(const float* const input_[2], float* const output_[2], const uint numFrames_)
+{
+    for (uint n = 0; n < numFrames_; ++n)
+    {
+        float32x2_t output = processAudioSamples(makeStereo(input_[LEFT][n], input_[RIGHT][n]), n);
+        
+        output_[LEFT][n] = vget_lane_f32(output, 0);
+        output_[RIGHT][n] = vget_lane_f32(output, 1);
+    }
 }
 
 
 void Granulator::resetPhase()
 {
-    for (uint ch = 0; ch < 2; ++ch) onsetCounter[ch] = 1;
+    scheduler.resetOnsets();
 }
 
 
-void Granulator::parameterChanged (const String parameterID, float newValue)
+void Granulator::parameterChanged(const Parameters parameter, float newValue)
 {
     bool parameterReceived = true;
     
-    if (parameterID == "granulator_grainlength")
-    {
-        int lengthSamples = (int)(newValue * sampleRate * 0.001f); // ms to samples
-        manager.setLength(lengthSamples);
-    }
-    else if (parameterID == "granulator_density")
+    switch (parameter)
     {
-        // set interonset time in samples
-        int interOnsetSamples = (int)(sampleRate / newValue); // frequency to samples
-        manager.setInterOnset(interOnsetSamples);
-        
-        // for a smooth transition from low densitys to higher once we shorten the counter
-        // if it is still higher than the new interonset time
-        // otherwise we'd have to wait for the previous interonset time to pass, afterwards the
-        // slider change would affect the audio
-        for (uint ch = 0; ch < 2; ++ch)
-            if (onsetCounter[ch] > interOnsetSamples) onsetCounter[ch] = interOnsetSamples;
-        
-        // set corresponding delay speed
-        float delayMs = (1000.f / newValue) * delaySpeedRatio;
-        delay.setDelayTimeRampInMs(delayMs);
-    }
-    else if (parameterID == "granulator_variation")
-    {
-        // Interonset Variation
-        manager.setInterOnsetVariation(0.01f * newValue);
-        
-        // GrainLength Variation
-        manager.setLengthVariation(0.01f * newValue);
-        
-        // Initial Delay Variation
-        manager.setInitDelayVariation(0.01f * newValue);
-        
-        // Spatialize
-        manager.setPanningVariation(0.01f * newValue);
-
-        // if we return to zero variation, onsetctr has to be resynced to restore mono
-        if (newValue == 0.f)
+        case Parameters::GRAINLENGTH:
         {
-            if (onsetCounter[0] > onsetCounter[1]) onsetCounter[1] = onsetCounter[0];
-            else onsetCounter[0] = onsetCounter[1];
+            int lengthSamples = (int)(newValue * sampleRate * 0.001f); // ms to samples
+            manager.setLength(lengthSamples);
+            break;
+        }
+            
+        case Parameters::DENSITY:
+        {
+            // set interonset time in samples
+            int interOnsetSamples = (int)(sampleRate / newValue); // frequency to samples
+            manager.setInterOnset(interOnsetSamples);
+            
+            // for a smooth transition from low densitys to higher once we shorten the counter
+            // if it is still higher than the new interonset time
+            // otherwise we'd have to wait for the previous interonset time to pass, afterwards the
+            // slider change would affect the audio
+            scheduler.limitOnsets(interOnsetSamples);
+            
+            // set corresponding delay speed
+            float delayMs = (1000.f / newValue) * delaySpeedRatio;
+            delay.setDelayTimeRampInMs(delayMs);
+            break;
+        }
+            
+        case Parameters::VARIATION:
+        {
+            // Interonset Variation
+            manager.setInterOnsetVariation(0.01f * newValue);
+            
+            // GrainLength Variation
+            manager.setLengthVariation(0.01f * newValue);
+            
+            // Initial Delay Variation
+            manager.setInitDelayVariation(0.01f * newValue);
+            
+            // Spatialize
+            manager.setPanningVariation(0.01f * newValue);
+            
+            // if we return to zero variation, onsetctr has to be resynced to restore mono
+            if (newValue == 0.f) scheduler.alignOnsets();
+            break;
+        }
+            
+        case Parameters::PITCH:
+        {
+            float incr = powf(2.f, (newValue / 12.f)); // semitones to increment
+            manager.setPitchIncrement(incr);
+            break;
+        }
+            
+        case Parameters::GLIDE:
+        {
+            float glidegoal = powf(2.f, newValue); // octave to increment
+            manager.setGlideAmount(glidegoal);
+            break;
+        }
+            
+        case Parameters::DELAY:
+        {
+            float delayFeedback = mapValue(newValue, 0.f, 100.f, 0.f, 0.907f); // percent to feedback gain
+            delay.setFeedback(delayFeedback);
+            
+            delayWet = newValue * 0.01f * 0.6f;
+            delayDry = 1.f - delayWet;
+            break;
+        }
+            
+        case Parameters::HIGHCUT:
+        {
+            filter.setCutoffFrequency(newValue);
+            break;
+        }
+            
+        case Parameters::REVERSE:
+        {
+            manager.setReverse(newValue);
+            break;
+        }
+            
+        case Parameters::DELAY_SPEED_RATIO:
+        {
+            delaySpeedRatio = 1.f / (newValue + 1);
+            
+            uint delaySamples = (uint)(manager.getInterOnset() * delaySpeedRatio);
+            float delayMs = delaySamples / (sampleRate * 0.001f);
+            delay.setDelayTimeRampInMs(delayMs);
+            break;
+        }
+            
+        case Parameters::FILTER_RESONANCE:
+        {
+            filter.setResonance(newValue * 0.01f);
+            break;
+        }
+            
+        case Parameters::FILTER_MODEL:
+        {
+            FilterStereo::Model model = newValue == 0 ? FilterStereo::MOOGLADDER : FilterStereo::MOOGHALFLADDER;
+            filter.setFilterModel(model);
+            break;
+        }
+            
+        case Parameters::ENVELOPE_TYPE:
+        {
+            Envelope::Type type = INT2ENUM(newValue, Envelope::Type);
+            manager.setEnvelopeType(type);
+            break;
+        }
+            
+        case Parameters::FEEDBACK:
+        {
+            feedback = newValue;
+            break;
+        }
+            
+        default:
+        {
+            parameterReceived = false;
+            break;
         }
-    }
-    else if (parameterID == "granulator_pitch")
-    {
-        float incr = powf(2.f, (newValue / 12.f)); // semitones to increment
-        manager.setPitchIncrement(incr);
-    }
-    else if (parameterID == "granulator_glide")
-    {
-        float glidegoal = powf(2.f, newValue); // octave to increment
-        manager.setGlideAmount(glidegoal);
-    }
-    else if (parameterID == "granulator_delay")
-    {
-        float delayFeedback = mapValue(newValue, 0.f, 100.f, 0.f, 0.907f); // percent to feedback gain
-        delay.setFeedback(delayFeedback);
-
-        delayWet = newValue * 0.01f * 0.6f;
-        delayDry = 1.f - delayWet;
-    }
-    else if (parameterID == "granulator_highcut")
-    {
-        filter.setCutoffFrequency(newValue);
-    }
-    else if (parameterID == "granulator_reverse")
-    {
-        manager.setReverse(newValue);
-    }
-    else if (parameterID == "granulator_delayspeedratio")
-    {
-        delaySpeedRatio = 1.f / (newValue + 1);
-        
-        uint delaySamples = (uint)(manager.getInterOnset() * delaySpeedRatio);
-        float delayMs = delaySamples / (sampleRate * 0.001f);
-        delay.setDelayTimeRampInMs(delayMs);
-    }
-    else if (parameterID == "granulator_filterresonance")
-    {
-        filter.setResonance(newValue * 0.01f);
-    }
-    else if (parameterID == "granulator_filtermodel")
-    {
-        FilterStereo::Model model = newValue == 0 ? FilterStereo::MOOGLADDER : FilterStereo::MOOGHALFLADDER;
-        filter.setFilterModel(model);
-    }
-    else if (parameterID == "granulator_envelopetype")
-    {
-        Envelope::Type type = INT2ENUM(newValue, Envelope::Type);
-        manager.setEnvelopeType(type);
-    }
-    else if (parameterID == "granulator_feedback")
-    {
-        feedback = newValue;
-    }
-    else
-    {
-        parameterReceived = false;
     }
     
     if (parameterReceived)
     {
         #ifdef CONSOLE_PRINT
-        consoleprint("Granulator received new Value for Paramaeter: " + parameterID + " = " + TOSTRING(newValue),
+        consoleprint("Granulator received new Value for Paramaeter: " + parameterID[(int)parameter] + " = " + TOSTRING(newValue),
                      __FILE__, __LINE__);
         #endif
     }
@@ -15,6 +15,7 @@
 #pragma once
 
 #include "../Helpers.hpp"
+#include "../Random.hpp"
 
 /**
  * @defgroup GranulatorParameters
@@ -29,14 +30,17 @@ static const float MIN_GRAINLENGTH_MS = 7.f;
 static const float MAX_GRAINLENGTH_MS = 70.f;
 
 static const float MIN_DENSITY = 1.f;
-static const float MAX_DENSITY = 85.f;
+// the onsets are sample accurate, the density is only bounded by the CPU cost of the overlapping grains:
+// at the longest grains 28 grains per channel overlap, well below MAX_NUM_GRAINS
+static const float MAX_DENSITY = 400.f;
 
 static const float MIN_CUTOFF = 120.f;
 static const float MAX_CUTOFF = 20000.f;
 
 static const int BUFFERSIZE = 65536;
 
-static const int MAX_NUM_GRAINS = 100;
+static const int MAX_NUM_GRAINS = 128;
+static_assert(MAX_NUM_GRAINS % 4 == 0, "the grain cloud processes four grains per NEON vector");
 
 static const float32_t GAIN_COMPENSATION = 1.22f;
 
@@ -48,11 +52,14 @@ static const std::string delaySpeedRatios[numDelaySpeedRatios] {
     "1 : 4"
 };
 
-static const size_t numEnvelopeTypes = 3;
+static const size_t numEnvelopeTypes = 6;
 static const std::string envelopeTypeNames[numEnvelopeTypes] {
     "Parabolic",
     "Hann",
-    "Triangular"
+    "Triangular",
+    "Tukey",
+    "Gaussian",
+    "Decay"
 };
 
 /** @brief the number of user definable parameters */
@@ -697,6 +704,13 @@ public:
      */
     float get(const uint pos_) const { return buffer.at(pos_); }
     
+    /**
+     * @brief Returns a pointer to the raw buffer, used for the gathered reads of the grain cloud.
+     *
+     * @return Pointer to the first of BUFFERSIZE values.
+     */
+    const float* getBuffer() const { return buffer.data(); }
+    
     /**
      * @brief Gets the current position of the write pointer.
      *
@@ -719,111 +733,36 @@ private:
 
 
 /**
- * @class Envelope
- * @brief A base class representing an amplitude envelope for grains.
+ * @namespace Envelope
+ * @brief The amplitude envelope shapes available for the grains.
  *
- * The `Envelope` class provides the interface and basic structure for an envelope
- * that controls the amplitude of grains over time. Derived classes must implement
- * the `getNextAmplitude()` method to calculate the next amplitude value.
+ * Every shape is sampled once into a table of TABLE_SIZE intervals over the normalized grain phase x = 0...1.
+ * `GrainCloud::processAudioSamples()` reads the tables with a fixed-point phase and linear interpolation, so
+ * all shapes cost the same per sample. Every point is stored with the slope to the next one, one 64 bit
+ * load per grain fetches both:
+ * - parabolic: 4x(1-x)
+ * - hann: 0.5(1-cos(2 PI x))
+ * - triangular: 1-|2x-1|
+ * - tukey: flat top, hann tapers over the first and last quarter
+ * - gaussian: exp(-0.5((x-0.5)/0.15)^2), offset and scaled to start and end on zero
+ * - decay: hann attack over the first 5 %, then an exponential decay to zero
  */
-class Envelope
+namespace Envelope
 {
-public:
-    enum class Type { PARABOLIC, HANN, TRIANGULAR };
-    
-    /**
-     * @brief Constructor for the Envelope class.
-     *
-     * Initializes the envelope with the given duration and grain amplitude.
-     *
-     * @param durationSamples_ The total duration of the envelope in samples.
-     * @param grainAmplitude_ The amplitude of the grain.
-     */
-    Envelope(const uint durationSamples_, const float grainAmplitude_)
-    : grainAmplitude(grainAmplitude_)
-    , durationSamples(durationSamples_)
-    {}
-    
-    /**
-     * @brief Virtual destructor.
-     */
-    virtual ~Envelope() {}
+    enum class Type { PARABOLIC, HANN, TRIANGULAR, TUKEY, GAUSSIAN, DECAY };
     
-    /**
-     * @brief Pure virtual function to get the next amplitude value.
-     *
-     * This function must be implemented by derived classes to provide
-     * the next amplitude value in the envelope's sequence.
-     *
-     * @return The next amplitude value.
-     */
-    virtual float getNextAmplitude() = 0;
-    
-protected:
-    float nextAmplitude = 0.f;          ///< The next amplitude value in the envelope.
-    const float grainAmplitude;         ///< The amplitude of the grain.
-    const uint durationSamples;         ///< The total duration of the envelope in samples.
-};
-
-/**
- * @class ParabolicEnvelope
- * @brief A derived class implementing a parabolic amplitude envelope.
- *
- * The `ParabolicEnvelope` class calculates amplitude values based on a parabolic curve.
- */
-class ParabolicEnvelope : public Envelope
-{
-public:
-    /**
-     * @brief Constructor for the ParabolicEnvelope class.
-     *
-     * Initializes the parabolic envelope with the given duration and grain amplitude.
-     *
-     * @param durationSamples_ The total duration of the envelope in samples.
-     * @param grainAmplitude_ The amplitude of the grain.
-     */
-    ParabolicEnvelope(const uint durationSamples_, const float grainAmplitude_);
+    static const uint TABLE_SIZE = 1024;  ///< Number of intervals of a table.
+    static const uint TABLE_STRIDE = 2 * (TABLE_SIZE + 1);  ///< Distance of the tables, pairs of value and slope up to the end point.
+    static const uint PHASE_FRACTION_BITS = 20;  ///< The bits of a phase below the table index.
+    static const uint32_t PHASE_ONE = TABLE_SIZE << PHASE_FRACTION_BITS;  ///< The fixed-point phase of x = 1.
     
     /**
-     * @brief Calculates and returns the next amplitude value based on a parabolic curve.
+     * @brief Returns the tables of all shapes, one after another in the order of `Type`.
      *
-     * This function overrides the base class method to implement the parabolic
-     * amplitude calculation.
-     *
-     * @return The next amplitude value.
+     * They are built on the first call, which must not happen on the audio thread.
      */
-    float getNextAmplitude() override;
-    
-private:
-    float slope;                        ///< The slope value used for the parabolic calculation.
-    float curve;                        ///< The curvature value of the parabolic envelope.
-};
-
-
-class HannEnvelope : public Envelope
-{
-public:
-    HannEnvelope(const uint durationSamples_, const float grainAmplitude_);
-    
-    float getNextAmplitude() override;
-    
-private:
-    uint phase = 0;
-    float invMaxPhase = 0;
-};
-
-
-class TriangularEnvelope : public Envelope
-{
-public:
-    TriangularEnvelope(const uint durationSamples_, const float grainAmplitude_);
-    
-    float getNextAmplitude() override;
-    
-private:
-    uint phase = 0;
-    float invMaxPhase = 0;
-};
+    const float* getTables();
+}
 
 
 // =======================================================================================
@@ -916,7 +855,7 @@ public:
      * will be called when a new grain is born. This function calculates new random
      * values for Initial Delay, Grainlength and Panning, and defines an overall amplitude
      * for the envelope. Then it saves those variables to the `GrainProperties` struct.
-     * The `Grain` object will copy those parameters.
+     * The `GrainCloud` will copy those parameters.
      *
      * @param length_ The center length of the grain in samples.
      */
@@ -992,8 +931,16 @@ public:
      */
     const uint getInterOnset() const { return interOnsetCenter; }
     
+    /**
+     * @brief Restarts the sequence of the random grain properties.
+     *
+     * @param seed_ The seed, see `RandomGenerator::setSeed()`.
+     */
+    void setRandomSeed(const uint32_t seed_) { random.setSeed(seed_); }
+    
 private:
     GrainProperties props;                  ///< The properties of the current grain.
+    RandomGenerator random;                 ///< Draws the inter-onsets, initial delays, lengths and panning of the grains.
     
     int interOnsetCenter = 4410;            ///< Center value for the inter-onset interval in samples.
     int interOnsetRange = 0;                ///< Range of variation for the inter-onset interval.
@@ -1013,133 +960,148 @@ private:
 
 
 // =======================================================================================
-// MARK: - GRAIN DATA
+// MARK: - GRAIN CLOUD
 // =======================================================================================
 
 
 /**
- * @class GrainData
- * @brief Manages data and behavior for an individual grain during granular synthesis.
+ * @class GrainCloud
+ * @brief Renders all grains of one channel, four grains per NEON instruction.
+ *
+ * The state of every grain (read pointer, pitch and glide increment, envelope phase,
+ * amplitude, panning and remaining life) is stored in parallel arrays (structure of arrays),
+ * so that the inner loop can load, advance and store four grains at once. The source data and
+ * the envelope tables are read with a gathered linear interpolation.
  *
- * The `GrainData` class interacts with a `SourceData` object and modifies its behavior
- * based on grain properties such as pitch increment, glide, and reverse playback.
+ * The arrays are a fixed-capacity pool: [0, numActiveGrains) holds the audible grains. Dead grains are
+ * removed by moving the last grain into their position, so the audio thread never touches the allocator.
  */
-class GrainData
+class GrainCloud
 {
 public:
     /**
-     * @brief Constructor for the GrainData class.
+     * @brief Sets up the grain cloud and binds it to the source data of its channel.
      *
-     * Initializes the `GrainData` object with a source of data and grain properties.
-     * copys necessary parameters from the `GrainProperties` object to member variables
-     * calculates pitch and glide increment, and sets the read pointer accordingly
-     * (higher pitches require the pointer to be further back in the past, since the pitch increment
-     * moves faster forward)
-     *
-     * @param sourceData_ Pointer to the `SourceData` object that provides the source data.
-     * @param props_ Pointer to the `GrainProperties` object that defines the properties of the grain.
+     * @param sourceData_ Pointer to the `SourceData` object that provides the data for the grains.
      */
-    GrainData(SourceData* sourceData_, GrainProperties* props_);
+    void setup(SourceData* sourceData_);
     
     /**
-     * @brief Retrieves the next data value from the source, modified by the envelope.
+     * @brief Adds a new grain with the specified properties to the cloud.
      *
-     * reads new sample from `SourceData` with linear interpolation
-     * increments or decrements the pointer depending on the reverse flag
-     * increments the pitch increment with the glide increment
+     * The grain sounds from the next call of `processAudioSamples()` on. It starts reading the source data
+     * `initDelay` samples behind the newest written sample.
      *
-     * @param envelope_ The current envelope value that shapes the grain's amplitude.
-     * @return The next data value from the source.
+     * @param props_ Pointer to the `GrainProperties` object that defines the grain's properties.
+     * @return False if there's no free slot left.
+     */
+    bool addGrain(GrainProperties* props_);
+    
+    /**
+     * @brief Processes the next sample of all active grains.
+     *
+     * @return The sum of all grains panned to the home channel (lane 0) and to the neighbour channel (lane 1).
+     */
+    float32x2_t processAudioSamples();
+    
+    /**
+     * @brief Returns the number of grains that are currently audible.
      */
-    float getNextData(const float envelope_);
+    uint getNumActiveGrains() const { return numActiveGrains; }
     
 private:
+    /**
+     * @brief Removes the grain at the given index by moving the last active grain into its slot.
+     */
+    void removeGrain(const uint index_);
+    
+    /**
+     * @brief Copies the state of one grain slot to another.
+     */
+    void moveGrain(const uint from_, const uint to_);
+    
     SourceData* sourceData = nullptr;   ///< Pointer to the source data object.
-    float incr = 1.f;                   ///< Increment value for reading data, related to pitch.
-    float glideIncr = 0.f;              ///< Increment value for pitch glide.
-    float readPointer = 0;              ///< Current read position in the source data.
-    const bool reverse;                 ///< Flag indicating whether the grain is played in reverse.
+    const float* envelopeTables = nullptr; ///< The tables of all envelope shapes, see `Envelope::getTables()`.
+    
+    alignas(16) float readPointer[MAX_NUM_GRAINS];       ///< Current read positions in the source data.
+    alignas(16) float increment[MAX_NUM_GRAINS];         ///< Read pointer increments related to pitch, negative in reverse mode.
+    alignas(16) float glideIncrement[MAX_NUM_GRAINS];    ///< Amounts added to the increments every sample, negative in reverse mode.
+    alignas(16) uint32_t phase[MAX_NUM_GRAINS];          ///< Fixed-point envelope phases (0...Envelope::PHASE_ONE).
+    alignas(16) uint32_t phaseIncrement[MAX_NUM_GRAINS]; ///< Fixed-point envelope phase increments.
+    alignas(16) uint32_t envelopeOffset[MAX_NUM_GRAINS]; ///< Start of the envelope table of the grain's shape.
+    alignas(16) float amplitude[MAX_NUM_GRAINS];         ///< Envelope amplitudes.
+    alignas(16) float panHomeChannel[MAX_NUM_GRAINS];    ///< Panning values for the home channel (range: 0.0 to 1.0).
+    alignas(16) float panNeighbourChannel[MAX_NUM_GRAINS]; ///< Panning values for the neighbouring channel (range: 0.0 to 1.0).
+    alignas(16) int32_t lifeCounter[MAX_NUM_GRAINS];     ///< Remaining life of the grains in samples.
+    
+    uint numActiveGrains = 0;           ///< Number of audible grains.
 };
 
 
 // =======================================================================================
-// MARK: - GRAIN
+// MARK: - GRAIN SCHEDULER
 // =======================================================================================
 
 
 /**
- * @class Grain
- * @brief Represents an individual grain in granular synthesis.
+ * @class GrainScheduler
+ * @brief Starts the grains of both channels at their exact onsets, inside the audio callback.
  *
- * The `Grain` class handles the lifecycle of a grain, including its envelope and data retrieval.
- * Each grain uses a `GrainProperties` object to define its behavior and interacts with
- * a `SourceData` object to produce audio samples.
+ * Every channel counts down the samples to its next onset. When the counter runs out, a grain with the
+ * properties of that moment is added to the channel's cloud and sounds from the same sample on, then the counter
+ * is reloaded with the next inter-onset. Nothing depends on the block size, and any number of grains can start
+ * within one block.
  */
-class Grain
+class GrainScheduler
 {
 public:
     /**
-     * @brief Constructs a `Grain` object with the specified properties and source data.
+     * @brief Binds the scheduler to the grain properties and the clouds and draws the first onsets.
      *
-     * This constructor initializes a new grain with the provided properties and creates
-     * both the `GrainData` and envelope objects. It also sets the grain's lifetime and marks
-     * it as alive.
-     *
-     * @param props_ Pointer to the `GrainProperties` object that defines the grain's properties.
-     * @param sourceData_ Pointer to the `SourceData` object that provides the data for the grain.
+     * @param manager_ The manager that draws the inter-onsets and the properties of the grains.
+     * @param grainClouds_ The clouds of the left and the right channel.
      */
-    Grain(GrainProperties* props_, SourceData* sourceData_);
+    void setup(GrainPropertiesManager* manager_, GrainCloud* grainClouds_);
     
     /**
-     * @brief Deleted default constructor.
+     * @brief Advances the onset of a channel by one sample and starts its grain if it is due.
      *
-     * This constructor is deleted to ensure that grains must be created with properties
-     * and source data.
-     */
-    Grain() = delete;
-    
-    /**
-     * @brief Destructor for the `Grain` class.
+     * Call it after the input sample of the channel is written and before its cloud processes the sample.
      *
-     * Cleans up allocated `GrainData` and envelope objects.
+     * @param channel_ The channel, 0 (left) or 1 (right).
      */
-    ~Grain();
+    void processSample(const uint channel_)
+    {
+        if (--onsetCounter[channel_] == 0) startGrain(channel_);
+    }
     
     /**
-     * @brief Retrieves the next sample for the grain.
-     *
-     * This function fetches the next audio sample for the grain by multiplying the
-     * data and the envelope values. It also decrements the life counter and marks the
-     * grain as no longer alive if its lifetime has expired.
+     * @brief Brings the next onsets forward, so they are at most one inter-onset away.
      *
-     * @return The next audio sample for the grain.
+     * @param interOnset_ The new inter-onset in samples.
      */
-    float getNextSample();
+    void limitOnsets(const uint interOnset_);
     
-    /**
-     * @brief Retrieves the panning value for the home channel.
-     *
-     * @return The panning value for the home channel (range: 0.0 to 1.0).
-     */
-    const float getHomeChannelPanning() const { return panHomeChannel; }
+    /** @brief Delays the earlier onset to the later one, so both channels start their grains together again. */
+    void alignOnsets();
+    
+    /** @brief Starts a grain on both channels with the next sample. */
+    void resetOnsets() { onsetCounter[0] = onsetCounter[1] = 1; }
     
+private:
     /**
-     * @brief Retrieves the panning value for the neighboring channel.
+     * @brief Adds a grain to the cloud of a channel and draws the next inter-onset.
      *
-     * @return The panning value for the neighboring channel (range: 0.0 to 1.0).
+     * If the cloud is full, the grain is dropped and the onsets go on.
+     *
+     * @param channel_ The channel, 0 (left) or 1 (right).
      */
-    const float getNeighbourChannelPanning() const { return panNeighbourChannel; }
-    
-public:
-    bool isAlive = false;   ///< Flag indicating whether the grain is currently active.
+    void startGrain(const uint channel_);
     
-private:
-    Envelope* envelope = nullptr;    ///< Pointer to the envelope object that shapes the grain's amplitude.
-    GrainData* data = nullptr;       ///< Pointer to the grain's data, which interacts with the source data.
-    unsigned int lifeCounter;        ///< Counter tracking the remaining life of the grain in samples.
+    GrainPropertiesManager* manager = nullptr;  ///< Draws the inter-onsets and the grain properties.
+    GrainCloud* grainClouds = nullptr;          ///< The clouds of the left and the right channel.
     
-    const float panHomeChannel;      ///< Panning value for the home channel (range: 0.0 to 1.0).
-    const float panNeighbourChannel; ///< Panning value for the neighboring channel (range: 0.0 to 1.0).
+    uint onsetCounter[2] = { 1, 1 };            ///< Samples until the next onset of each channel, including the onset sample.
 };
 
 
@@ -1164,6 +1126,7 @@ public:
      *
      * Initializes the necessary resources, configures the grain property manager,
      * and prepares the grain clouds and other DSP components like delay and filter.
+     * The grains are scheduled sample by sample, every block size works.
      *
      * @param sampleRate_ The sample rate of the audio system.
      * @param blockSize_ The size of the audio block to process.
@@ -1171,14 +1134,6 @@ public:
      */
     bool setup(const float sampleRate_, const uint blockSize_);
     
-    /**
-     * @brief Updates the granulator state, potentially adding new grains.
-     *
-     * This function checks the inter-onset counters and creates new grains if
-     * necessary, storing them in the grain cloud for each audio channel.
-     */
-    void update();
-    
     /**
      * @brief Processes a block of stereo audio samples through granular synthesis.
      *
@@ -1191,18 +1146,36 @@ public:
      */
     float32x2_t processAudioSamples(const float32x2_t input_, const uint sampleIndex_);
     
+    /**
+     * @brief Processes a block of non-interleaved stereo audio samples through granular synthesis.
+     *
+     * Block counterpart of `processAudioSamples()`, which stays as the samplewise reference.
+     *
+     * @param input_ Pointers to the left and right input channel.
+     * @param output_ Pointers to the left and right output channel, may alias the input.
+     * @param numFrames_ The number of samples per channel to process.
+     */
+    void processAudioBlock(const float* const input_[2], float* const output_[2], const uint numFrames_);
+    
     void resetPhase();
     
+    /**
+     * @brief Restarts the sequence of the random grain properties, so a render can be reproduced.
+     *
+     * @param seed_ The seed, see `RandomGenerator::setSeed()`.
+     */
+    void setRandomSeed(const uint32_t seed_) { manager.setRandomSeed(seed_); }
+    
     /**
      * @brief Responds to changes in audio parameters.
      *
      * This function is called whenever a parameter changes, updating the corresponding
      * property in the granulator, such as grain length, pitch, wetness, and filter cutoff.
      *
-     * @param parameterID The ID of the parameter that changed.
+     * @param parameter The index of the parameter that changed, resolved from its ID once at setup.
      * @param newValue The new value of the parameter.
      */
-    void parameterChanged(const String parameterID, float newValue);
+    void parameterChanged(const Parameters parameter, float newValue);
     
 private:
     /// Enumeration for the audio channels (left and right).
@@ -1218,11 +1191,8 @@ private:
     SourceData data[2];           ///< Audio source data for each channel.
     GrainPropertiesManager manager; ///< Manager for grain properties.
     
-    std::vector<Grain*> grainCloud[2]; ///< The collection of active grains for each channel.
-    size_t numActiveGrains[2] = { 0, 0 }; ///< Number of active grains for each channel.
-    
-    uint onsetCounter[2];  ///< Counter for the time until the next grain onset.
-    uint nextInterOnset[2]; ///< Time until the next grain onset for each channel.
+    GrainCloud grainCloud[2];     ///< The grains of each channel.
+    GrainScheduler scheduler;     ///< Starts the grains of both channels at their onsets.
     
     FilterStereo filter;          ///< Stereo filter applied to the output.
     Delay delay;                  ///< Delay effect applied to the output.
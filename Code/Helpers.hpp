@@ -151,52 +151,66 @@ private:
 
 
 // =======================================================================================
-// MARK: - EFFECT AVERAGER
+// MARK: - SILENCE DETECTOR
 // =======================================================================================
 
 
 /**
- * @class EffectAverager
- * @brief Implements a small moving averager of stereo  input samples over a large buffer.
+ * @class SilenceDetector
+ * @brief Detects whether a stereo signal has been silent for a while, in constant memory.
  *
- * The `EffectAverager` class provides functionality to
- * maintain a running average, and determine if the average is near zero.
- * It uses a fixed-size buffer and NEON SIMD operations for efficiency. The class can be used
- * to determine whether an effect could be turned off or not.
+ * The detector follows the peak of its input. The signal counts as silent once its peak has stayed
+ * below a threshold for the hold time. To leave the silent state, the peak has to exceed a higher
+ * wake threshold (hysteresis), so noise around the threshold doesn't toggle the state.
+ * An effect can be bypassed when its output is silent, and put to sleep when its input is silent as well.
  */
-class EffectAverager
+class SilenceDetector
 {
 public:
-    EffectAverager();
-    ~EffectAverager() {}
-
     /**
-     * @brief updates the running average.
-     *
-     * This method subtracts the oldest sample in the buffer from the average,
-     * stores the new input sample (scaled by the buffer length), and adds the
-     * scaled input to the average. The buffer is updated in a circular manner.
-     *
+     * @brief sets up the detector, the detector starts in the silent state
+     * @param sampleRate_ the sample rate
+     * @param holdTime_ the time in seconds the signal has to stay below the threshold
+     * @param threshold_ the linear peak threshold below which the signal counts as silent
+     */
+    void setup(const float sampleRate_, const float holdTime_ = DEFAULT_HOLD_TIME, const float threshold_ = DEFAULT_THRESHOLD);
+    
+    /**
+     * @brief updates the detector with one pair of samples.
      * @param input_ The new input audio sample to be processed (as a 2-channel vector).
      */
     void processAudioSamples(float32x2_t input_);
-
+    
     /**
-     * @brief Checks if the running average is near zero.
-     *
-     * Compares each channel of the running average with a small epsilon value
-     * to determine if they are both close to zero.
-     *
-     * @return `true` if both channels of the average are near zero, `false` otherwise.
+     * @brief updates the detector with a whole block of non-interleaved samples, the peak is taken once per block.
+     * @param input_ Pointers to the left and right channel.
+     * @param numFrames_ The number of samples per channel.
+     */
+    void processAudioBlock(const float* const input_[2], const uint numFrames_);
+    
+    /**
+     * @brief Checks if the signal has been silent for the hold time.
+     * @return `true` if the peak of both channels stayed below the threshold for the hold time
      */
-    bool isNearZero();
+    bool isSilent() const { return silent; }
+    
+    static constexpr float DEFAULT_HOLD_TIME = 1.5f; /**< default hold time in seconds */
+    static constexpr float DEFAULT_THRESHOLD = 0.0001f; /**< default threshold, -80 dB */
+    static constexpr float HYSTERESIS = 2.f; /**< the wake threshold is the threshold times this factor (+6 dB) */
 
 private:
-    static constexpr uint bufferLength = 65536; /**< Length of the circular buffer. */
-    static constexpr float32_t fracment = 1.f / static_cast<float>(bufferLength); /**< Scaling factor for averaging. */
-    uint writePointer = 0; /**< Index to the current write position in the buffer. */
-    float32x2_t buffer[65536]; /**< Circular buffer to store audio samples. */
-    float32x2_t average; /**< Current running average of the audio samples. */
+    /**
+     * @brief updates the state with the peak of a number of samples
+     * @param peak_ the absolute peak of both channels
+     * @param numFrames_ the number of samples the peak was taken from
+     */
+    void update(const float peak_, const uint numFrames_);
+    
+    float threshold = DEFAULT_THRESHOLD; /**< below this peak the signal counts as silent */
+    float wakeThreshold = DEFAULT_THRESHOLD * HYSTERESIS; /**< above this peak a silent signal isn't silent anymore */
+    uint holdSamples = 0; /**< number of samples the signal has to stay below the threshold */
+    uint silentSamples = 0; /**< number of samples the signal has been below the threshold */
+    bool silent = true; /**< the detected state */
 };
 
 #endif /* helpers_hpp */
@@ -341,18 +341,8 @@ void Menu::setup(std::array<AudioParameterGroup*, NUM_PARAMETERGROUPS> programPa
 inline void Menu::initializeJSON()
 {
     // get the JSON files for presets and global settings
-    std::ifstream readfilePresets;
-    std::ifstream readfileGlobals;
-    
-    // console print - version (developing)
-    #ifndef BELA_CONNECTED
-    readfilePresets.open("/Users/julianfuchs/Dropbox/BelaProjects/Grainmother/Code/presets.json");
-    readfileGlobals.open("/Users/julianfuchs/Dropbox/BelaProjects/Grainmother/Code/globals.json");
-    // BELA - version (embedded)
-    #else
-    readfilePresets.open("presets.json");
-    readfileGlobals.open("globals.json");
-    #endif
+    std::ifstream readfilePresets(jsonDirectory + "presets.json");
+    std::ifstream readfileGlobals(jsonDirectory + "globals.json");
     
     // error if files couldnt be found
     engine_error(!readfilePresets.is_open(), "presets.json not found, therefore not able to load presets", __FILE__, __LINE__, true);
@@ -375,15 +365,26 @@ void Menu::initializePages()
                          (size_t)JSONglobals["midiInChannel"] - 1, 1);
     addPage<SettingPage>("midi_out_channel", "MIDI Output Channel", nullptr, 16,
                          (size_t)JSONglobals["midiOutChannel"] - 1, 1);
+    addPage<SettingPage>("cpu_meter_enabled", "CPU Meter",
+                         std::initializer_list<String>{ "Off", "On" },
+                         2, JSONglobals.value("cpuMeter", (size_t)0), 0);
     
     // Global Settings
     // parent page for navigating through the settings
     addPage<NavigationPage>("global_settings", "Global Settings", std::initializer_list<Page*>{
         getPage("pot_behaviour"),
         getPage("midi_in_channel"),
-        getPage("midi_out_channel")
+        getPage("midi_out_channel"),
+        getPage("cpu_meter_enabled")
     });
     
+    // CPU Meter
+    // one line per probe (min/avg/max in percent of the block budget) and one for the xruns,
+    // the lines are rewritten by the user interface with every new report
+    std::vector<String> cpuMeterLines(Telemetry::probeNames, Telemetry::probeNames + Telemetry::NUM_PROBES);
+    cpuMeterLines.push_back("Xruns");
+    addPage<SettingPage>("cpu_meter", "CPU Meter", cpuMeterLines.data(), cpuMeterLines.size(), 0, 0);
+    
     // Reverb - Additional Parameters
     // parent page for naviagting through the menu parameters
     addPage<NavigationPage>("reverb_additionalParameters", "Reverb", std::initializer_list<Page*>{
@@ -402,12 +403,20 @@ void Menu::initializePages()
         getPage("granulator_envelopetype")
     });
     
+    // Ringmodulator - Additional Parameters
+    // parent page for naviagting through the menu parameters
+    addPage<NavigationPage>("ringmodulator_additionalParameters", "Ringmodulator", std::initializer_list<Page*>{
+        getPage("ringmod_oversampling"),
+        getPage("ringmod_resampler")
+    });
+    
     // Preset Settings
     // parent page for naviagting through the preset settings
     addPage<NavigationPage>("preset_settings", "Preset Settings", std::initializer_list<Page *>{
         getPage("effect_order"),
         getPage("reverb_additionalParameters"),
         getPage("granulator_additionalParameters"),
+        getPage("ringmodulator_additionalParameters"),
         getPage("tempo_set")
     });
     
@@ -415,7 +424,8 @@ void Menu::initializePages()
     // the main menu page
     addPage<NavigationPage>("menu", "Menu", std::initializer_list<Page*>{
         getPage("preset_settings"),
-        getPage("global_settings")
+        getPage("global_settings"),
+        getPage("cpu_meter")
     });
     
     // retrieve preset names from JSON
@@ -459,20 +469,27 @@ void Menu::initializePageHierarchy()
     getPage("granulator_envelopetype")->addParent(getPage("granulator_additionalParameters"));
     getPage("granulator_glide")->addParent(getPage("granulator_additionalParameters"));
     
+    // Ringmodulator - Additional Parameters
+    getPage("ringmod_oversampling")->addParent(getPage("ringmodulator_additionalParameters"));
+    getPage("ringmod_resampler")->addParent(getPage("ringmodulator_additionalParameters"));
+    
     // Global Settings
     getPage("midi_in_channel")->addParent(getPage("global_settings"));
     getPage("midi_out_channel")->addParent(getPage("global_settings"));
     getPage("pot_behaviour")->addParent(getPage("global_settings"));
+    getPage("cpu_meter_enabled")->addParent(getPage("global_settings"));
     
     // Preset Settings
     getPage("reverb_additionalParameters")->addParent(getPage("preset_settings"));
     getPage("granulator_additionalParameters")->addParent(getPage("preset_settings"));
+    getPage("ringmodulator_additionalParameters")->addParent(getPage("preset_settings"));
     getPage("effect_order")->addParent(getPage("preset_settings"));
     getPage("tempo_set")->addParent(getPage("preset_settings"));
     
     // Overall Menu
     getPage("global_settings")->addParent(getPage("menu"));
     getPage("preset_settings")->addParent(getPage("menu"));
+    getPage("cpu_meter")->addParent(getPage("menu"));
 
     // Home screen
 //    getPage("save_preset")->addParent(getPage("load_preset"));
@@ -533,6 +550,9 @@ void Menu::initializePageActions()
     getPage("pot_behaviour")->onEnter = [this] {
         if (onGlobalSettingChange) onGlobalSettingChange(currentPage);
     };
+    getPage("cpu_meter_enabled")->onEnter = [this] {
+        if (onGlobalSettingChange) onGlobalSettingChange(currentPage);
+    };
     
     // Menu
     // - exit: reset choice index of menu
@@ -547,31 +567,29 @@ void Menu::initializePageActions()
 Menu::~Menu()
 {
     // get the JSON files for presets and global settings
-    // console print - version (developing)
-    #ifndef BELA_CONNECTED
-    std::ofstream writefilePresets("/Users/julianfuchs/Dropbox/BelaProjects/Grainmother/Code/presets.json");
-    std::ofstream writefileGlobals("/Users/julianfuchs/Dropbox/BelaProjects/Grainmother/Code/globals.json");
-    // BELA - version (embedded)
-    #else
-    std::ofstream writefilePresets("presets.json");
-    std::ofstream writefileGlobals("globals.json");
-    #endif
-    
-    // error if files couldnt be found
-    engine_error(!writefilePresets.is_open(), "presets.json not found, not able to save presets", 
-                 __FILE__, __LINE__, true);
-    engine_error(!writefileGlobals.is_open(), "globals.json not found, not able to save globals", 
-                 __FILE__, __LINE__, true);
-    
-    // get and save the global settings
-    JSONglobals["midiInChannel"] = getPage("midi_in_channel")->getCurrentChoiceIndex() + 1;
-    JSONglobals["midiOutChannel"] = getPage("midi_out_channel")->getCurrentChoiceIndex() + 1;
-    JSONglobals["potBehaviour"] = getPage("pot_behaviour")->getCurrentChoiceIndex();
-    JSONglobals["lastUsedPreset"] = lastUsedPresetIndex;
-    
-    // overwrite the files
-    writefilePresets << JSONpresets.dump(4);
-    writefileGlobals << JSONglobals.dump(4);
+    // (only if the menu has been set up and is allowed to write them)
+    if (jsonPersistent && !pages.empty())
+    {
+        std::ofstream writefilePresets(jsonDirectory + "presets.json");
+        std::ofstream writefileGlobals(jsonDirectory + "globals.json");
+        
+        // error if files couldnt be found
+        engine_error(!writefilePresets.is_open(), "presets.json not found, not able to save presets",
+                     __FILE__, __LINE__, true);
+        engine_error(!writefileGlobals.is_open(), "globals.json not found, not able to save globals",
+                     __FILE__, __LINE__, true);
+        
+        // get and save the global settings
+        JSONglobals["midiInChannel"] = getPage("midi_in_channel")->getCurrentChoiceIndex() + 1;
+        JSONglobals["midiOutChannel"] = getPage("midi_out_channel")->getCurrentChoiceIndex() + 1;
+        JSONglobals["potBehaviour"] = getPage("pot_behaviour")->getCurrentChoiceIndex();
+        JSONglobals["cpuMeter"] = getPage("cpu_meter_enabled")->getCurrentChoiceIndex();
+        JSONglobals["lastUsedPreset"] = lastUsedPresetIndex;
+        
+        // overwrite the files
+        writefilePresets << JSONpresets.dump(4);
+        writefileGlobals << JSONglobals.dump(4);
+    }
     
     // delete all page pointers
     for (auto i : pages) delete i;
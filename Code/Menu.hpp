@@ -6,6 +6,7 @@
 #include "Functions.h"
 #include "UIElements.hpp"
 #include "Parameters.hpp"
+#include "Telemetry.hpp"
 
 #include "json.h"
 using json = nlohmann::json;
@@ -195,6 +196,19 @@ public:
         
     void setup(std::array<AudioParameterGroup*, NUM_PARAMETERGROUPS> programParameters_);
     
+    /**
+     * @brief Sets where presets.json and globals.json are read from, has to be called before `setup()`.
+     *
+     * @param directory_ The directory of the JSON files, including a trailing slash (empty for the working directory).
+     * @param persistent_ Whether the (possibly changed) presets and globals are written back on destruction.
+     * The offline renderer passes false, so rendering never modifies the files.
+     */
+    void setJSONLocation(const String& directory_, const bool persistent_ = true)
+    {
+        jsonDirectory = directory_;
+        jsonPersistent = persistent_;
+    }
+    
     template<typename PageType, typename... Args>
     void addPage(const String& id_, Args&&... args_)
     {
@@ -246,6 +260,15 @@ private:
     json JSONpresets;
     json JSONglobals;
     
+    // console print - version (developing)
+    #ifndef BELA_CONNECTED
+    String jsonDirectory = "/Users/julianfuchs/Dropbox/BelaProjects/Grainmother/Code/";
+    // BELA - version (embedded)
+    #else
+    String jsonDirectory = "";
+    #endif
+    bool jsonPersistent = true;
+    
     std::array<AudioParameterGroup*, NUM_PARAMETERGROUPS> programParameters;
     uint lastUsedPresetIndex = 0;
     
@@ -422,6 +422,32 @@ void Display::createPresetMessage()
 }
 
 
+bool Display::sendCpuMeter(const Telemetry::CpuMeter& cpuMeter_)
+{
+    // don't overwrite a message that is waiting in the transmitter
+    if (newMessageCache) return false;
+    
+#ifdef BELA_CONNECTED
+    oscTransmitter.newMessage("/cpumeter");
+    
+    for (uint n = 0; n < Telemetry::NUM_PROBES; ++n)
+    {
+        const Telemetry::Statistics& statistics = cpuMeter_.getStatistics(static_cast<Telemetry::Probe>(n));
+        oscTransmitter.add(Telemetry::probeNames[n]);
+        oscTransmitter.add(statistics.min);
+        oscTransmitter.add(statistics.avg);
+        oscTransmitter.add(statistics.max);
+    }
+    
+    oscTransmitter.add((int)cpuMeter_.getNumXruns());
+    oscTransmitter.add((int)cpuMeter_.getNumOverruns());
+    oscTransmitter.send();
+#endif
+    
+    return true;
+}
+
+
 void Display::createNamingPageMessage(Menu::Page *page_)
 {
 #ifdef BELA_CONNECTED
@@ -112,6 +112,18 @@ public:
      */
     void menuPageChanged(Menu::Page* page_);
     
+    /**
+     * @brief Sends the latest report of the CPU meter to the OSC receiver.
+     *
+     * The message "/cpumeter" holds name, min, avg and max (in percent of the block budget) of every probe,
+     * followed by the number of xruns and overruns. It does not touch the display content and is skipped
+     * while another message is waiting to be sent.
+     *
+     * @param cpuMeter_ The CPU meter holding the report.
+     * @return True if the message was sent.
+     */
+    bool sendCpuMeter(const Telemetry::CpuMeter& cpuMeter_);
+    
     /** @brief Resets the display counter, causing the display to stay active for the duration of `DISPLAY_AUTOHOMESCREEN`. */
     void refreshResetDisplayCounter() { resetDisplayCounter = DISPLAY_AUTOHOMESCREEN; }
     
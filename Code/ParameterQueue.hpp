@@ -0,0 +1,160 @@
+#ifndef parameterqueue_hpp
+#define parameterqueue_hpp
+
+#include "Functions.h"
+
+#include <atomic>
+
+/**
+ * @file ParameterQueue.hpp
+ * @brief Hands parameter changes from the control threads over to the audio thread.
+ *
+ * The user interface, the menu and the MIDI input change parameters on the control thread.
+ * Instead of writing into the DSP objects while the audio thread reads them, they push a
+ * `ParameterChange` into the queue, the audio thread applies all queued changes at the start of
+ * the next block. A change takes effect at a block boundary, at most one block after it was made.
+ */
+
+// =======================================================================================
+// MARK: - PARAMETER RECEIVER
+// =======================================================================================
+
+/**
+ * @class ParameterReceiver
+ * @brief An object whose parameter changes are applied on the audio thread.
+ */
+class ParameterReceiver
+{
+public:
+    virtual ~ParameterReceiver() {}
+    
+    /**
+     * @brief Applies a queued parameter change, called on the audio thread only.
+     * @param index_ the index of the parameter, its meaning is defined by the receiver
+     * @param value_ the new value
+     */
+    virtual void applyParameterChange(const uint index_, const float value_) = 0;
+};
+
+
+// =======================================================================================
+// MARK: - PARAMETER QUEUE
+// =======================================================================================
+
+/**
+ * @struct ParameterChange
+ * @brief A parameter handle (receiver and index) and the new value.
+ */
+struct ParameterChange
+{
+    ParameterReceiver* receiver = nullptr;
+    uint index = 0;
+    float value = 0.f;
+};
+
+/**
+ * @class ParameterQueue
+ * @brief A bounded multi producer, single consumer queue of parameter changes.
+ *
+ * `push()` can be called from any number of threads, it neither allocates nor blocks and only retries
+ * if another producer claimed the same slot in the meantime. `applyChanges()` must only be called
+ * from the audio thread, it is wait-free.
+ *
+ * Every slot carries a sequence number, which tells whether the slot is free for the producer of a
+ * given position or holds a value for the consumer.
+ */
+class ParameterQueue
+{
+public:
+    static const size_t CAPACITY = 1024; ///< changes that can be pending between two blocks
+    
+    ParameterQueue()
+    {
+        for (size_t n = 0; n < CAPACITY; ++n) slots[n].sequence.store(n, std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief Adds a change, returns false and counts it as dropped if the queue is full.
+     * @param receiver_ the receiver, which applies the change on the audio thread
+     * @param index_ the index of the parameter
+     * @param value_ the new value
+     */
+    bool push(ParameterReceiver* receiver_, const uint index_, const float value_)
+    {
+        size_t position = writePosition.load(std::memory_order_relaxed);
+        Slot* slot;
+        
+        while (true)
+        {
+            slot = &slots[position & WRAP];
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+            
+            // the slot is free: claim the position
+            if (difference == 0)
+            {
+                if (writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            }
+            // the slot still holds a change of the previous round: full
+            else if (difference < 0)
+            {
+                numDropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            // another producer claimed the position first
+            else
+            {
+                position = writePosition.load(std::memory_order_relaxed);
+            }
+        }
+        
+        slot->change = { receiver_, index_, value_ };
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * @brief Applies all pending changes in the order they were pushed, audio thread only.
+     * @return the number of applied changes
+     */
+    uint applyChanges()
+    {
+        uint numChanges = 0;
+        
+        while (true)
+        {
+            Slot& slot = slots[readPosition & WRAP];
+            
+            if (slot.sequence.load(std::memory_order_acquire) != readPosition + 1) break;
+            
+            slot.change.receiver->applyParameterChange(slot.change.index, slot.change.value);
+            
+            // free the slot for the producer of the next round
+            slot.sequence.store(readPosition + CAPACITY, std::memory_order_release);
+            ++readPosition;
+            ++numChanges;
+        }
+        
+        return numChanges;
+    }
+    
+    /** @brief Returns the number of changes that were dropped because the queue was full. */
+    uint getNumDropped() const { return numDropped.load(std::memory_order_relaxed); }
+
+private:
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "the capacity of the queue has to be a power of two");
+    static const size_t WRAP = CAPACITY - 1;
+    
+    struct Slot
+    {
+        std::atomic<size_t> sequence { 0 };
+        ParameterChange change;
+    };
+    
+    Slot slots[CAPACITY];
+    alignas(64) std::atomic<size_t> writePosition { 0 }; ///< shared by all producers
+    alignas(64) size_t readPosition = 0; ///< audio thread only
+    std::atomic<uint> numDropped { 0 };
+};
+
+#endif /* parameterqueue_hpp */
@@ -715,7 +715,7 @@ AudioParameter* AudioParameterGroup::getParameter(const unsigned int index_)
 }
 
 
-AudioParameter* AudioParameterGroup::getParameter(const String id_)
+AudioParameter* AudioParameterGroup::getParameter(const String& id_)
 {
     AudioParameter* parameter = nullptr;
     
@@ -112,7 +112,7 @@ public:
     uint getIndex() const { return index; }
     
     /** Gets the ID of the parameter. @return The ID of the parameter. */
-    String getID() const { return id; }
+    const String& getID() const { return id; }
 
     /** Gets the name of the parameter. @return The name of the parameter. */
     String getName() const { return name; }
@@ -614,7 +614,7 @@ public:
      * @param id_ The ID of the parameter.
      * @return A pointer to the requested AudioParameter.
      */
-    AudioParameter* getParameter(const String id_);
+    AudioParameter* getParameter(const String& id_);
     
     /**
      * @brief Returns a parameter by its CC Index
@@ -624,7 +624,7 @@ public:
     AudioParameter* getParameterFromCCIndex(const uint ccIndex_);
     
     /** @brief Gets the ID of the parameter group. @return The ID of the parameter group. */
-    String getID() const { return id; }
+    const String& getID() const { return id; }
 
     /** @brief Gets the number of parameters in the group. @return The number of parameters in the group. */
     size_t getNumParametersInGroup() const { return parameterGroup.size(); }
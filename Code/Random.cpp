@@ -0,0 +1,153 @@
+#include "Random.hpp"
+
+#include <cmath>
+
+namespace
+{
+
+/**
+ * @brief Scrambles a seed, so similar seeds and streams start far apart (splitmix64 finalizer).
+ * @param value_ The seed, combined with the stream.
+ * @return The scrambled value.
+ */
+uint64_t mixSeed(uint64_t value_)
+{
+    value_ += 0x9E3779B97F4A7C15ULL;
+    value_ = (value_ ^ (value_ >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value_ = (value_ ^ (value_ >> 27)) * 0x94D049BB133111EBULL;
+    return value_ ^ (value_ >> 31);
+}
+
+
+/**
+ * @brief The inverse of the normal distribution function at the quantiles (k + 0.5) / (GAUSSIAN_TABLE_SIZE + 1).
+ *
+ * Built once, by bisection of the distribution function, and scaled so the piecewise linear distribution it
+ * describes has a standard deviation of 1.
+ */
+struct GaussianTable
+{
+    GaussianTable()
+    {
+        const uint size = RandomGenerator::GAUSSIAN_TABLE_SIZE;
+        double inverse[size + 1];
+        
+        for (uint k = 0; k <= size; ++k)
+        {
+            const double quantile = (k + 0.5) / (size + 1);
+            
+            double lower = -10.0, upper = 10.0;
+            for (uint n = 0; n < 64; ++n)
+            {
+                const double middle = 0.5 * (lower + upper);
+                if (0.5 * std::erfc(-middle * 0.70710678118654752) < quantile) lower = middle;
+                else upper = middle;
+            }
+            
+            inverse[k] = 0.5 * (lower + upper);
+        }
+        
+        // every interval is drawn with the same probability, the values are uniform in between
+        double variance = 0.0;
+        for (uint k = 0; k < size; ++k)
+            variance += (inverse[k] * inverse[k] + inverse[k] * inverse[k + 1] + inverse[k + 1] * inverse[k + 1]) / 3.0;
+        
+        const double scale = 1.0 / std::sqrt(variance / size);
+        for (uint k = 0; k <= size; ++k) values[k] = (float)(inverse[k] * scale);
+    }
+    
+    float values[RandomGenerator::GAUSSIAN_TABLE_SIZE + 1];
+};
+
+
+const GaussianTable& getGaussianTable()
+{
+    static const GaussianTable table;
+    return table;
+}
+
+}
+
+// =======================================================================================
+// MARK: - RANDOM GENERATOR
+// =======================================================================================
+
+
+void RandomGenerator::setSeed(const uint32_t seed_, const uint32_t stream_)
+{
+    // the standard seeding of PCG32, the increment has to be odd
+    increment = (mixSeed(stream_) << 1u) | 1u;
+    state = 0;
+    getNext();
+    state += mixSeed(((uint64_t)stream_ << 32) | seed_);
+    getNext();
+    
+    // the table is built here and never on the audio thread
+    getGaussianTable();
+}
+
+
+float RandomGenerator::getGaussian(const float mean_, const float stddev_)
+{
+    const float* values = getGaussianTable().values;
+    
+    // the upper bits select the interval, the lower bits the position in it
+    const uint64_t position = (uint64_t)getNext() * GAUSSIAN_TABLE_SIZE;
+    const uint index = (uint)(position >> 32);
+    const float fraction = (float)(uint32_t)position * 2.3283064e-10f;
+    
+    const float value = values[index] + fraction * (values[index + 1] - values[index]);
+    
+    return mean_ + stddev_ * value;
+}
+
+
+// =======================================================================================
+// MARK: - NOISE GENERATOR
+// =======================================================================================
+
+
+void NoiseGenerator::setSeed(const uint32_t seed_, const uint32_t stream_)
+{
+    uint32_t states[4];
+    
+    uint64_t value = ((uint64_t)stream_ << 32) | seed_;
+    for (uint n = 0; n < 4; ++n)
+    {
+        value = mixSeed(value);
+        states[n] = (uint32_t)(value >> 32);
+        
+        // a xorshift generator with the state 0 stays 0
+        if (states[n] == 0) states[n] = 0x6D2B79F5u + n;
+    }
+    
+    state = vld1q_u32(states);
+    hasSpare = false;
+}
+
+
+void NoiseGenerator::fillBlock(float32x2_t* output_, const uint numSamples_)
+{
+    uint n = 0;
+    
+    if (hasSpare && numSamples_ > 0)
+    {
+        output_[n++] = spare;
+        hasSpare = false;
+    }
+    
+    for (; n + 1 < numSamples_; n += 2)
+    {
+        const float32x4_t noise = getNextQuad();
+        output_[n] = vget_low_f32(noise);
+        output_[n + 1] = vget_high_f32(noise);
+    }
+    
+    if (n < numSamples_)
+    {
+        const float32x4_t noise = getNextQuad();
+        output_[n] = vget_low_f32(noise);
+        spare = vget_high_f32(noise);
+        hasSpare = true;
+    }
+}
@@ -0,0 +1,152 @@
+#ifndef random_hpp
+#define random_hpp
+
+#include "Functions.h"
+
+/**
+ * @file Random.hpp
+ * @brief Fast, deterministic random number generators with a state per instance.
+ *
+ * Unlike `rand()`, the generators share no state: they are safe to use on any thread, an effect draws the same
+ * values no matter how many other effects draw in between, and the same seed reproduces the same values.
+ * Offline renders of presets with random grains or noise are bit-reproducible this way.
+ */
+
+static const uint32_t DEFAULT_RANDOM_SEED = 1;  ///< The seed of a generator that was never seeded explicitly.
+
+// =======================================================================================
+// MARK: - RANDOM GENERATOR
+// =======================================================================================
+
+/**
+ * @class RandomGenerator
+ * @brief A PCG32 generator (XSH RR variant) for values that are drawn one at a time.
+ *
+ * The 64 bit state is advanced by a linear congruential step, the output is a permutation of its upper bits.
+ * Different streams of the same seed are independent sequences.
+ *
+ * @cite Melissa E. O'Neill: "PCG: A Family of Simple Fast Space-Efficient Statistically Good Algorithms for Random Number Generation"
+ */
+class RandomGenerator
+{
+public:
+    /**
+     * @brief Constructs a generator, see `setSeed()`.
+     * @param seed_ The seed.
+     * @param stream_ Selects one of the independent sequences of the seed.
+     */
+    explicit RandomGenerator(const uint32_t seed_ = DEFAULT_RANDOM_SEED, const uint32_t stream_ = 0) { setSeed(seed_, stream_); }
+    
+    /**
+     * @brief Restarts the sequence, the same seed and stream produce the same values.
+     *
+     * Also builds the table of the normal distribution, if no generator did it before.
+     *
+     * @param seed_ The seed.
+     * @param stream_ Selects one of the independent sequences of the seed.
+     */
+    void setSeed(const uint32_t seed_, const uint32_t stream_ = 0);
+    
+    /** @brief Returns the next 32 random bits. */
+    uint32_t getNext()
+    {
+        const uint64_t oldState = state;
+        state = oldState * MULTIPLIER + increment;
+        
+        const uint32_t xorShifted = (uint32_t)(((oldState >> 18u) ^ oldState) >> 27u);
+        const uint32_t rotation = (uint32_t)(oldState >> 59u);
+        
+        return (xorShifted >> rotation) | (xorShifted << ((32u - rotation) & 31u));
+    }
+    
+    /** @brief Returns a uniformly distributed value in [0, 1), with a resolution of 2^-24. */
+    float getUniform() { return (float)(getNext() >> 8) * 5.9604645e-8f; }
+    
+    /** @brief Returns a uniformly distributed value in [-1, 1), with a resolution of 2^-23. */
+    float getBipolar() { return (float)(getNext() >> 8) * 1.1920929e-7f - 1.f; }
+    
+    /**
+     * @brief Returns a normally distributed value.
+     *
+     * Interpolates the inverse of the normal distribution function in a table, with a single draw and no
+     * transcendental functions. The distribution is truncated at about 3.3 standard deviations, the table is
+     * scaled so the standard deviation is still exact.
+     *
+     * @param mean_ The mean (center) of the distribution.
+     * @param stddev_ The standard deviation (spread) of the distribution.
+     * @return A value sampled from the distribution.
+     */
+    float getGaussian(const float mean_, const float stddev_);
+    
+    static const uint GAUSSIAN_TABLE_SIZE = 1024;  ///< Number of intervals of the inverse normal distribution.
+
+private:
+    static const uint64_t MULTIPLIER = 6364136223846793005ULL;  ///< The multiplier of the congruential step.
+    
+    uint64_t state;  ///< The state of the congruential step.
+    uint64_t increment;  ///< The increment of the congruential step, odd, selects the stream.
+};
+
+
+// =======================================================================================
+// MARK: - NOISE GENERATOR
+// =======================================================================================
+
+/**
+ * @class NoiseGenerator
+ * @brief White noise in blocks, from four xorshift32 generators in the lanes of a quad.
+ *
+ * The lanes are seeded with different states, so a quad yields four values per step, with three shifts and three
+ * exclusive ors and no multiplication. The random bits fill the mantissa of a float, no conversion is needed either.
+ *
+ * @cite George Marsaglia: "Xorshift RNGs"
+ */
+class NoiseGenerator
+{
+public:
+    /**
+     * @brief Constructs a generator, see `setSeed()`.
+     * @param seed_ The seed.
+     * @param stream_ Selects one of the independent sequences of the seed.
+     */
+    explicit NoiseGenerator(const uint32_t seed_ = DEFAULT_RANDOM_SEED, const uint32_t stream_ = 0) { setSeed(seed_, stream_); }
+    
+    /**
+     * @brief Restarts the sequence, the same seed and stream produce the same values.
+     * @param seed_ The seed.
+     * @param stream_ Selects one of the independent sequences of the seed.
+     */
+    void setSeed(const uint32_t seed_, const uint32_t stream_ = 0);
+    
+    /** @brief Returns four uniformly distributed values in [-1, 1). */
+    float32x4_t getNextQuad()
+    {
+        state = veorq_u32(state, vshlq_n_u32(state, 13));
+        state = veorq_u32(state, vshrq_n_u32(state, 17));
+        state = veorq_u32(state, vshlq_n_u32(state, 5));
+        
+        // the upper 23 bits are the mantissa of a float in [2, 4)
+        const float32x4_t value = vreinterpretq_f32_u32(vorrq_u32(vshrq_n_u32(state, 9), vdupq_n_u32(0x40000000)));
+        
+        return vsubq_f32(value, vdupq_n_f32(3.f));
+    }
+    
+    /**
+     * @brief Fills a block of stereo samples with noise, one quad for two samples.
+     *
+     * The half of a quad that is left over after an odd number of samples starts the next block, so the noise
+     * doesn't depend on how a signal is split into blocks.
+     *
+     * @param output_ Receives the noise.
+     * @param numSamples_ The number of stereo samples.
+     */
+    void fillBlock(float32x2_t* output_, const uint numSamples_);
+
+private:
+    uint32x4_t state;  ///< The states of the four generators, never 0.
+    
+    float32x2_t spare;  ///< The upper half of the last quad, if it wasn't used yet.
+    bool hasSpare = false;  ///< Flag indicating whether `spare` holds the next samples.
+};
+
+#endif /* random_hpp */
@@ -4,12 +4,6 @@
 using namespace Reverberation;
 
 
-// initialize static member variables
-unsigned int CombFilterStereo::writePointer = 0;
-unsigned int AllpassFilterStereo::writePointer = 0;
-unsigned int AllpassFilterMono::writePointer = 0;
-
-
 // =======================================================================================
 // MARK: - Tap Delay
 // =======================================================================================
@@ -160,15 +154,24 @@ bool AllpassFilterStereo::setup(const float& feedbackGain_, const unsigned int&
     std::fill(buffer.begin(), buffer.end(), vdup_n_f32(0.f));
 
     // setup readPointer (-1 because read before write!)
-    readPointerLo = bufferLength - delaySamples;
-    if (readPointerLo < 0) readPointerLo += bufferLength;
+    resetReadPointers();
                 
-    // set random start phase for lfo
-    lfoPhase = ((rand() / (float)RAND_MAX) * TWOPI);
+    // set start phase for lfo
+    lfoPhase = getLFOStartPhase(delaySamples);
             
     return true;
 }
 
+void AllpassFilterStereo::resetReadPointers()
+{
+    // the delay already contains the +1, since the buffer is read before it is written
+    readPointerLo = writePointer - delaySamples;
+    readPointerHi = readPointerLo - 1;
+    if (readPointerLo < 0) readPointerLo += bufferLength;
+    if (readPointerHi < 0) readPointerHi += bufferLength;
+    interpolationNeeded = false;
+}
+
 void AllpassFilterStereo::updateLFO(const float& lfoIncrement_, const float& lfoDepth_)
 {
     // increment lfo Phase
@@ -233,6 +236,7 @@ void AllpassFilterStereo::writeBuffer(float32x2_t input_)
     buffer[writePointer] = input_;
     
     // increment buffer-pointers
+    writePointer = (writePointer + 1) & bufferWrap;
     if (++readPointerLo >= bufferLength) readPointerLo = 0;
     if (++readPointerHi >= bufferLength) readPointerHi = 0;
 }
@@ -261,8 +265,8 @@ bool CombFilterStereo::setup(const unsigned int& delaySamples_, const float& dam
     readPointerLo = writePointer - 1 - delaySamples;
     if (readPointerLo < 0) readPointerLo += bufferLength;
                 
-    // set random start phase for lfo
-    lfoPhase = ((rand() / (float)RAND_MAX) * TWOPI);
+    // set start phase for lfo
+    lfoPhase = getLFOStartPhase(delaySamples);
         
     return true;
 }
@@ -366,16 +370,25 @@ void CombFilterStereo::writeBuffer(float32x2_t input_)
     buffer[writePointer] = input_;
     
     // Increment buffer-pointers
+    writePointer = (writePointer + 1) & bufferWrap;
     readPointerLo = (readPointerLo + 1) & bufferWrap;
     readPointerHi = (readPointerHi + 1) & bufferWrap;
 }
 
 
+void CombFilterDualStereo::resetStates()
+{
+    lowpassState = vdupq_n_f32(0.f);
+    filters[0].lowpassState = vdup_n_f32(0.f);
+    filters[1].lowpassState = vdup_n_f32(0.f);
+}
+
+
 void CombFilterDualStereo::update()
 {
     // recatch the filter coefficients from corresponding members
-    b0 = { filters[0].b0, filters[0].b0, filters[1].b0, filters[1].b0 };
-    b1 = { filters[0].b1, filters[0].b1, filters[1].b1, filters[1].b1 };
+    b0 = makeQuad(filters[0].b0, filters[0].b0, filters[1].b0, filters[1].b0);
+    b1 = makeQuad(filters[0].b1, filters[0].b1, filters[1].b1, filters[1].b1);
 }
 
 
@@ -63,6 +63,21 @@ static const std::array<unsigned int, 3> earliesLatestDelaySamples = {{ 5000u, 2
 
 /** @} */
 
+/**
+ * @brief returns the start phase of the lfo of a modulated delay line
+ *
+ * the phases are spread by the golden ratio of the delay, so that delay lines of different lengths start decorrelated,
+   while every reverb instance starts with the same phases
+ *
+ * @param delaySamples_ the delay of the delay line in samples
+ * @return the start phase 0...2PI
+ */
+inline float getLFOStartPhase(const unsigned int delaySamples_)
+{
+    float position = delaySamples_ * 0.6180339887f;
+    return (position - floorf(position)) * TWOPI;
+}
+
 // =======================================================================================
 // MARK: - Simple Delay
 // =======================================================================================
@@ -207,6 +222,9 @@ public:
     /** returns the momentary feedback gain */
     float32_t getFeedbackGain() const { return g; }
     
+    /** sets the state variable to 0.f */
+    void resetState() { state = vdup_n_f32(0.f); }
+    
 private:
     float32x2_t state; ///< the last state of y(n)
     float32_t g; ///< feedback gain
@@ -601,6 +619,21 @@ public:
      */
     void recalculateTapDelays(const unsigned int& room_, const float& predelaySamples_, const float& size_);
     
+    /**
+     * @brief sets a range of the buffer to 0.f, in both channels
+     *
+     * @param start_ the first index of the range
+     * @param numSamples_ the length of the range, start_ + numSamples_ must not exceed the buffer size
+     */
+    void clearBuffer(const unsigned int start_, const unsigned int numSamples_)
+    {
+        std::fill(buffer[0].begin() + start_, buffer[0].begin() + start_ + numSamples_, 0.f);
+        std::fill(buffer[1].begin() + start_, buffer[1].begin() + start_ + numSamples_, 0.f);
+    }
+    
+    /** returns the length of the buffer */
+    static unsigned int getBufferSize() { return bufferSize; }
+    
 private:
     static const unsigned int bufferSize = 32768; ///< length of the buffer
     static const unsigned int bufferSizeWrap = 32767; ///< bufferlength-1, used for wrapping pointers
@@ -641,7 +674,7 @@ public:
         std::fill(buffer.begin(), buffer.end(), 0.f);
         
         // setup readPointer (-1 because read before write!)
-        readPointer = bufferLength - 1 - delaySamples;
+        readPointer = (writePointer - 1 - delaySamples) & bufferWrap;
         
         return true;
     }
@@ -682,28 +715,28 @@ public:
     /** reads the intenal buffer at read pointer index */
     float readBuffer() { return buffer[readPointer]; }
     
-    /** writes ithe internal buffer at write pointer index, increments the read pointer */
+    /** writes ithe internal buffer at write pointer index, increments the pointers */
     void writeBuffer(float input_)
     {
         // write new value into buffer
         buffer[writePointer] = input_;
         
-        // increment read pointer
+        // increment pointers
+        writePointer = (writePointer + 1) & bufferWrap;
         readPointer = (readPointer + 1) & bufferWrap;
     }
     
     /** returns the momentary feedback gain */
     const float& getFeedbackGain() const { return feedbackGain; }
     
-    /** increments the static member variable writePointer */
-    static void incrementWritePointer() { writePointer = (writePointer + 1) & bufferWrap; }
+    /** sets all values in the buffer to 0.f */
+    void clearBuffer() { std::fill(buffer.begin(), buffer.end(), 0.f); }
     
 private:
     static const unsigned int bufferLength = 1024; ///< fixed buffer length for this module
     static const unsigned int bufferWrap = 1023; ///< bufferLength - 1, used for wrapping pointers
     
-    static unsigned int writePointer; ///< write position for the internal buffer, since bufferLength stays the same for all objects of this class, this variable can be static
-    
+    unsigned int writePointer = 0; ///< write position for the internal buffer
     unsigned int readPointer = 0; ///< individual read pointer
     std::array<float, bufferLength> buffer; ///< the internal buffer holding past samples
     
@@ -732,7 +765,7 @@ public:
      */
     void update()
     {
-        feedbackGain = { filters[0].getFeedbackGain(), filters[1].getFeedbackGain() };
+        feedbackGain = makeStereo(filters[0].getFeedbackGain(), filters[1].getFeedbackGain());
     }
     
     /**
@@ -801,21 +834,23 @@ public:
     /** sets new feedback gain */
     void setFeedbackGain(const float& feedbackGain_);
     
-    /** increments the write pointer */
-    static void incrementWritePointer() { writePointer = (writePointer + 1) & bufferWrap; }
-    
     /** reads out the buffer, uses linear interpolation if necessary */
     float32x2_t readBuffer();
     
-    /** writes new samples to the buffer, increments read pointers */
+    /** writes new samples to the buffer, increments the pointers */
     void writeBuffer(float32x2_t input_);
     
+    /** sets all values in the buffer to 0.f */
+    void clearBuffer() { std::fill(buffer.begin(), buffer.end(), vdup_n_f32(0.f)); }
+    
+    /** sets the read pointers according to the delay */
+    void resetReadPointers();
+    
 private:
     static const unsigned int bufferLength = 1024; ///< fixed buffer length for this module
     static const unsigned int bufferWrap = 1023; ///< bufferLength - 1, used for wrapping pointers
     
-    static unsigned int writePointer; ///< write pointer for the internal buffer, since bufferLength stays the same for all objects of this class, this variable can be static
-    
+    unsigned int writePointer = 0; ///< write pointer for the internal buffer
     std::array<float32x2_t, bufferLength> buffer; ///< the internal buffer holding past samples
     
     int readPointerLo = 0; ///< integer read pointers next to the float read position
@@ -886,23 +921,22 @@ public:
     /** returns the momentary delay in samples */
     unsigned int getDelaySamples() const { return delaySamples; }
     
-    /** increments the write pointer */
-    static void incrementWritePointer() { writePointer = (writePointer + 1) & bufferWrap; }
-    
     /** reads out the buffer, uses linear interpolation if necessary */
     float32x2_t readBuffer();
     
-    /** writes new samples to the buffer, increments read pointers */
+    /** writes new samples to the buffer, increments the pointers */
     void writeBuffer(float32x2_t input_);
     
+    /** sets all values in the buffer to 0.f */
+    void clearBuffer() { std::fill(buffer.begin(), buffer.end(), vdup_n_f32(0.f)); }
+    
     friend class CombFilterDualStereo;
     
 private:
     static const unsigned int bufferLength = 8192; ///< fixed buffer length for this module
     static const unsigned int bufferWrap = 8191; ///< bufferLength - 1, used for wrapping pointers
     
-    static unsigned int writePointer; ///< write pointer for the internal buffer, since bufferLength stays the same for all objects of this class, this variable can be static
-    
+    unsigned int writePointer = 0; ///< write pointer for the internal buffer
     std::array<float32x2_t, bufferLength> buffer; ///< the internal buffer holding past samples
     
     int readPointerLo = 0; ///< integer read pointers next to the float read position
@@ -951,6 +985,9 @@ public:
      */
     float32x2_t processAudioSampleInParallel(float32x2_t xn_);
     
+    /** @brief resets the lowpass states of both filters, the buffers are not touched */
+    void resetStates();
+    
 private:
     /** vectors of 4 filter coefficents, two each are copied from the corresponding CombFilterStereo objects */
     alignas(alignof(float32x4_t)) float32x4_t b0, b1;
@@ -31,6 +31,12 @@ void EarlyReflections::setup(const float& sampleRate_, const float& blockSize_)
     parameters.predelay.setup(initialPreDelay, sampleRate_, RAMP_UPDATE_RATE, true);
     parameters.predelay.setID("predelay");
     parameters.feedback.setup(initialFeedback, sampleRate_, RAMP_UPDATE_RATE, true);
+    
+    // the tap delays with the initial predelay and size
+    tapDelay.recalculateTapDelays(typeParameters->room, parameters.predelay(), parameters.size());
+    
+    // the buffers have just been cleared by the filter setups
+    numClearedSamples = TapDelayStereo::getBufferSize();
 }
 
 
@@ -75,9 +81,6 @@ float32x2_t EarlyReflections::processAudioSamples(const float32x2_t input_, cons
     if (allpass.filters[0].enabled)
         allpass.processAudioSamples(delayInput);
     
-    // increment write Pointer of Allpassfilter
-    AllpassFilterMono::incrementWritePointer();
-    
     // 2. plus a definable amount of feedback times the 4th early reflection in the tapdelay
     if (parameters.feedbackEnabled)
     {
@@ -143,13 +146,8 @@ void EarlyReflections::setParameters(const EarlyReflectionsParameters& parameter
 
 void EarlyReflections::setTypeParameters(const EarlyReflectionsTypeParameters& typeParameters_)
 {
-    // reset type parameters
-    typeParameters = nullptr;
-    
-    // alligned allocation of type parameters
-    void* rawPointer = aligned_alloc(alignof(float32x4_t), sizeof(EarlyReflectionsTypeParameters));
-    EarlyReflectionsTypeParameters* instancePointer = new (rawPointer) EarlyReflectionsTypeParameters(typeParameters_);
-    typeParameters = EarlyReflectionsTypeParametersPtr(instancePointer);
+    // set type parameters, they are owned by the reverb
+    typeParameters = &typeParameters_;
 
     // update tap delay
     tapDelay.recalculateTapDelays(typeParameters->room, parameters.predelay(), parameters.size());
@@ -164,6 +162,47 @@ void EarlyReflections::setTypeParameters(const EarlyReflectionsTypeParameters& t
 }
 
 
+void EarlyReflections::activate(const EarlyReflectionsParameters& parameters_)
+{
+    // copy the ramps, the assignment operator of the parameters doesn't
+    parameters.size = parameters_.size;
+    parameters.predelay = parameters_.predelay;
+    parameters.feedback = parameters_.feedback;
+    parameters.feedbackEnabled = parameters_.feedbackEnabled;
+    
+    // update tap delay
+    tapDelay.recalculateTapDelays(typeParameters->room, parameters.predelay(), parameters.size());
+}
+
+
+bool EarlyReflections::clearNextChunk()
+{
+    if (isCleared()) return true;
+    
+    tapDelay.clearBuffer(numClearedSamples, EARLIES_CLEAR_CHUNK);
+    numClearedSamples += EARLIES_CLEAR_CHUNK;
+    
+    if (!isCleared()) return false;
+    
+    // the filters are small, they are cleared with the last chunk
+    allpass.filters[0].clearBuffer();
+    allpass.filters[1].clearBuffer();
+    lowpass.resetState();
+    
+    return true;
+}
+
+
+EarlyReflections::EarlyReflectionsTypeParametersPtr EarlyReflections::createTypeParameters(const EarlyReflectionsTypeParameters& typeParameters_)
+{
+    // alligned allocation of type parameters
+    void* rawPointer = aligned_alloc(alignof(float32x4_t), sizeof(EarlyReflectionsTypeParameters));
+    EarlyReflectionsTypeParameters* instancePointer = new (rawPointer) EarlyReflectionsTypeParameters(typeParameters_);
+    
+    return EarlyReflectionsTypeParametersPtr(instancePointer);
+}
+
+
 // =======================================================================================
 // MARK: - Decay
 // =======================================================================================
@@ -197,6 +236,34 @@ void Decay::setup(const DecayParameters& params_, const float& sampleRate_, cons
 
     // --- copy set of Parameters
     setParameters(params_);
+    
+    // --- the buffers have just been cleared by the filter setups
+    numClearedFilters = getNumFilters();
+}
+
+
+void Decay::activate()
+{
+    for (unsigned int n = 0; n < typeParameters.halfNumCombFilters; ++n)
+        combFilters[n].resetStates();
+}
+
+
+bool Decay::clearNextFilter()
+{
+    if (isCleared()) return true;
+    
+    // order: combfilters, pre-allpassfilters, post-allpassfilters
+    unsigned int n = numClearedFilters;
+    
+    if (n < typeParameters.numCombFilters)
+        combFilters[n/2].filters[n%2].clearBuffer();
+    else if ((n -= typeParameters.numCombFilters) < typeParameters.numPreAllpassFilters)
+        allpassFiltersPre[n].clearBuffer();
+    else
+        allpassFiltersPost[n - typeParameters.numPreAllpassFilters].clearBuffer();
+    
+    return ++numClearedFilters == getNumFilters();
 }
 
 void Decay::updateRamps()
@@ -257,10 +324,6 @@ float32x2_t Decay::processAudioSamples(const float32x2_t input_, const unsigned
         for (unsigned int n = 0; n < typeParameters.numPostAllpassFilters; ++n)
             allpassFiltersPost[n].processAudioSamples(output);
 
-    // increment static write pointers
-    CombFilterStereo::incrementWritePointer();
-    AllpassFilterStereo::incrementWritePointer();
-    
     return output;
 }
 
@@ -363,20 +426,31 @@ void Reverb::setup(const float& sampleRate_, const unsigned int& blocksize_)
     sampleRate = sampleRate_;
     blocksize = blocksize_;
     samplesPerMs = sampleRate * 0.001f;
+    crossfadeIncr = PIo2 / (TYPE_CROSSFADE_TIME * sampleRate);
     
     unsigned int maxDelayOfDecay = *std::max_element(earliesLatestDelaySamples.begin(), earliesLatestDelaySamples.end()) * 3.f + 7000.f;
     delayedDecay.setup(0, maxDelayOfDecay, sampleRate);
 
-    // sets the default reverb type and the corresponding parameters
-    // for earlies and decay, creates a new decay object
+    // create the type parameters and the decays of all reverb types,
+    // switching the type later on doesn't need to allocate anything
+    DecayParameters paramsDecay;
+    
+    for (unsigned int n = 0; n < NUM_TYPES; ++n)
+    {
+        createType(static_cast<ReverbTypes>(n));
+        decays[n]->setup(paramsDecay, sampleRate, blocksize);
+    }
+
+    // sets the default reverb type and the corresponding parameters for earlies and decay
     ReverbTypes initialType = static_cast<ReverbTypes>(parameterInitialValue[static_cast<int>(Parameters::TYPE)]);
     setReverbType(initialType);
     
-    // setup eraly reflections
-    earlyReflections.setup(sampleRate, blocksize);
+    // setup eraly reflections, both instances need type parameters first
+    for (EarlyReflections& instance : earlyReflections)
+        instance.setup(sampleRate, blocksize);
     
     // setup delayline for decay
-    int delayOfDecay = earlyReflections.getLatestTapDelay() - decay->getEarliestCombDelay();
+    int delayOfDecay = earlies->getLatestTapDelay() - decay->getEarliestCombDelay();
     if (delayOfDecay < 0) delayOfDecay = 0;
     decayDelaySamples.setup(delayOfDecay, sampleRate, RAMP_UPDATE_RATE);
     delayedDecay.setDelay(decayDelaySamples());
@@ -406,27 +480,56 @@ void Reverb::updateRamps()
 // ------------------------------------------------------------------------------
 float32x2_t Reverb::processAudioSamples(const float32x2_t input_, const unsigned int& sampleIndex_)
 {
-    if (!settingType)
-    {
-        if ((sampleIndex_ & (RAMP_UPDATE_RATE-1)) == 0) updateRamps();
+    if (sampleIndex_ == 0) clearInactiveDecays();
+    
+    if ((sampleIndex_ & (RAMP_UPDATE_RATE-1)) == 0) updateRamps();
+    
+    float32x2_t output = input_;
+    
+    // parametric eq shapes the input signal
+    if (inputMultiplier.enabled) inputMultiplier.processAudioSamples(output);
+   
+    // early reflections
+    output = processEarlies(output, sampleIndex_);
+    
+    // decay, mixes the delayed processed decay with the early reflections
+    // the delay sits in front of the decay, so it can be changed without affecting the tail when switching the type
+    // a richer stereo effect is achieved by swapping the input values
+    float32x2_t dcy = processDecay(delayedDecay.processAudioSamples(vrev64_f32(output)), sampleIndex_);
+    // weighted sum of earlies and decay
+    output = vmul_n_f32(vadd_f32(dcy, output), 0.5f);
     
-        float32x2_t output = input_;
+    // process low and highcut
+    if (lowcut.enabled) lowcut.processAudioSamples(output);
+    if (highcut.enabled) highcut.processAudioSamples(output);
+    
+    // apply output gain compensation
+    output = vmul_n_f32(output, GAIN_COMPENSATION);
+    
+    // return as StereoFloat
+    return output;
+}
+
+
+void Reverb::processAudioBlock(const float* const input_[2], float* const output_[2], const unsigned int numFrames_)
+{
+    clearInactiveDecays();
+    
+    for (unsigned int n = 0; n < numFrames_; ++n)
+    {
+        float32x2_t output = { input_[0][n], input_[1][n] };
+        
+        if ((n & (RAMP_UPDATE_RATE-1)) == 0) updateRamps();
         
         // parametric eq shapes the input signal
         if (inputMultiplier.enabled) inputMultiplier.processAudioSamples(output);
-       
+        
         // early reflections
-        output = earlyReflections.processAudioSamples(output, sampleIndex_);
+        output = processEarlies(output, n);
         
         // decay, mixes the delayed processed decay with the early reflections
-        if (decay)
-        {
-            // get the delayed decay values and input the momentary values simultaniously
-            // a richer stereo effect is achieved by swapping the input values
-            float32x2_t dcy = delayedDecay.processAudioSamples(decay->processAudioSamples(vrev64_f32(output), sampleIndex_));
-            // weighted sum of earlies and decay
-            output = vmul_n_f32(vadd_f32(dcy, output), 0.5f);
-        }
+        float32x2_t dcy = processDecay(delayedDecay.processAudioSamples(vrev64_f32(output)), n);
+        output = vmul_n_f32(vadd_f32(dcy, output), 0.5f);
         
         // process low and highcut
         if (lowcut.enabled) lowcut.processAudioSamples(output);
@@ -435,34 +538,173 @@ float32x2_t Reverb::processAudioSamples(const float32x2_t input_, const unsigned
         // apply output gain compensation
         output = vmul_n_f32(output, GAIN_COMPENSATION);
         
-        // return as StereoFloat
-        return output;
+        output_[0][n] = vget_lane_f32(output, 0);
+        output_[1][n] = vget_lane_f32(output, 1);
+    }
+}
+
+
+float32x2_t Reverb::processEarlies(const float32x2_t input_, const unsigned int& sampleIndex_)
+{
+    float32x2_t output = earlies->processAudioSamples(input_, sampleIndex_);
+    
+    // equal-power crossfade, the same as the one of the decays
+    if (fadingEarlies)
+    {
+        float32x2_t fadingOutput = fadingEarlies->processAudioSamples(input_, sampleIndex_);
+        
+        output = vmul_n_f32(output, approximateSine(crossfadePhase));
+        output = vmla_n_f32(output, fadingOutput, approximateSine(PIo2 - crossfadePhase));
+    }
+    
+    return output;
+}
+
+
+float32x2_t Reverb::processDecay(const float32x2_t input_, const unsigned int& sampleIndex_)
+{
+    float32x2_t output = decay->processAudioSamples(input_, sampleIndex_);
+    
+    // equal-power crossfade: the new decay rises with sin, the old one falls with cos
+    if (fadingDecay)
+    {
+        float32x2_t fadingOutput = fadingDecay->processAudioSamples(input_, sampleIndex_);
+        
+        output = vmul_n_f32(output, approximateSine(crossfadePhase));
+        output = vmla_n_f32(output, fadingOutput, approximateSine(PIo2 - crossfadePhase));
+        
+        // crossfade finished, the old decay and early reflections get cleared blockwise from now on
+        if ((crossfadePhase += crossfadeIncr) >= PIo2)
+        {
+            fadingDecay->deactivate();
+            fadingDecay = nullptr;
+            fadingEarlies->deactivate();
+            fadingEarlies = nullptr;
+        }
+    }
+    
+    return output;
+}
+
+
+void Reverb::clearInactiveDecays()
+{
+    // the inactive early reflections, one chunk per block
+    EarlyReflections* inactiveEarlies = (earlies == &earlyReflections[0]) ? &earlyReflections[1] : &earlyReflections[0];
+    
+    if (inactiveEarlies != fadingEarlies) inactiveEarlies->clearNextChunk();
+    
+    // one filter of one decay per block to keep the load per block low, the pending decay first
+    if (pendingDecay && !pendingDecay->isCleared())
+    {
+        pendingDecay->clearNextFilter();
+    }
+    else
+    {
+        for (unsigned int n = 0; n < NUM_TYPES; ++n)
+        {
+            Decay* inactiveDecay = decays[n].get();
+            
+            if (inactiveDecay == decay || inactiveDecay == fadingDecay || inactiveDecay->isCleared()) continue;
+            
+            inactiveDecay->clearNextFilter();
+            break;
+        }
     }
-    return vdup_n_f32(0.f);
+    
+    if (pendingDecay) startPendingType();
+}
+
+
+void Reverb::startPendingType()
+{
+    EarlyReflections* newEarlies = (earlies == &earlyReflections[0]) ? &earlyReflections[1] : &earlyReflections[0];
+    
+    // wait for the running crossfade and the clearing
+    if (fadingDecay || !pendingDecay->isCleared() || !newEarlies->isCleared()) return;
+    
+    // make a new set of Decay Parameters, copied from the momentary decay
+    DecayParameters paramsDecay = decay->getParameters();
+    paramsDecay.modulationDepth = decay->getParameters().modulationDepth();
+    
+    pendingDecay->activate();
+    pendingDecay->setParameters(paramsDecay);
+    
+    newEarlies->setTypeParameters(*earliesTypeParameters[static_cast<int>(pendingType)]);
+    newEarlies->activate(earlies->getParameters());
+    
+    crossfadePhase = 0.f;
+    fadingDecay = decay;
+    decay = pendingDecay;
+    fadingEarlies = earlies;
+    earlies = newEarlies;
+    pendingDecay = nullptr;
+    
+    updateDecayDelay();
+}
+
+
+void Reverb::updateDecayDelay()
+{
+    int delayOfDecay = earlies->getLatestTapDelay() - decay->getEarliestCombDelay();
+    if (delayOfDecay < 0) delayOfDecay = 0;
+    decayDelaySamples = delayOfDecay;
+    delayedDecay.setDelay(decayDelaySamples());
 }
 
 
 void Reverb::setReverbType(ReverbTypes type_)
 {
-    settingType = true;
+    Decay* newDecay = decays[static_cast<int>(type_)].get();
     
-    // helper
-    using Room = EarlyReflectionsTypeParameters::Room;
+    // no decay yet (setup): no crossfade needed, both early reflections get the type parameters for their setup
+    if (!decay)
+    {
+        for (EarlyReflections& instance : earlyReflections)
+            instance.setTypeParameters(*earliesTypeParameters[static_cast<int>(type_)]);
+        
+        earlies = &earlyReflections[0];
+        decay = newDecay;
+        return;
+    }
     
-    // make a new set of Decay Parameters
-    DecayParameters paramsDecay;
+    // a type that is still waiting is replaced by the new one
+    pendingDecay = nullptr;
+    
+    if (newDecay == decay) return;
     
-    // if a decay already exists (only in setup its not the case) we can copy parameters from there
-    if (decay) 
+    // the new type is still fading out: reverse the crossfade
+    if (newDecay == fadingDecay)
     {
-        paramsDecay = decay->getParameters();
+        // make a new set of Decay Parameters, copied from the momentary decay
+        DecayParameters paramsDecay = decay->getParameters();
         paramsDecay.modulationDepth = decay->getParameters().modulationDepth();
+        newDecay->setParameters(paramsDecay);
+        
+        crossfadePhase = PIo2 - crossfadePhase;
+        std::swap(decay, fadingDecay);
+        std::swap(earlies, fadingEarlies);
+        
+        updateDecayDelay();
+    }
+    // the crossfade starts as soon as the delay lines are cleared, usually right away
+    else
+    {
+        pendingDecay = newDecay;
+        pendingType = type_;
+        startPendingType();
     }
+}
+
+
+void Reverb::createType(ReverbTypes type_)
+{
+    // helper
+    using Room = EarlyReflectionsTypeParameters::Room;
     
-    // clear decay
-    decay = nullptr;
-        
-    // looks for the new type, and sets the corresponding fixed type parameters
+    unsigned int index = static_cast<int>(type_);
+    
+    // looks for the type, and creates the corresponding fixed type parameters
     // creates a new unique pointer to a Decay object
     switch (type_)
     {
@@ -485,9 +727,8 @@ void Reverb::setReverbType(ReverbTypes type_)
             6.12, // apf mod depth
             sampleRate);
             
-            earlyReflections.setTypeParameters(earliesTypeParams);
-            
-            decay = std::make_unique<Decay>(decayTypeParams);
+            earliesTypeParameters[index] = EarlyReflections::createTypeParameters(earliesTypeParams);
+            decays[index] = std::make_unique<Decay>(decayTypeParams);
             
             break;
         }
@@ -499,8 +740,6 @@ void Reverb::setReverbType(ReverbTypes type_)
             0.51f, // damping
             earliesLatestDelaySamples[Room::SMALLROOM]); // latestDelaySamples
             
-            earlyReflections.setTypeParameters(earliesTypeParams);
-            
             DecayTypeParameters decayTypeParams
             ("Digital Vintage", // name
             -0.68f, // diffusion
@@ -513,9 +752,8 @@ void Reverb::setReverbType(ReverbTypes type_)
             1.46f, // apf mod depth
             sampleRate);
             
-            earlyReflections.setTypeParameters(earliesTypeParams);
-
-            decay = std::make_unique<Decay>(decayTypeParams);
+            earliesTypeParameters[index] = EarlyReflections::createTypeParameters(earliesTypeParams);
+            decays[index] = std::make_unique<Decay>(decayTypeParams);
             
             break;
         }
@@ -527,8 +765,6 @@ void Reverb::setReverbType(ReverbTypes type_)
              0.6f, // damping
              earliesLatestDelaySamples[Room::SMALLROOM]); // latestDelaySamples
             
-            earlyReflections.setTypeParameters(earliesTypeParams);
-            
             DecayTypeParameters decayTypeParams
             ("Seasick", // name
             -0.94f, // diffusion
@@ -541,9 +777,8 @@ void Reverb::setReverbType(ReverbTypes type_)
             49.f, // apf mod depth
             sampleRate);
             
-            earlyReflections.setTypeParameters(earliesTypeParams);
-
-            decay = std::make_unique<Decay>(decayTypeParams);
+            earliesTypeParameters[index] = EarlyReflections::createTypeParameters(earliesTypeParams);
+            decays[index] = std::make_unique<Decay>(decayTypeParams);
             
             break;
         }
@@ -564,83 +799,102 @@ void Reverb::setReverbType(ReverbTypes type_)
             3, { 414, 92, 357 }, // post-allpassfilters
             0.87f); // comb scaler
             
-            earlyReflections.setTypeParameters(earliesTypeParams);
-            
-            decay = std::make_unique<Decay>(decayTypeParams);
+            earliesTypeParameters[index] = EarlyReflections::createTypeParameters(earliesTypeParams);
+            decays[index] = std::make_unique<Decay>(decayTypeParams);
 
             break;
         }
     }
-    
-    // decay setup with the UI parameters of the last decay
-    decay->setup(paramsDecay, sampleRate, blocksize);
-    
-    // setup delayline for decay
-    int delayOfDecay = earlyReflections.getLatestTapDelay() - decay->getEarliestCombDelay();
-    if (delayOfDecay < 0) delayOfDecay = 0;
-    decayDelaySamples = delayOfDecay;
-    delayedDecay.setDelay(decayDelaySamples());
-    
-    settingType = false;
 }
 
 
 // MARK: Parameter Changed
 // ------------------------------------------------------------------------------
-void Reverb::parameterChanged(const std::string& parameterID, float newValue)
+void Reverb::parameterChanged(const Parameters parameter, float newValue)
 {
-    if (parameterID == "reverb_decay")
-    {
-        DecayParameters params = decay->getParameters();
-        params.decayTimeMs = newValue * 1000.f; // sec to ms
-        decay->setParameters(params);
-    }
-    else if (parameterID == "reverb_predelay")
-    {
-        earlyReflections.getParameters().predelay.setRampTo(newValue * samplesPerMs, 0.03f); // ms to samples
-    }
-    else if (parameterID == "reverb_modrate")
-    {
-        DecayParameters params = decay->getParameters();
-        params.modulationRate = newValue;
-        decay->setParameters(params);
-    }
-    else if (parameterID == "reverb_moddepth")
-    {
-        DecayParameters params = decay->getParameters();
-        params.modulationDepth = newValue * 0.5f; // % to 0...50 samples
-        decay->setParameters(params);
-    }
-    else if (parameterID == "reverb_size")
-    {
-        earlyReflections.getParameters().size.setRampTo(newValue * 0.01f, 0.03f); // % to scaler
-        
-        int delayOfDecay = earlyReflections.getLatestTapDelay() - decay->getEarliestCombDelay();
-        if (delayOfDecay < 0) delayOfDecay = 0;
-        decayDelaySamples.setRampTo(delayOfDecay, 0.03f);
-    }
-    else if (parameterID == "reverb_feedback")
+    switch (parameter)
     {
-        earlyReflections.getParameters().feedback.setRampTo(newValue, 0.03f);
-    }
-    else if (parameterID == "reverb_lowcut")
-    {
-        lowcut.setCutoffFrequency(newValue);
-    }
-    else if (parameterID == "reverb_highcut")
-    {
-        highcut.setCutoffFrequency(newValue);
-    }
-    else if (parameterID == "reverb_multfreq")
-    {
-        inputMultiplier.setCenterFrequency(newValue);
-    }
-    else if (parameterID == "reverb_multgain")
-    {
-        inputMultiplier.setGain(newValue);
-    }
-    else if (parameterID == "reverb_type")
-    {
-        setReverbType(static_cast<ReverbTypes>(newValue));
+        case Parameters::DECAY:
+        {
+            DecayParameters params = decay->getParameters();
+            params.decayTimeMs = newValue * 1000.f; // sec to ms
+            decay->setParameters(params);
+            break;
+        }
+            
+        case Parameters::PREDELAY:
+        {
+            for (EarlyReflections& instance : earlyReflections)
+                instance.getParameters().predelay.setRampTo(newValue * samplesPerMs, 0.03f); // ms to samples
+            break;
+        }
+            
+        case Parameters::MODRATE:
+        {
+            DecayParameters params = decay->getParameters();
+            params.modulationRate = newValue;
+            decay->setParameters(params);
+            break;
+        }
+            
+        case Parameters::MODDEPTH:
+        {
+            DecayParameters params = decay->getParameters();
+            params.modulationDepth = newValue * 0.5f; // % to 0...50 samples
+            decay->setParameters(params);
+            break;
+        }
+            
+        case Parameters::SIZE:
+        {
+            for (EarlyReflections& instance : earlyReflections)
+                instance.getParameters().size.setRampTo(newValue * 0.01f, 0.03f); // % to scaler
+            
+            int delayOfDecay = earlies->getLatestTapDelay() - decay->getEarliestCombDelay();
+            if (delayOfDecay < 0) delayOfDecay = 0;
+            decayDelaySamples.setRampTo(delayOfDecay, 0.03f);
+            break;
+        }
+            
+        case Parameters::FEEDBACK:
+        {
+            for (EarlyReflections& instance : earlyReflections)
+                instance.getParameters().feedback.setRampTo(newValue, 0.03f);
+            break;
+        }
+            
+        case Parameters::LOWCUT:
+        {
+            lowcut.setCutoffFrequency(newValue);
+            break;
+        }
+            
+        case Parameters::HIGHCUT:
+        {
+            highcut.setCutoffFrequency(newValue);
+            break;
+        }
+            
+        case Parameters::MULTFREQ:
+        {
+            inputMultiplier.setCenterFrequency(newValue);
+            break;
+        }
+            
+        case Parameters::MULTGAIN:
+        {
+            inputMultiplier.setGain(newValue);
+            break;
+        }
+            
+        case Parameters::TYPE:
+        {
+            setReverbType(static_cast<ReverbTypes>(newValue));
+            break;
+        }
+            
+        // the mix is applied by the ReverbProcessor
+        case Parameters::MIX:
+            break;
     }
 }
@@ -19,7 +19,7 @@
  * •    SEASICK
  * •    ROOM
  *
- * You can look up the corresponding parameter sets in the BelaReverb::setReverbType() function.
+ * You can look up the corresponding parameter sets in the Reverb::createType() function. The early reflection parameters and the decays of all types are created in Reverb::setup(), switching the type crossfades between two instances of the early reflections and two decays without allocating.
  */
 // =======================================================================================
 #pragma once
@@ -196,6 +196,12 @@ static const unsigned int LFO_UPDATE_RATE = 8;
 /** @brief compensates for gain loss in effect chain */
 static const float32_t GAIN_COMPENSATION = 1.1f;
 
+/** @brief duration of the equal-power crossfade between the early reflections and decays of two reverb types in seconds */
+static const float TYPE_CROSSFADE_TIME = 0.2f;
+
+/** @brief number of samples per channel of the tap delay of inactive early reflections that are cleared per block */
+static const unsigned int EARLIES_CLEAR_CHUNK = 8192;
+
 /** @} */
 
 // =======================================================================================
@@ -341,9 +347,31 @@ public:
      * - damping (the amount of lowpass filtering)
      *
      * @param typeParameters_ a custom struct of type parameters
+     * @attention the parameters are not copied, the owner (Reverb) has to keep them alive
      */
     void setTypeParameters(const EarlyReflectionsTypeParameters& typeParameters_);
     
+    /**
+     * @brief prepares the early reflections to be faded in, the delay lines have to be cleared
+     *
+     * copies the momentary values and targets of the ramps, so both instances ramp in sync during the crossfade
+     *
+     * @param parameters_ the parameters of the early reflections that are fading out
+     */
+    void activate(const EarlyReflectionsParameters& parameters_);
+    
+    /** @brief marks the delay lines as dirty after the early reflections have been faded out */
+    void deactivate() { numClearedSamples = 0; }
+    
+    /**
+     * @brief clears a chunk of the tap delay, the allpass filters and the lowpass state with the last chunk
+     * @return true if all delay lines are cleared
+     */
+    bool clearNextChunk();
+    
+    /** @brief returns true if all delay lines are cleared */
+    bool isCleared() const { return numClearedSamples == TapDelayStereo::getBufferSize(); }
+    
     /**
      * @brief returns momentary set of parameters
      * @return momentary set of parameters
@@ -359,14 +387,23 @@ public:
         if (typeParameters) return typeParameters->latestDelaySamples * parameters.size.getTarget();
         else return 0;
     }
+    
+    /**
+     * @brief allocates an aligned copy of a set of type parameters
+     * @param typeParameters_ the type parameters to copy
+     * @return the owning pointer to the copy
+     */
+    static EarlyReflectionsTypeParametersPtr createTypeParameters(const EarlyReflectionsTypeParameters& typeParameters_);
 
 private:
     EarlyReflectionsParameters parameters; ///< a custom struct of user definable parameters
-    EarlyReflectionsTypeParametersPtr typeParameters = nullptr; ///< a custom struct of reverb type parameters, set when changing the reverb typepöp
+    const EarlyReflectionsTypeParameters* typeParameters = nullptr; ///< a custom struct of reverb type parameters, set when changing the reverb type
 
     TapDelayStereo tapDelay; ///< a helper class to read the tap delays
     OnePoleLowpassStereo lowpass; ///< a one pole lowpass filter in stereo format, synchronized channel processing
     AllpassFilterDualMono allpass; ///< a simple allpass filter in dual mono format, indepent channel processing
+    
+    unsigned int numClearedSamples = 0; ///< number of samples of the tap delay that have been cleared since the early reflections were faded out
 };
 
 
@@ -523,6 +560,25 @@ public:
      */
     float32x2_t processAudioSamples(const float32x2_t input_, const unsigned int& sampleIndex_);
     
+    /**
+     * @brief prepares the decay to be faded in after it hasn't been processed for a while
+     *
+     * resets the filter states, the delay lines have to be cleared
+     */
+    void activate();
+    
+    /** @brief marks the delay lines as dirty after the decay has been faded out */
+    void deactivate() { numClearedFilters = 0; }
+    
+    /**
+     * @brief clears the delay line of one filter, used to spread the clearing of an inactive decay over several blocks
+     * @return true if all delay lines are cleared
+     */
+    bool clearNextFilter();
+    
+    /** @brief returns true if all delay lines are cleared */
+    bool isCleared() const { return numClearedFilters == getNumFilters(); }
+    
     /**
      * @brief sets a new set of parameters
      *
@@ -560,6 +616,12 @@ private:
      * @return the alligned unique pointer to an array of combfilters
      */
     CombFilterDualStereoPtr createAlignedCombFilters(size_t count);
+    
+    /** @brief returns the number of all combfilters and allpassfilters */
+    unsigned int getNumFilters() const
+    {
+        return typeParameters.numCombFilters + typeParameters.numPreAllpassFilters + typeParameters.numPostAllpassFilters;
+    }
 
 private:
     float fs_inv, samplesPerMs_inv;
@@ -575,6 +637,8 @@ private:
     
     float modulationIncr = 0.f; ///< step, the phase moves, when calling modulation, calculated out of the modrate
     bool modulationEnabled = false;
+    
+    unsigned int numClearedFilters = 0; ///< number of filters whose delay lines have been cleared since the decay was faded out
 };
 
 
@@ -609,6 +673,17 @@ public:
      */
     float32x2_t processAudioSamples(float32x2_t input_, const unsigned int& sampleIndex_);
     
+    /**
+     * @brief processes a whole block of non-interleaved stereo audio samples
+     *
+     * the type-switch check is done once per block, the samplewise function above stays as the reference path
+     *
+     * @param input_ two pointers to the left and right input channel
+     * @param output_ two pointers to the left and right output channel, may be the same as the input
+     * @param numFrames_ the number of samples per channel to process
+     */
+    void processAudioBlock(const float* const input_[2], float* const output_[2], const unsigned int numFrames_);
+    
     /**
      * @brief handles new incoming values from UI
      *
@@ -617,37 +692,91 @@ public:
      *
      * @warning call this blockwise only!
      *
-     * @param parameterID the name of the changed parameter
+     * @param parameter the index of the changed parameter, resolved from its ID once at setup
      * @param newValue the UI value
      */
-    void parameterChanged(const std::string& parameterID, float newValue);
+    void parameterChanged(const Parameters parameter, float newValue);
     
     /**
      * @brief sets a new reverb type
      *
-     * the fixed parameters for every type of reverb are defined here,
-       they are called type parameters different to the normal parameters that can be changed by the user,
-       the function clears the type parameters of each EarlyReflections and Decay and sets up new instances of them
+     * starts an equal-power crossfade from the early reflections and the decay of the momentary type
+       to a second instance of the early reflections and the (preallocated) decay of the new type,
+       nothing is allocated, the reverb keeps on sounding
+     *
+     * the inactive instances are cleared blockwise, so the crossfade may start a few blocks later,
+       it also waits for a crossfade that is still running, unless that one fades out the new type, then it is reversed
      *
      * @param type_  the Reverb Type
      */
     void setReverbType(ReverbTypes type_);
     
 private:
+    /**
+     * @brief creates the type parameters of the early reflections and the decay of a reverb type
+     *
+     * the fixed parameters for every type of reverb are defined here,
+       they are called type parameters different to the normal parameters that can be changed by the user
+     *
+     * @param type_  the Reverb Type
+     */
+    void createType(ReverbTypes type_);
+    
+    /**
+     * @brief processes the early reflections of the momentary type and, while crossfading, the ones of the previous type
+     *
+     * @param input_  a vector of a pair of floats
+     * @param sampleIndex_ (0...blocksize) the momentary index of the audioblock sample
+     * @return the processed audio samples
+     */
+    float32x2_t processEarlies(const float32x2_t input_, const unsigned int& sampleIndex_);
+    
+    /**
+     * @brief processes the decay of the momentary type and, while crossfading, the decay of the previous type
+     *
+     * advances the crossfade of the early reflections and the decays, call this after processEarlies()
+     *
+     * @param input_  a vector of a pair of floats
+     * @param sampleIndex_ (0...blocksize) the momentary index of the audioblock sample
+     * @return the processed audio samples
+     */
+    float32x2_t processDecay(const float32x2_t input_, const unsigned int& sampleIndex_);
+    
+    /**
+     * @brief clears the delay lines of the inactive decays and early reflections, call this blockwise
+     *
+     * clears one filter of one decay and one chunk of the early reflections per block, the ones of a pending type first,
+       then starts the crossfade to the pending type as soon as possible
+     */
+    void clearInactiveDecays();
+    
+    /** @brief starts the crossfade to the pending type if its decay and the inactive early reflections are cleared */
+    void startPendingType();
+    
+    /** @brief sets the delay of the decay, so it starts after the latest early reflection */
+    void updateDecayDelay();
+    
     float sampleRate; ///< the sample rate
     unsigned int blocksize; ///< number of samples in one block
     float samplesPerMs; ///< num processed samples per milisecond
     
-    EarlyReflections earlyReflections;
-    std::unique_ptr<Decay> decay = nullptr;
+    std::array<EarlyReflections, 2> earlyReflections; ///< two instances, crossfaded when switching the type
+    std::array<EarlyReflections::EarlyReflectionsTypeParametersPtr, NUM_TYPES> earliesTypeParameters; ///< type parameters of the early reflections, one set per reverb type
+    EarlyReflections* earlies = nullptr; ///< the early reflections of the momentary reverb type
+    EarlyReflections* fadingEarlies = nullptr; ///< the early reflections of the previous reverb type while they are fading out, nullptr otherwise
+    std::array<std::unique_ptr<Decay>, NUM_TYPES> decays; ///< the decays of all reverb types, allocated in setup
+    Decay* decay = nullptr; ///< the decay of the momentary reverb type
+    Decay* fadingDecay = nullptr; ///< the decay of the previous reverb type while it is fading out, nullptr otherwise
+    Decay* pendingDecay = nullptr; ///< the decay of a type that is waiting for its delay lines to be cleared, nullptr otherwise
+    ReverbTypes pendingType = ReverbTypes::CHURCH; ///< the type of the pending decay
+    float crossfadePhase = 0.f; ///< phase of the crossfade, 0...PI/2
+    float crossfadeIncr = 0.f; ///< increment of the crossfade phase per sample
     SimpleDelayStereo delayedDecay; ///< delay of decay, used to sync decay to earlies
     LinearRamp decayDelaySamples;
     
     ParametricEQStereo inputMultiplier;
     ButterworthLowcutStereo lowcut;
     ButterworthHighcutStereo highcut;
-    
-    bool settingType = false;
 };
 
 } // namespace Reverberation
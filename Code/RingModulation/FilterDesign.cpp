@@ -0,0 +1,297 @@
+#include "FilterDesign.h"
+
+#include <map>
+
+// =======================================================================================
+// MARK: - KAISER WINDOW
+// =======================================================================================
+
+/** @brief The modified Bessel function of the first kind and order 0, as a power series. */
+static double besselI0(const double x_)
+{
+    double sum = 1.0, term = 1.0;
+    const double halfX = 0.5 * x_;
+    
+    for (uint k = 1; k < 50; ++k)
+    {
+        term *= (halfX / k) * (halfX / k);
+        sum += term;
+        
+        if (term < 1e-12 * sum) break;
+    }
+    
+    return sum;
+}
+
+
+/** @brief Returns the Kaiser window at the given offset from the center. */
+static double getKaiserWindow(const double offset_, const double halfLength_, const float beta_)
+{
+    if (halfLength_ <= 0.0) return 1.0;
+    
+    const double position = offset_ / halfLength_;
+    
+    return besselI0(beta_ * std::sqrt(std::max(0.0, 1.0 - position * position))) / besselI0(beta_);
+}
+
+
+float getKaiserBeta(const float attenuation_)
+{
+    if (attenuation_ > 50.f) return 0.1102f * (attenuation_ - 8.7f);
+    else if (attenuation_ >= 21.f) return 0.5842f * powf(attenuation_ - 21.f, 0.4f) + 0.07886f * (attenuation_ - 21.f);
+    else return 0.f;
+}
+
+
+float getKaiserAttenuation(const uint length_, const float transitionWidth_)
+{
+    return 14.36f * transitionWidth_ * (float)(length_ - 1) + 7.95f;
+}
+
+
+float getKaiserTransitionWidth(const uint length_, const float attenuation_)
+{
+    return (attenuation_ - 7.95f) / (14.36f * (float)(length_ - 1));
+}
+
+
+void designKaiserLowpass(float* coefficients_, const uint length_, const float cutoff_, const float beta_)
+{
+    const double center = 0.5 * (length_ - 1);
+    double sum = 0.0;
+    
+    for (uint n = 0; n < length_; ++n)
+    {
+        const double offset = n - center;
+        
+        // windowed sinc, 2 * cutoff * sinc(2 * cutoff * offset)
+        double sinc = 2.0 * cutoff_;
+        if (offset != 0.0) sinc = std::sin(2.0 * M_PI * cutoff_ * offset) / (M_PI * offset);
+        
+        const double coefficient = sinc * getKaiserWindow(offset, center, beta_);
+        
+        coefficients_[n] = (float)coefficient;
+        sum += coefficient;
+    }
+    
+    // normalize to a DC gain of 1
+    for (uint n = 0; n < length_; ++n) coefficients_[n] = (float)(coefficients_[n] / sum);
+}
+
+
+void designHalfbandLowpass(float* coefficients_, const uint length_, const float beta_)
+{
+    const uint numTaps = length_ - 1;
+    const uint center = (numTaps - 1) / 2;
+    double sum = 0.0;
+    
+    for (uint n = 0; n < length_; ++n)
+    {
+        const int offset = (int)n - (int)center;
+        
+        // every even offset but the center is a zero of the sinc
+        if (n >= numTaps || offset == 0 || offset % 2 == 0)
+        {
+            coefficients_[n] = 0.f;
+            continue;
+        }
+        
+        const double coefficient = std::sin(0.5 * M_PI * offset) / (M_PI * offset) * getKaiserWindow(offset, center, beta_);
+        
+        coefficients_[n] = (float)coefficient;
+        sum += coefficient;
+    }
+    
+    // normalize the odd offsets to 0.5, together with the center the DC gain is 1
+    for (uint n = 0; n < numTaps; ++n) coefficients_[n] = (float)(coefficients_[n] * 0.5 / sum);
+    
+    coefficients_[center] = 0.5f;
+}
+
+
+// =======================================================================================
+// MARK: - ALLPASS HALF-BAND
+// =======================================================================================
+
+/**
+ * @brief Computes the selectivity and the nome of an elliptic half-band filter.
+ * @param transitionWidth_ the width of the transition band, as a fraction of the sample rate of the filter
+ * @param k_ receives the selectivity factor
+ * @param q_ receives the nome, approximated by its series
+ */
+static void getEllipticParameters(const double transitionWidth_, double& k_, double& q_)
+{
+    k_ = std::tan((1.0 - 2.0 * transitionWidth_) * M_PI * 0.25);
+    k_ *= k_;
+    
+    const double kk = std::pow(1.0 - k_ * k_, 0.25);
+    const double e = 0.5 * (1.0 - kk) / (1.0 + kk);
+    const double e4 = e * e * e * e;
+    
+    q_ = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+}
+
+
+uint getAllpassHalfbandSize(const float attenuation_, const float transitionWidth_)
+{
+    double k, q;
+    getEllipticParameters(transitionWidth_, k, q);
+    
+    // the order of the elliptic filter, odd and at least 3
+    const double ripple = std::pow(10.0, -attenuation_ / 10.0);
+    const double a = ripple / (1.0 - ripple);
+    
+    uint order = (uint)std::max(3.0, std::ceil(std::log(a * a / 16.0) / std::log(q)));
+    if (order % 2 == 0) ++order;
+    
+    // (order - 1) / 2 coefficients, one more if the branches would differ in length
+    const uint numCoefficients = (order - 1) / 2;
+    
+    return numCoefficients + numCoefficients % 2;
+}
+
+
+void designAllpassHalfband(float* coefficients_, const uint numCoefficients_, const float transitionWidth_)
+{
+    double k, q;
+    getEllipticParameters(transitionWidth_, k, q);
+    
+    const uint order = 2 * numCoefficients_ + 1;
+    
+    for (uint n = 0; n < numCoefficients_; ++n)
+    {
+        const uint c = n + 1;
+        double numerator = 0.0, denominator = 0.0;
+        
+        // theta function series, the powers of the nome decay fast
+        for (uint i = 0; ; ++i)
+        {
+            const double power = std::pow(q, (double)(i * (i + 1)));
+            numerator += ((i % 2) ? -power : power) * std::sin((2 * i + 1) * c * M_PI / order);
+            
+            if (power < 1e-30) break;
+        }
+        
+        for (uint i = 1; ; ++i)
+        {
+            const double power = std::pow(q, (double)(i * i));
+            denominator += ((i % 2) ? -power : power) * std::cos(2 * i * c * M_PI / order);
+            
+            if (power < 1e-30) break;
+        }
+        
+        const double w = numerator * std::pow(q, 0.25) / (denominator + 0.5);
+        const double ww = w * w;
+        const double x = std::sqrt((1.0 - ww * k) * (1.0 - ww / k)) / (1.0 + ww);
+        
+        coefficients_[n] = (float)((1.0 - x) / (1.0 + x));
+    }
+}
+
+
+// =======================================================================================
+// MARK: - CACHED DESIGNS
+// =======================================================================================
+
+/**
+ * @brief Returns a cached design or designs it.
+ * @param length_ the length of the filter
+ * @param ratio_ the ratio of a lowpass, 0 for a half-band filter
+ * @param design_ writes the coefficients of the filter into the given array
+ */
+template <class Design>
+static const float* getCachedDesign(const uint length_, const uint ratio_, Design design_)
+{
+    // designs are never erased, so the coefficients of a map node stay where they are
+    static std::mutex mutex;
+    static std::map<std::pair<uint, uint>, std::vector<float>> designs;
+    
+    std::lock_guard<std::mutex> lock(mutex);
+    
+    auto design = designs.find({ length_, ratio_ });
+    
+    if (design == designs.end())
+    {
+        std::vector<float> coefficients(length_);
+        design_(coefficients.data());
+        
+        design = designs.emplace(std::make_pair(length_, ratio_), std::move(coefficients)).first;
+    }
+    
+    return design->second.data();
+}
+
+
+const float* getOversamplingLowpass(const uint filterLength_, const uint ratio_)
+{
+    if (filterLength_ < 2 || filterLength_ > MAX_FILTER_LENGTH || ratio_ == 0 || ratio_ > MAX_RATE_CONVERSION_RATIO)
+        return nullptr;
+    
+    return getCachedDesign(filterLength_, ratio_, [=](float* coefficients_)
+    {
+        // band edges as fractions of the oversampled rate
+        const float stopband = FIR_DESIGN_STOPBAND / ratio_;
+        float passband = stopband - getKaiserTransitionWidth(filterLength_, FIR_DESIGN_ATTENUATION);
+        float attenuation = FIR_DESIGN_ATTENUATION;
+        
+        // keep the passband, the filter is too short for the attenuation
+        if (passband < FIR_DESIGN_MIN_PASSBAND / ratio_)
+        {
+            passband = FIR_DESIGN_MIN_PASSBAND / ratio_;
+            attenuation = getKaiserAttenuation(filterLength_, stopband - passband);
+        }
+        
+        designKaiserLowpass(coefficients_, filterLength_, 0.5f * (passband + stopband), getKaiserBeta(attenuation));
+    });
+}
+
+
+const float* getHalfbandLowpass(const uint filterLength_)
+{
+    if (filterLength_ < 8 || filterLength_ > MAX_FILTER_LENGTH || filterLength_ % 4 != 0)
+        return nullptr;
+    
+    return getCachedDesign(filterLength_, 0, [=](float* coefficients_)
+    {
+        designHalfbandLowpass(coefficients_, filterLength_, getKaiserBeta(FIR_DESIGN_ATTENUATION));
+    });
+}
+
+
+uint getHalfbandStageLength(const uint firstStageLength_, const uint stage_)
+{
+    if (stage_ == 0) return firstStageLength_;
+    
+    // the passband edge of the first stage, as a fraction of the base sample rate:
+    // the transition band lies symmetrically around the base rate's Nyquist frequency
+    const float passband = std::max(FIR_DESIGN_MIN_PASSBAND, 0.5f - getKaiserTransitionWidth(firstStageLength_ - 1, FIR_DESIGN_ATTENUATION));
+    
+    // stage k runs at 2^(k+1) times the base rate and only has to keep the images around 2^k times the base rate away
+    const float stageRatio = (float)(2u << stage_);
+    const float transitionWidth = (0.5f * stageRatio - 2.f * passband) / stageRatio;
+    
+    const uint numTaps = (uint)ceilf((FIR_DESIGN_ATTENUATION - 7.95f) / (14.36f * transitionWidth)) + 1;
+    
+    // an odd number of taps with the center on an odd index, plus the zero at the end
+    const uint length = (numTaps + 1 + 3) / 4 * 4;
+    
+    return std::max(8u, std::min(length, firstStageLength_));
+}
+
+
+const float* getAllpassHalfbandStage(const uint stage_, uint& numCoefficients_)
+{
+    // stage k runs at 2^(k+1) times the base rate, its transition band lies symmetrically around 2^k times the base rate:
+    // the first stage passes up to the passband edge, the following ones up to the stopband edge of the first stage,
+    // so the images of the transition band of the first stage fall into their stopbands
+    const float passband = (stage_ == 0) ? ALLPASS_DESIGN_PASSBAND : 1.f - ALLPASS_DESIGN_PASSBAND;
+    const float transitionWidth = 0.5f - passband / (float)(1u << stage_);
+    
+    numCoefficients_ = std::min(getAllpassHalfbandSize(FIR_DESIGN_ATTENUATION, transitionWidth), MAX_ALLPASS_COEFFICIENTS);
+    const uint numCoefficients = numCoefficients_;
+    
+    return getCachedDesign(numCoefficients, stage_, [=](float* coefficients_)
+    {
+        designAllpassHalfband(coefficients_, numCoefficients, transitionWidth);
+    });
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include "../Functions.h"
+
+/**
+ * @file FilterDesign.h
+ * @brief Kaiser windowed-sinc lowpass filters for the sample rate converters, designed at runtime.
+ *
+ * The band edges are given as fractions of the base sample rate, so a design only depends on the filter
+ * length and the ratio and fits every sample rate. Designs are cached, every configuration is designed once
+ * and the returned coefficients stay valid for the lifetime of the program.
+ *
+ * The low latency alternative are elliptic half-band filters made of two branches of allpass sections.
+ */
+
+// =======================================================================================
+// MARK: - DESIGN PARAMETERS
+// =======================================================================================
+
+/** @brief the highest up- and downsampling ratio of the sample rate converters */
+static const uint MAX_RATE_CONVERSION_RATIO = 16;
+
+/** @brief the number of ratios the sample rate converters prepare filters for, the powers of two up to MAX_RATE_CONVERSION_RATIO */
+static const uint NUM_RATE_CONVERSION_RATIOS = 5;
+static_assert((1u << (NUM_RATE_CONVERSION_RATIOS - 1)) == MAX_RATE_CONVERSION_RATIO, "the highest ratio has to be the last power of two");
+
+/** @brief the longest filter of the sample rate converters */
+static const uint MAX_FILTER_LENGTH = 256;
+
+/** @brief the stopband attenuation in dB the designer aims for, shorter filters fall behind it */
+static const float FIR_DESIGN_ATTENUATION = 60.f;
+
+/** @brief the lowest passband edge, as a fraction of the base sample rate, before the attenuation is given up */
+static const float FIR_DESIGN_MIN_PASSBAND = 0.3f;
+
+/** @brief the stopband edge of the oversampling filters, as a fraction of the base sample rate (its Nyquist frequency) */
+static const float FIR_DESIGN_STOPBAND = 0.5f;
+
+/** @brief the passband edge of the allpass half-band cascades, as a fraction of the base sample rate */
+static const float ALLPASS_DESIGN_PASSBAND = 0.43f;
+
+/** @brief the most coefficients of an allpass half-band filter, both branches together */
+static const uint MAX_ALLPASS_COEFFICIENTS = 16;
+
+
+// =======================================================================================
+// MARK: - KAISER WINDOW
+// =======================================================================================
+
+/**
+ * @brief Returns the Kaiser window shape parameter for a stopband attenuation.
+ * @param attenuation_ The stopband attenuation in dB.
+ * @return beta, 0 (a rectangular window) below 21 dB.
+ */
+float getKaiserBeta(const float attenuation_);
+
+/**
+ * @brief Estimates the stopband attenuation of a Kaiser lowpass.
+ * @param length_ The number of taps.
+ * @param transitionWidth_ The width of the transition band, as a fraction of the sample rate of the filter.
+ * @return The attenuation in dB.
+ */
+float getKaiserAttenuation(const uint length_, const float transitionWidth_);
+
+/**
+ * @brief Estimates the width of the transition band of a Kaiser lowpass.
+ * @param length_ The number of taps.
+ * @param attenuation_ The stopband attenuation in dB.
+ * @return The width, as a fraction of the sample rate of the filter.
+ */
+float getKaiserTransitionWidth(const uint length_, const float attenuation_);
+
+/**
+ * @brief Designs a linear phase lowpass with a Kaiser windowed sinc, normalized to a DC gain of 1.
+ * @param coefficients_ Receives `length_` coefficients.
+ * @param length_ The number of taps.
+ * @param cutoff_ The cutoff frequency, as a fraction of the sample rate of the filter (0 to 0.5).
+ * @param beta_ The Kaiser window shape parameter, see `getKaiserBeta()`.
+ */
+void designKaiserLowpass(float* coefficients_, const uint length_, const float cutoff_, const float beta_);
+
+/**
+ * @brief Designs a half-band lowpass with a Kaiser windowed sinc.
+ *
+ * The cutoff is at a quarter of the sample rate, every second coefficient is 0 except for the center one,
+ * which is exactly 0.5. The filter has `length_ - 1` taps, the last coefficient is 0 to round the length
+ * up to a multiple of 4.
+ *
+ * @param coefficients_ Receives `length_` coefficients.
+ * @param length_ The number of taps plus one, a multiple of 4 and at least 8.
+ * @param beta_ The Kaiser window shape parameter, see `getKaiserBeta()`.
+ */
+void designHalfbandLowpass(float* coefficients_, const uint length_, const float beta_);
+
+
+// =======================================================================================
+// MARK: - ALLPASS HALF-BAND
+// =======================================================================================
+
+/**
+ * @brief Returns the number of coefficients an allpass half-band filter needs for a stopband attenuation.
+ * @param attenuation_ The stopband attenuation in dB.
+ * @param transitionWidth_ The width of the transition band, as a fraction of the sample rate of the filter (0 to 0.5).
+ * @return The number of coefficients, rounded up to an even number, so both branches have the same number of sections.
+ */
+uint getAllpassHalfbandSize(const float attenuation_, const float transitionWidth_);
+
+/**
+ * @brief Designs an elliptic half-band lowpass as two branches of first order allpass sections.
+ *
+ * H(z) = 0.5 * (A0(z^2) + z^-1 * A1(z^2)), every branch is a chain of sections (a + z^-2) / (1 + a * z^-2).
+ * The even coefficients belong to A0, the odd ones to A1. The transition band lies symmetrically around a quarter
+ * of the sample rate and the passband is practically flat, but the phase isn't linear. A 2x stage runs both branches
+ * at the lower rate, a few coefficients reach the attenuation of a long FIR filter.
+ * @cite Valenzuela, Constantinides: "Digital signal processing schemes for efficient interpolation and decimation"
+ *
+ * @param coefficients_ Receives `numCoefficients_` coefficients in ascending order.
+ * @param numCoefficients_ The number of coefficients, see `getAllpassHalfbandSize()`.
+ * @param transitionWidth_ The width of the transition band, as a fraction of the sample rate of the filter (0 to 0.5).
+ */
+void designAllpassHalfband(float* coefficients_, const uint numCoefficients_, const float transitionWidth_);
+
+
+// =======================================================================================
+// MARK: - CACHED DESIGNS
+// =======================================================================================
+
+/**
+ * @brief Returns the lowpass of a sample rate converter, designed on the first call for the configuration.
+ *
+ * The filter runs at `ratio_` times the base sample rate and has its stopband edge at the Nyquist frequency
+ * of the base rate. The transition band is as narrow as `FIR_DESIGN_ATTENUATION` allows for the length,
+ * but the passband edge doesn't drop below `FIR_DESIGN_MIN_PASSBAND`, short filters with high ratios
+ * trade attenuation for it.
+ *
+ * @param filterLength_ The number of taps, at most MAX_FILTER_LENGTH.
+ * @param ratio_ The up- or downsampling ratio.
+ * @return The coefficients, nullptr for an invalid configuration.
+ */
+const float* getOversamplingLowpass(const uint filterLength_, const uint ratio_);
+
+/**
+ * @brief Returns the half-band lowpass of a 2x stage with `FIR_DESIGN_ATTENUATION`, designed on the first call.
+ * @param filterLength_ The length, a multiple of 4, at least 8 and at most MAX_FILTER_LENGTH.
+ * @return The coefficients, see `designHalfbandLowpass()`, nullptr for an invalid length.
+ */
+const float* getHalfbandLowpass(const uint filterLength_);
+
+/**
+ * @brief Returns the length of a stage of a half-band cascade.
+ *
+ * The first stage determines the passband edge. The transition bands of the following stages are much wider,
+ * since they only have to remove the images around the previous sample rates, so they reach the same
+ * attenuation with fewer taps.
+ *
+ * @param firstStageLength_ The length of the first stage.
+ * @param stage_ The index of the stage, 0 is the stage at the base sample rate.
+ * @return The length, a multiple of 4 and at least 8.
+ */
+uint getHalfbandStageLength(const uint firstStageLength_, const uint stage_);
+
+/**
+ * @brief Returns the allpass half-band filter of a stage of an allpass cascade, designed on the first call.
+ *
+ * Stage k runs at 2^(k+1) times the base rate and attenuates the images around 2^k times the base rate by
+ * `FIR_DESIGN_ATTENUATION`. The first stage keeps the passband up to `ALLPASS_DESIGN_PASSBAND`, the transition bands
+ * of the following stages are much wider and they get by with two to four coefficients.
+ *
+ * @param stage_ The index of the stage, 0 is the stage at the base sample rate.
+ * @param numCoefficients_ Receives the number of coefficients, even and at most MAX_ALLPASS_COEFFICIENTS.
+ * @return The coefficients, see `designAllpassHalfband()`.
+ */
+const float* getAllpassHalfbandStage(const uint stage_, uint& numCoefficients_);
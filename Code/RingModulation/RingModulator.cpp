@@ -15,56 +15,114 @@ void LFO::setup(const float freq_, const float sampleRate_)
 }
 
 
-float LFO::getNextValue()
+void LFO::getNextBlock(float* output_, const uint numSamples_)
 {
-    float output = (this->*getValue)() * amplitude;
+    // the random waveform draws its values sample by sample
+    if (waveform == RANDOM)
+    {
+        getRandomBlock(output_, numSamples_);
+        return;
+    }
     
+    for (uint n = 0; n < numSamples_; ++n)
+    {
+        output_[n] = phase;
+        advancePhase();
+    }
+    
+    // the waveform is selected once per block
+    switch (waveform)
+    {
+        case TRIANGLE:
+        {
+            applyWaveform<&LFO::getTriangle>(output_, numSamples_);
+            break;
+        }
+            
+        case SAW:
+        {
+            applyWaveform<&LFO::getSaw>(output_, numSamples_);
+            break;
+        }
+            
+        case PULSE:
+        {
+            applyWaveform<&LFO::getPulse>(output_, numSamples_);
+            break;
+        }
+            
+        case SINE:
+        default:
+        {
+            applyWaveform<&LFO::getSine>(output_, numSamples_);
+            break;
+        }
+    }
+}
+
+
+template <float32x4_t (*getWaveform)(const float32x4_t)>
+void LFO::applyWaveform(float* values_, const uint numSamples_) const
+{
+    for (uint n = 0; n < numSamples_; n += 4)
+        vst1q_f32(values_ + n, vmulq_n_f32(getWaveform(vld1q_f32(values_ + n)), amplitude));
+}
+
+
+void LFO::advancePhase()
+{
     phase += increment;
-    if (phase >= TWOPI) 
+    if (phase >= TWOPI)
     {
         phase -= TWOPI;
         phaseWrapped = true;
     }
-    
-    return output;
 }
 
 
-float LFO::getSine()
+float32x4_t LFO::getSine(const float32x4_t phase_)
 {
-    return approximateSine(phase);
+    return approximateSine(phase_);
 }
 
 
-float LFO::getTriangle()
+float32x4_t LFO::getTriangle(const float32x4_t phase_)
 {
-    if (phase < PI) return TWOoPI * phase - 1.f;
-    else return -TWOoPI * phase + 3.f;
+    // rising in the first half of the period, falling in the second one
+    const float32x4_t rising = vsubq_f32(vmulq_n_f32(phase_, TWOoPI), vdupq_n_f32(1.f));
+    const float32x4_t falling = vaddq_f32(vmulq_n_f32(phase_, -TWOoPI), vdupq_n_f32(3.f));
+    
+    return vbslq_f32(vcltq_f32(phase_, vdupq_n_f32(PI)), rising, falling);
 }
 
 
-float LFO::getSaw()
+float32x4_t LFO::getSaw(const float32x4_t phase_)
 {
-    float value = phase * PI_INV;
-    if (phase > PI) value -= 2.f;
-    return value;
+    const float32x4_t value = vmulq_n_f32(phase_, PI_INV);
+    
+    return vbslq_f32(vcltq_f32(vdupq_n_f32(PI), phase_), vsubq_f32(value, vdupq_n_f32(2.f)), value);
 }
 
 
-float LFO::getPulse()
+float32x4_t LFO::getPulse(const float32x4_t phase_)
 {
-    return (phase < PI) ? 1.f : -1.f;
+    return vbslq_f32(vcltq_f32(phase_, vdupq_n_f32(PI)), vdupq_n_f32(1.f), vdupq_n_f32(-1.f));
 }
 
 
-float LFO::getRandom()
+void LFO::getRandomBlock(float* output_, const uint numSamples_)
 {
-    if (phaseWrapped)
+    for (uint n = 0; n < numSamples_; ++n)
     {
-        nextValue = rand() * TWO_RAND_MAX_INVERSED - 1.f;
-        phaseWrapped = false;
+        if (phaseWrapped)
+        {
+            nextValue = random.getBipolar();
+            phaseWrapped = false;
+        }
+        
+        output_[n] = nextValue * amplitude;
+        advancePhase();
     }
-    return nextValue;
 }
 
 
@@ -92,12 +150,6 @@ void LFO::setAmplitude(const float amp_)
 void LFO::setWaveform(Waveform waveform_)
 {
     waveform = waveform_;
-    if (waveform_ == SINE) getValue = &LFO::getSine;
-    else if (waveform_ == TRIANGLE) getValue = &LFO::getTriangle;
-    else if (waveform_ == SAW) getValue = &LFO::getSaw;
-    else if (waveform_ == PULSE) getValue = &LFO::getPulse;
-    else if (waveform_ == RANDOM) getValue = &LFO::getRandom;
-    else getValue = &LFO::getSine;
 }
 
 
@@ -120,32 +172,52 @@ void Oscillator::setup(const float freq_, const float sampleRate_)
     setFrequency(freq_);
     
     modulator.setup(1.f, sampleRate_);
+    
+    // the tails of the blocks are computed four samples at a time
+    modulation.fill(0.f);
+    phases.fill(0.f);
 }
 
 
-float32x2_t Oscillator::getNextValues()
+void Oscillator::getNextBlock(float32x2_t* output_, const uint numSamples_)
 {
-    float32x2_t output;
+    modulator.getNextBlock(modulation.data(), numSamples_);
     
-    output[0] = approximateSine(phase);
+    // map the LFO to the multiplier of the phase increment, like mapValue(value + 1, 0, 2, 0.00001, 2),
+    // modulation increment multipliere should never be 0!
+    static const float MIN_MODULATION = 0.00001f;
+    static const float MAX_MODULATION = 2.f;
     
-    if (phaseIsShifted)
+    for (uint n = 0; n < numSamples_; n += 4)
     {
-        float shiftedPhase = phase + phaseShift;
-        if (shiftedPhase >= TWOPI) shiftedPhase -= TWOPI;
-        output[1] = approximateSine(shiftedPhase);
+        float32x4_t factor = vaddq_f32(vld1q_f32(&modulation[n]), vdupq_n_f32(1.f));
+        factor = vaddq_f32(vmulq_n_f32(vmulq_n_f32(factor, MAX_MODULATION - MIN_MODULATION), 0.5f), vdupq_n_f32(MIN_MODULATION));
+        factor = vmaxq_f32(vminq_f32(factor, vdupq_n_f32(MAX_MODULATION)), vdupq_n_f32(MIN_MODULATION));
+        vst1q_f32(&modulation[n], factor);
     }
-    else
+    
+    // the phase is accumulated sample by sample, so blocks of any size produce the same values
+    for (uint n = 0; n < numSamples_; ++n)
     {
-        output[1] = output[0];
+        phases[n] = phase;
+        phase += increment * modulation[n];
+        if (phase >= TWOPI) phase -= TWOPI;
     }
     
-    // modulation increment multipliere should never be 0!
-    float modulation = mapValue(modulator.getNextValue() + 1.f, 0.f, 2.f, 0.00001f, 2.f);
-    phase += increment * (modulation);
-    if (phase >= TWOPI) phase -= TWOPI;
+    // both channels of two samples per quad, the right channel is shifted, an odd last sample fills both halves
+    const float32x4_t shift = makeQuad(0.f, phaseShift, 0.f, phaseShift);
     
-    return output;
+    for (uint n = 0; n < numSamples_; n += 2)
+    {
+        const uint next = std::min(n + 1, numSamples_ - 1);
+        
+        float32x4_t phase4 = vaddq_f32(makeQuad(phases[n], phases[n], phases[next], phases[next]), shift);
+        phase4 = vbslq_f32(vcgeq_f32(phase4, vdupq_n_f32(TWOPI)), vsubq_f32(phase4, vdupq_n_f32(TWOPI)), phase4);
+        
+        const float32x4_t output = approximateSine(phase4);
+        output_[n] = vget_low_f32(output);
+        output_[next] = vget_high_f32(output);
+    }
 }
 
 
@@ -170,7 +242,6 @@ void Oscillator::setFrequency(const float freq_)
 void Oscillator::setPhaseShift(const float shift_)
 {
     phaseShift = shift_;
-    phaseIsShifted = phaseShift > 0.f ? true : false;
 }
 
 
@@ -185,13 +256,28 @@ bool RingModulator::setup(const float sampleRate_, const uint blockSize_)
     sampleRate = sampleRate_;
     blockSize = blockSize_;
     
-    modulator.setup(5.f, sampleRate_);
-    
     bitCrusher.setSmoothing(30.f);
     
-    // setup oversampling objects
-    interpolator.setup(sampleRate_, 2, OVERSAMPLING_FILTER_LENGTH);
-    decimator.setup(sampleRate_, 2, OVERSAMPLING_FILTER_LENGTH);
+    // setup oversampling objects, they precompute the filters of every ratio,
+    // the second path only runs while it is faded out after a switch of the ratio or the resampler
+    for (OversamplingPath& path : paths)
+    {
+        path.modulator.setup(5.f, sampleRate_);
+        path.interpolator.setup(sampleRate_, 2, OVERSAMPLING_FILTER_LENGTH);
+        path.decimator.setup(sampleRate_, 2, OVERSAMPLING_FILTER_LENGTH);
+        path.halfbandInterpolator.setup(2, OVERSAMPLING_FILTER_LENGTH);
+        path.halfbandDecimator.setup(2, OVERSAMPLING_FILTER_LENGTH);
+        path.allpassInterpolator.setup(2);
+        path.allpassDecimator.setup(2);
+        setPathOversampling(path, 2, LINEAR_PHASE);
+    }
+    
+    activePath = &paths[0];
+    fadingPath = nullptr;
+    targetRatio = 2;
+    targetResampler = LINEAR_PHASE;
+    crossfadeGain = 1.f;
+    crossfadeIncr = 1.f / (OVERSAMPLING_CROSSFADE_TIME * sampleRate_);
     
     // setup ramps
     gainCompensation.setup(1.f, sampleRate_, RAMP_UPDATE_RATE);
@@ -202,7 +288,7 @@ bool RingModulator::setup(const float sampleRate_, const uint blockSize_)
     
     // initialize all variables with defualt parameter values
     for (uint n = 0; n < NUM_PARAMETERS; ++n)
-        parameterChanged(parameterID[n], parameterInitialValue[n]);
+        parameterChanged(static_cast<Parameters>(n), parameterInitialValue[n]);
     
     return true;
 }
@@ -224,7 +310,7 @@ void RingModulator::updateRamps()
     if (!phaseShift.rampFinished)
     {
         phaseShift.processRamp();
-        modulator.setPhaseShift(phaseShift());
+        for (OversamplingPath& path : paths) path.modulator.setPhaseShift(phaseShift());
     }
     
     if (!diodeSaturation.rampFinished)
@@ -252,116 +338,246 @@ float32x2_t RingModulator::processAudioSamples(const float32x2_t input_, const u
     // update ramps in a predefined rate
     if ((sampleIndex_ & (RingModulation::RAMP_UPDATE_RATE-1)) == 0) updateRamps();
     
+    return processSample(input_);
+}
+
+
+void RingModulator::processAudioBlock(const float* const input_[2], float* const output_[2], const uint numFrames_)
+{
+    // process the block in chunks of the ramp update rate
+    for (uint start = 0; start < numFrames_; start += RAMP_UPDATE_RATE)
+    {
+        updateRamps();
+        
+        const uint numChunkFrames = std::min(RAMP_UPDATE_RATE, numFrames_ - start);
+        const float* const chunkInput[2] = { input_[0] + start, input_[1] + start };
+        float* const chunkOutput[2] = { output_[0] + start, output_[1] + start };
+        
+        const float gain = gainCompensation();
+        
+        if (!fadingPath)
+        {
+            processPathBlock(*activePath, chunkInput, chunkOutput, numChunkFrames);
+            
+            for (uint n = 0; n < numChunkFrames; ++n)
+            {
+                chunkOutput[0][n] *= gain;
+                chunkOutput[1][n] *= gain;
+            }
+            
+            continue;
+        }
+        
+        // the fading path goes first, the output of the active path may alias the input
+        float* const fadingOutput[2] = { fadingBuffer[0].data(), fadingBuffer[1].data() };
+        processPathBlock(*fadingPath, chunkInput, fadingOutput, numChunkFrames);
+        processPathBlock(*activePath, chunkInput, chunkOutput, numChunkFrames);
+        
+        // linear crossfade, both paths process the same signal
+        for (uint n = 0; n < numChunkFrames; ++n)
+        {
+            const float fadeIn = crossfadeGain * gain;
+            const float fadeOut = gain - fadeIn;
+            
+            chunkOutput[0][n] = chunkOutput[0][n] * fadeIn + fadingOutput[0][n] * fadeOut;
+            chunkOutput[1][n] = chunkOutput[1][n] * fadeIn + fadingOutput[1][n] * fadeOut;
+            
+            crossfadeGain = std::min(crossfadeGain + crossfadeIncr, 1.f);
+        }
+        
+        if (crossfadeGain >= 1.f) finishCrossfade();
+    }
+}
+
+
+void RingModulator::processPathBlock(OversamplingPath& path_, const float* const input_[2], float* const output_[2], const uint numFrames_)
+{
+    // without oversampling the chunk is interleaved and processed at the sample rate
+    if (path_.ratio == 1)
+    {
+        for (uint n = 0; n < numFrames_; ++n) oversampledBuffer[n] = makeStereo(input_[0][n], input_[1][n]);
+        
+        processOversampledBlock(path_, oversampledBuffer.data(), numFrames_);
+        
+        for (uint n = 0; n < numFrames_; ++n)
+        {
+            output_[0][n] = vget_lane_f32(oversampledBuffer[n], 0);
+            output_[1][n] = vget_lane_f32(oversampledBuffer[n], 1);
+        }
+        
+        return;
+    }
+    
+    // upsample the whole chunk, the output may alias the input, which is read completely here
+    if (path_.resampler == LOW_LATENCY) path_.allpassInterpolator.interpolateBlock(input_, oversampledBuffer.data(), numFrames_);
+    else if (path_.ratio > 2) path_.halfbandInterpolator.interpolateBlock(input_, oversampledBuffer.data(), numFrames_);
+    else path_.interpolator.interpolateBlock(input_, oversampledBuffer.data(), numFrames_);
+    
+    processOversampledBlock(path_, oversampledBuffer.data(), numFrames_ * path_.ratio);
+    
+    // downsample the processed chunk to the original sample rate
+    if (path_.resampler == LOW_LATENCY) path_.allpassDecimator.decimateBlock(oversampledBuffer.data(), output_, numFrames_);
+    else if (path_.ratio > 2) path_.halfbandDecimator.decimateBlock(oversampledBuffer.data(), output_, numFrames_);
+    else path_.decimator.decimateBlock(oversampledBuffer.data(), output_, numFrames_);
+}
+
+
+float32x2_t RingModulator::processSample(const float32x2_t input_)
+{
+    float32x2_t output = processPathSample(*activePath, input_);
+    
+    // linear crossfade, both paths process the same signal
+    if (fadingPath)
+    {
+        output = vmul_n_f32(output, crossfadeGain);
+        output = vmla_n_f32(output, processPathSample(*fadingPath, input_), 1.f - crossfadeGain);
+        
+        if ((crossfadeGain += crossfadeIncr) >= 1.f) finishCrossfade();
+    }
+    
+    return vmul_n_f32(output, gainCompensation());
+}
+
+
+float32x2_t RingModulator::processPathSample(OversamplingPath& path_, const float32x2_t input_)
+{
+    // without oversampling the sample is processed directly
+    if (path_.ratio == 1)
+    {
+        float32x2_t output = input_;
+        processOversampledBlock(path_, &output, 1);
+        return output;
+    }
+    
     InterpolatorStereoOutput interpolatedOutput;
     DecimatorStereoInput decimationInput;
     
     // Upsample the incoming audio sample
-    interpolatedOutput = interpolator.interpolateAudio(input_);
+    if (path_.resampler == LOW_LATENCY) interpolatedOutput = path_.allpassInterpolator.interpolateAudio(input_);
+    else if (path_.ratio > 2) interpolatedOutput = path_.halfbandInterpolator.interpolateAudio(input_);
+    else interpolatedOutput = path_.interpolator.interpolateAudio(input_);
     
-    // Process each upsampled audio sample (oversample ratio times)
-    for (uint n = 0; n < oversampleRatio; ++n)
-    {
-        // Retrieve the input signal and modulator signal for ring modulation
-        // process the input signal with bitcrushing first
-        float32x2_t signal1 = bitCrusher.processAudioSample(interpolatedOutput.audioData[n]);
-        float32x2_t signal2 = modulator.getNextValues();
+    // Process the upsampled audio samples (oversample ratio times)
+    std::copy(interpolatedOutput.audioData, interpolatedOutput.audioData + path_.ratio, decimationInput.audioData);
+    processOversampledBlock(path_, decimationInput.audioData, path_.ratio);
         
-        // Choose the ring modulation type based on the `type` parameter:
-        // - TRANSISTOR: Only transistor ring modulation is applied
-        // - TRANSISTOR_DIODE: Blends transistor and diode ring modulation
-        // - DIODE: Only diode ring modulation is applied
-        decimationInput.audioData[n] = (this->*processRingModulation)(signal1, signal2);
-
-        // If the noise parameter is enabled, apply post noise ring modulation and blend it with the current signal
-        if (noiseWet > 0.f)
+    // Downsample the processed audio to the original sample rate
+    if (path_.resampler == LOW_LATENCY) return path_.allpassDecimator.decimateAudio(decimationInput);
+    else if (path_.ratio > 2) return path_.halfbandDecimator.decimateAudio(decimationInput);
+    else return path_.decimator.decimateAudio(decimationInput);
+}
+
+
+void RingModulator::processOversampledBlock(OversamplingPath& path_, float32x2_t* samples_, const uint numSamples_)
+{
+    const bool noiseEnabled = (noiseWet > 0.f);
+    
+    // Retrieve the input signal and modulator signal for ring modulation
+    // process the input signal with bitcrushing first, the noise of the whole block is drawn at once
+    path_.modulator.getNextBlock(modulatorBuffer.data(), numSamples_);
+    
+    for (uint n = 0; n < numSamples_; ++n) carrierBuffer[n] = bitCrusher.processAudioSample(samples_[n]);
+    
+    if (noiseEnabled) noise.fillBlock(noiseBuffer.data(), numSamples_);
+    
+    // Choose the ring modulation type based on the `type` parameter:
+    // - TRANSISTOR: Only transistor ring modulation is applied
+    // - TRANSISTOR_DIODE: Blends transistor and diode ring modulation
+    // - DIODE: Only diode ring modulation is applied
+    (this->*processRingModulation)(carrierBuffer.data(), modulatorBuffer.data(), samples_, numSamples_);
+
+    // If the noise parameter is enabled, apply post noise ring modulation and blend it with the current signal
+    if (noiseEnabled)
+    {
+        for (uint n = 0; n < numSamples_; ++n)
         {
-            float32x2_t noise = { getNoise(), getNoise() };
-            float32x2_t noiseRing = vmul_f32(decimationInput.audioData[n], noise);
+            float32x2_t noiseRing = vmul_f32(samples_[n], noiseBuffer[n]);
             noiseRing = vmul_n_f32(noiseRing, noiseWet);
-            decimationInput.audioData[n] = vmla_n_f32(noiseRing, decimationInput.audioData[n], noiseDry);
+            samples_[n] = vmla_n_f32(noiseRing, samples_[n], noiseDry);
         }
     }
+}
+
+
+void RingModulator::getDiodeRingModulation(const float32x2_t* carrier_, const float32x2_t* modulator_, float32x2_t* output_, const uint numSamples_)
+{
+    for (uint n = 0; n < numSamples_; ++n) output_[n] = getDiodeRingModulationFrame(carrier_[n], modulator_[n]);
+}
+
+
+void RingModulator::getTransistorRingModulation(const float32x2_t* carrier_, const float32x2_t* modulator_, float32x2_t* output_, const uint numSamples_)
+{
+    // two samples per quad, an odd last sample fills both halves
+    for (uint n = 0; n < numSamples_; n += 2)
+    {
+        const uint next = std::min(n + 1, numSamples_ - 1);
+        
+        const float32x4_t output = getTransistorRingModulationFrames(vcombine_f32(carrier_[n], carrier_[next]),
+                                                                     vcombine_f32(modulator_[n], modulator_[next]));
+        
+        output_[n] = vget_low_f32(output);
+        output_[next] = vget_high_f32(output);
+    }
+}
+
+
+void RingModulator::getTransistorDiodeRingModulation(const float32x2_t* carrier_, const float32x2_t* modulator_, float32x2_t* output_, const uint numSamples_)
+{
+    for (uint n = 0; n < numSamples_; n += 2)
+    {
+        const uint next = std::min(n + 1, numSamples_ - 1);
         
-    // Downsample the processed audio to the original sample rate
-    float32x2_t output = vmul_n_f32(decimator.decimateAudio(decimationInput), gainCompensation());
-    
-    return output;
+        const float32x4_t diode = vcombine_f32(getDiodeRingModulationFrame(carrier_[n], modulator_[n]),
+                                               getDiodeRingModulationFrame(carrier_[next], modulator_[next]));
+        const float32x4_t transistor = getTransistorRingModulationFrames(vcombine_f32(carrier_[n], carrier_[next]),
+                                                                         vcombine_f32(modulator_[n], modulator_[next]));
+        
+        const float32x4_t output = vmlaq_n_f32(vmulq_n_f32(diode, typeBlendingWet()), transistor, typeBlendingDry);
+        
+        output_[n] = vget_low_f32(output);
+        output_[next] = vget_high_f32(output);
+    }
 }
 
 
-float32x2_t RingModulator::getDiodeRingModulation(const float32x2_t carrier_, const float32x2_t modulator_)
+float32x2_t RingModulator::getDiodeRingModulationFrame(const float32x2_t carrier_, const float32x2_t modulator_)
 {
-    // Calculate the diode input signals based on the carrier and modulator
+    // Calculate the diode input signals based on the carrier and modulator,
+    // both diodes of both channels are saturated in one quad: [one left, one right, two left, two right]
     float32x2_t halfModulator = vmul_n_f32(modulator_, 0.5f);
-    float32x2_t diodeOne = vabs_f32(vadd_f32(carrier_, halfModulator));
-    float32x2_t diodeTwo = vabs_f32(vsub_f32(carrier_, halfModulator));
+    float32x4_t diodes = vabsq_f32(vcombine_f32(vadd_f32(carrier_, halfModulator), vsub_f32(carrier_, halfModulator)));
                 
     // Process the diode saturations using the following logic:
     // For x >= 0: y(x) = tanh(saturation * x) / tanh(saturation)
     // For x <  0: y(x) = tanh((saturation / asymmetry) * x) / tanh(saturation / asymmetry)
     // no asymmetrical processing of asymmetry = 1
-    diodeOne[0] = (diodeOne[0] >= 0.f)
-        ? approximateTanh(diodeSaturation() * diodeOne[0]) * tanhDiodeSaturation_inversed
-        : approximateTanh(diodeSatuaration_o_Asymmetry[0] * diodeOne[0]) * tanhDiodeSaturationAsym_inversed[0];
-    
-    diodeOne[1] = (diodeOne[1] >= 0.f)
-        ? approximateTanh(diodeSaturation() * diodeOne[1]) * tanhDiodeSaturation_inversed
-        : approximateTanh(diodeSatuaration_o_Asymmetry[0] * diodeOne[1]) * tanhDiodeSaturationAsym_inversed[0];
-    
-    diodeTwo[0] = (diodeTwo[0] >= 0.f)
-        ? approximateTanh(diodeSaturation() * diodeTwo[0]) * tanhDiodeSaturation_inversed
-        : approximateTanh(diodeSatuaration_o_Asymmetry[1] * diodeTwo[0]) * tanhDiodeSaturationAsym_inversed[1];
-    
-    diodeTwo[1] = (diodeTwo[1] >= 0.f)
-        ? approximateTanh(diodeSaturation() * diodeTwo[1]) * tanhDiodeSaturation_inversed
-        : approximateTanh(diodeSatuaration_o_Asymmetry[1] * diodeTwo[1]) * tanhDiodeSaturationAsym_inversed[1];
+    diodes = saturateAsymmetric(diodes, diodeGain[0], diodeGain[1], diodeScale[0], diodeScale[1]);
     
     // Return the difference between the two processed diode signals
-    return vsub_f32(diodeOne, diodeTwo);
+    return vsub_f32(vget_low_f32(diodes), vget_high_f32(diodes));
 }
 
 
-float32x2_t RingModulator::getTransistorRingModulation(const float32x2_t carrier_, const float32x2_t modulator_)
+float32x4_t RingModulator::getTransistorRingModulationFrames(const float32x4_t carrier_, const float32x4_t modulator_)
 {
     // Precalculate the saturated component using the carrier and modulator inputs
-    float32x2_t saturated = vmla_n_f32(carrier_, modulator_, a2);
+    float32x4_t saturated = vmlaq_n_f32(carrier_, modulator_, a2);
 
     // Apply saturation processing based on the following conditions:
     // For x >= 0: y(x) = tanh(saturation * x) / tanh(saturation)
     // For x <  0: y(x) = tanh((saturation / asymmetry) * x) / tanh(saturation / asymmetry)
     // Note: Asymmetry processing is bypassed if asymmetry = 1
-    saturated[0] = (saturated[0] >= 0.f)
-        ? approximateTanh(transistorSaturation() * saturated[0]) * tanhTransistorSaturation_inversed
-        : approximateTanh(transistorSaturation_o_Asymmetry * saturated[0]) * tanhTransistorSaturationAsym_inversed;
-    
-    saturated[1] = (saturated[1] >= 0.f)
-        ? approximateTanh(transistorSaturation() * saturated[1]) * tanhTransistorSaturation_inversed
-        : approximateTanh(transistorSaturation_o_Asymmetry * saturated[1]) * tanhTransistorSaturationAsym_inversed;
+    saturated = saturateAsymmetric(saturated, transistorGain[0], transistorGain[1], transistorScale[0], transistorScale[1]);
 
     // Final computation of the output based on the formula:
     // f(x, y) = (x + a1 * y) * sat(y + a2 * x) + a3 * y + a4 * x
-    float32x2_t output = vmul_f32(vmla_n_f32(modulator_, carrier_, a1), saturated);
-    output = vmla_n_f32(output, carrier_, a3);
-    output = vmla_n_f32(output, modulator_, a4);
+    float32x4_t output = vmulq_f32(vmlaq_n_f32(modulator_, carrier_, a1), saturated);
+    output = vmlaq_n_f32(output, carrier_, a3);
+    output = vmlaq_n_f32(output, modulator_, a4);
     return output;
 }
 
 
-float32x2_t RingModulator::getTransistorDiodeRingModulation(const float32x2_t carrier_, const float32x2_t modulator_)
-{
-    float32x2_t diode = getDiodeRingModulation(carrier_, modulator_);
-    float32x2_t transistor = getTransistorRingModulation(carrier_, modulator_);
-    return vmla_n_f32(vmul_n_f32(diode, typeBlendingWet()), transistor, typeBlendingDry);
-}
-
-
-float RingModulator::getNoise()
-{
-    // returns a random value in the range -1...1
-    return (rand() * TWO_RAND_MAX_INVERSED) - 1.f;
-}
-
-
 void RingModulator::saturate(float& signal_, const float& saturation_, const float asymmetry_)
 {
     // deprecated simple saturation function, stays here for clarity
@@ -375,31 +591,38 @@ void RingModulator::saturate(float& signal_, const float& saturation_, const flo
 
 void RingModulator::resetPhases()
 {
-    modulator.getLFO().resetPhases();
+    for (OversamplingPath& path : paths) path.modulator.getLFO().resetPhases();
+}
+
+
+void RingModulator::setRandomSeed(const uint32_t seed_)
+{
+    noise.setSeed(seed_);
+    for (OversamplingPath& path : paths) path.modulator.getLFO().setRandomSeed(seed_);
 }
 
 
 void RingModulator::setWaveform(const LFO::Waveform waveform_)
 {
-    modulator.getLFO().setWaveform(waveform_);
+    for (OversamplingPath& path : paths) path.modulator.getLFO().setWaveform(waveform_);
 }
 
 
 void RingModulator::setTune(const float freq_)
 {
-    modulator.setFrequency(freq_);
+    for (OversamplingPath& path : paths) path.modulator.setFrequency(freq_);
 }
 
 
 void RingModulator::setRate(const float rate_)
 {
-    modulator.getLFO().setFrequency(rate_);
+    for (OversamplingPath& path : paths) path.modulator.getLFO().setFrequency(rate_);
 }
 
 
 void RingModulator::setDepth(const float depth_)
 {
-    modulator.getLFO().setAmplitude(depth_);
+    for (OversamplingPath& path : paths) path.modulator.getLFO().setAmplitude(depth_);
 }
 
 
@@ -461,15 +684,30 @@ void RingModulator::setSaturation(const float sat_)
 void RingModulator::calculateSaturationVariables()
 {
     // Precompute variables for efficiency, significantly improving the performance of saturation processing
-    tanhDiodeSaturation_inversed = 1.f / approximateTanh(diodeSaturation());
-    tanhDiodeSaturationAsym_inversed[0] = 1.f / approximateTanh(diodeSaturation() * diodeAsymmetry[0]);
-    tanhDiodeSaturationAsym_inversed[1] = 1.f / approximateTanh(diodeSaturation() * diodeAsymmetry[1]);
-    tanhTransistorSaturation_inversed = 1.f / approximateTanh(transistorSaturation());
-    tanhTransistorSaturationAsym_inversed = 1.f / approximateTanh(transistorSaturation() * transistorAsymmetry);
+    // the normalizations use the same tanh approximation as the saturation, so a full-scale input maps to 1
+    const float diodeSat = diodeSaturation();
+    const float transistorSat = transistorSaturation();
     
-    diodeSatuaration_o_Asymmetry[0] = diodeSaturation() / diodeAsymmetry[0];
-    diodeSatuaration_o_Asymmetry[1] = diodeSaturation() / diodeAsymmetry[1];
-    transistorSaturation_o_Asymmetry = transistorSaturation() / transistorAsymmetry;
+    const float32x4_t tanhSaturation = approximateTanh(makeQuad(diodeSat, diodeSat * diodeAsymmetry[0], diodeSat * diodeAsymmetry[1], transistorSat));
+    const float32x4_t tanhTransistorAsym = approximateTanh(vdupq_n_f32(transistorSat * transistorAsymmetry));
+    
+    const float tanhDiodeSaturation_inversed = 1.f / vgetq_lane_f32(tanhSaturation, 0);
+    const float tanhDiodeSaturationAsym_inversed[2] = { 1.f / vgetq_lane_f32(tanhSaturation, 1), 1.f / vgetq_lane_f32(tanhSaturation, 2) };
+    const float tanhTransistorSaturation_inversed = 1.f / vgetq_lane_f32(tanhSaturation, 3);
+    const float tanhTransistorSaturationAsym_inversed = 1.f / vgetq_lane_f32(tanhTransistorAsym, 0);
+    
+    const float diodeSatuaration_o_Asymmetry[2] = { diodeSat / diodeAsymmetry[0], diodeSat / diodeAsymmetry[1] };
+    
+    // lanes [diode one left, right, diode two left, right]
+    diodeGain[0] = vdupq_n_f32(diodeSat);
+    diodeGain[1] = makeQuad(diodeSatuaration_o_Asymmetry[0], diodeSatuaration_o_Asymmetry[0], diodeSatuaration_o_Asymmetry[1], diodeSatuaration_o_Asymmetry[1]);
+    diodeScale[0] = vdupq_n_f32(tanhDiodeSaturation_inversed);
+    diodeScale[1] = makeQuad(tanhDiodeSaturationAsym_inversed[0], tanhDiodeSaturationAsym_inversed[0], tanhDiodeSaturationAsym_inversed[1], tanhDiodeSaturationAsym_inversed[1]);
+    
+    transistorGain[0] = vdupq_n_f32(transistorSat);
+    transistorGain[1] = vdupq_n_f32(transistorSat / transistorAsymmetry);
+    transistorScale[0] = vdupq_n_f32(tanhTransistorSaturation_inversed);
+    transistorScale[1] = vdupq_n_f32(tanhTransistorSaturationAsym_inversed);
 }
 
 
@@ -488,86 +726,166 @@ void RingModulator::setNoise(const float noise_)
 
 void RingModulator::setOversamplingRatio(const uint ratio_)
 {
-    oversampleRatio = ratio_;
-
-    // Update the oversampling objects (interpolator and decimator) with the new ratio
-    interpolator.setInterpolationRatio(ratio_);
-    decimator.setDecimationRatio(ratio_);
-    
-    // Update the oscillators' sample rate to match the oversampled rate (ratio * program sample rate)
-    modulator.setSampleRate(ratio_ * sampleRate);
+    targetRatio = ratio_;
+    updateOversampling();
 }
 
 
-void RingModulator::parameterChanged(const String &parameterID, float newValue)
+void RingModulator::updateOversampling()
 {
-    if (parameterID == "ringmod_tune")
-    {
-        setTune(newValue);
-    }
+    // a crossfade is running: switch once it has finished
+    if (fadingPath) return;
     
-    else if (parameterID == "ringmod_rate")
-    {
-        setRate(newValue);
-    }
+    // without oversampling the resampler doesn't matter
+    if (targetRatio == activePath->ratio && (targetRatio == 1 || targetResampler == activePath->resampler)) return;
     
-    else if (parameterID == "ringmod_depth")
-    {
-        setDepth(newValue * 0.01f);
-    }
+    // the other path continues the modulator of the current one with the new ratio and resampler,
+    // the current path is faded out with the old ones
+    OversamplingPath* newPath = (activePath == &paths[0]) ? &paths[1] : &paths[0];
+    newPath->modulator = activePath->modulator;
+    setPathOversampling(*newPath, targetRatio, targetResampler);
     
-    else if (parameterID == "ringmod_saturation")
-    {
-        setSaturation(newValue * 0.01f);
-    }
-    
-    else if (parameterID == "ringmod_spread")
-    {
-        setSpread(newValue * 0.01f);
-    }
-    
-    else if (parameterID == "ringmod_noise")
-    {
-        setNoise(newValue * 0.01f);
-    }
+    fadingPath = activePath;
+    activePath = newPath;
+    crossfadeGain = 0.f;
+}
+
+
+void RingModulator::setPathOversampling(OversamplingPath& path_, const uint ratio_, const Resampler resampler_)
+{
+    path_.ratio = ratio_;
+    path_.resampler = resampler_;
     
-    else if (parameterID == "ringmod_bitcrush")
+    // Update the oversampling objects (interpolator and decimator) in use with the new ratio,
+    // they select the precomputed filters and clear their history
+    if (resampler_ == LOW_LATENCY)
     {
-        float mapped = 1.f - 0.01f * newValue;
-        mapped = lin2log(mapped);
-        mapped = mapValue(mapped, 0.f, 1.f, 2.f, 16.f);
-        bitCrusher.setBitResolution(mapped);
+        path_.allpassInterpolator.setInterpolationRatio(ratio_);
+        path_.allpassDecimator.setDecimationRatio(ratio_);
     }
-    
-    else if (parameterID == "ringmod_mix")
+    // a polyphase filter of OVERSAMPLING_FILTER_LENGTH taps is too short above 2x, a half-band cascade takes over
+    else if (ratio_ > 2)
     {
-        wet = 0.01f * newValue;
-        dry = 1.f - wet;
+        path_.halfbandInterpolator.setInterpolationRatio(ratio_);
+        path_.halfbandDecimator.setDecimationRatio(ratio_);
     }
-    
-    else if (parameterID == "ringmod_waveform")
+    else
     {
-        LFO::Waveform waveform = INT2ENUM((int)newValue, LFO::Waveform);
-        setWaveform(waveform);
+        path_.interpolator.setInterpolationRatio(ratio_);
+        path_.decimator.setDecimationRatio(ratio_);
     }
     
-    else if (parameterID == "ringmod_oversampling")
-    {
-        uint ratio;
-        if (newValue <= 2) ratio = newValue;
-        else if (newValue == 3) ratio = 4;
-        else if (newValue == 4) ratio = 8;
-        else ratio = 2;
-        
-        setOversamplingRatio(ratio);
-    }
+    // Update the oscillators' sample rate to match the oversampled rate (ratio * program sample rate)
+    path_.modulator.setSampleRate(ratio_ * sampleRate);
+}
+
+
+void RingModulator::finishCrossfade()
+{
+    fadingPath = nullptr;
+    crossfadeGain = 1.f;
     
-    else
+    updateOversampling();
+}
+
+
+void RingModulator::parameterChanged(const Parameters parameter, float newValue)
+{
+    switch (parameter)
     {
-        engine_rt_error("Couldnt find Parameter with ID:" + parameterID, __FILE__, __LINE__, false);
+        case Parameters::TUNE:
+        {
+            setTune(newValue);
+            break;
+        }
+            
+        case Parameters::RATE:
+        {
+            setRate(newValue);
+            break;
+        }
+            
+        case Parameters::DEPTH:
+        {
+            setDepth(newValue * 0.01f);
+            break;
+        }
+            
+        case Parameters::SATURATION:
+        {
+            setSaturation(newValue * 0.01f);
+            break;
+        }
+            
+        case Parameters::SPREAD:
+        {
+            setSpread(newValue * 0.01f);
+            break;
+        }
+            
+        case Parameters::NOISE:
+        {
+            setNoise(newValue * 0.01f);
+            break;
+        }
+            
+        case Parameters::BITCRUSH:
+        {
+            float mapped = 1.f - 0.01f * newValue;
+            mapped = lin2log(mapped);
+            mapped = mapValue(mapped, 0.f, 1.f, 2.f, 16.f);
+            bitCrusher.setBitResolution(mapped);
+            break;
+        }
+            
+        case Parameters::MIX:
+        {
+            wet = 0.01f * newValue;
+            dry = 1.f - wet;
+            break;
+        }
+            
+        case Parameters::WAVEFORM:
+        {
+            LFO::Waveform waveform = INT2ENUM((int)newValue, LFO::Waveform);
+            setWaveform(waveform);
+            break;
+        }
+            
+        case Parameters::OVERSAMPLING:
+        {
+            setOversampling((uint)newValue);
+            break;
+        }
+            
+        case Parameters::RESAMPLER:
+        {
+            setResampler((uint)newValue);
+            break;
+        }
+            
+        default:
+        {
+            engine_rt_error("Couldnt find Parameter with Index:" + TOSTRING((int)parameter), __FILE__, __LINE__, false);
+            break;
+        }
     }
 }
 
 
+void RingModulator::setOversampling(const uint value_)
+{
+    // the choices are the powers of two up to MAX_RATE_CONVERSION_RATIO
+    setOversamplingRatio(1u << std::min(value_, NUM_RATE_CONVERSION_RATIOS - 1));
+}
+
+
+void RingModulator::setResampler(const uint value_)
+{
+    targetResampler = INT2ENUM(std::min(value_, NUM_RESAMPLERS - 1), Resampler);
+    updateOversampling();
+}
+
+
 
 
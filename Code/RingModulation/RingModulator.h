@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../Helpers.hpp"
+#include "../Random.hpp"
 #include "SampleRateConverter.h"
 #include "BitCrusher.h"
 
@@ -20,14 +21,22 @@ namespace RingModulation
  */
 static const uint RAMP_UPDATE_RATE = 8;
 
+/** @brief the most samples of an oversampled chunk, the chunk of RAMP_UPDATE_RATE samples at the highest ratio */
+static const uint MAX_OVERSAMPLED_CHUNK_SIZE = RAMP_UPDATE_RATE * MAX_RATE_CONVERSION_RATIO;
+static_assert(MAX_OVERSAMPLED_CHUNK_SIZE % 4 == 0, "the oscillators generate four samples at a time");
+
 /**
- * @brief determines the number of taps of the FIR Oversampling Filters
- * @attention has to be 64, 128 or 256 for now
+ * @brief determines the number of taps of the FIR Oversampling Filter at 2x and of the first half-band stage above
+ * @attention has to be a multiple of 4, at most MAX_FILTER_LENGTH,
+ * 64, 128 and 256 have predefined filters at 44.1 and 48 kHz, other configurations are designed at setup
  */
 static const uint OVERSAMPLING_FILTER_LENGTH = 64;
 
+/** @brief duration of the crossfade between two oversampling ratios in seconds */
+static const float OVERSAMPLING_CROSSFADE_TIME = 0.05f;
+
 /** @brief the number of user definable parameters */
-static const unsigned int NUM_PARAMETERS = 9;
+static const unsigned int NUM_PARAMETERS = 11;
 
 static const uint NUM_WAVEFORMS = 5;
 static const std::string waveformNames[NUM_WAVEFORMS] {
@@ -38,6 +47,22 @@ static const std::string waveformNames[NUM_WAVEFORMS] {
     "Random"
 };
 
+/** @brief the choices of the oversampling parameter, the ratios 1, 2, 4, 8 and 16 */
+static const std::string oversamplingNames[NUM_RATE_CONVERSION_RATIOS] {
+    "Off",
+    "2x",
+    "4x",
+    "8x",
+    "16x"
+};
+
+/** @brief the choices of the resampler parameter, see `RingModulator::Resampler` */
+static const uint NUM_RESAMPLERS = 2;
+static const std::string resamplerNames[NUM_RESAMPLERS] {
+    "Linear Phase",
+    "Low Latency"
+};
+
 /** @brief an enum to save the parameter Indexes */
 enum class Parameters
 {
@@ -49,7 +74,9 @@ enum class Parameters
     NOISE,
     BITCRUSH,
     MIX,
-    WAVEFORM
+    WAVEFORM,
+    OVERSAMPLING,
+    RESAMPLER
 };
 
 /** @brief names of parameters */
@@ -62,7 +89,9 @@ static const std::string parameterID[NUM_PARAMETERS] = {
     "ringmod_noise",
     "ringmod_bitcrush",
     "ringmod_mix",
-    "ringmod_waveform"
+    "ringmod_waveform",
+    "ringmod_oversampling",
+    "ringmod_resampler"
 };
 
 /** @brief names of parameters */
@@ -75,7 +104,9 @@ static const std::string parameterName[NUM_PARAMETERS] = {
     "Noise",
     "Bitcrush",
     "Ringmod Mix",
-    "Waveform"
+    "Waveform",
+    "Oversampling",
+    "Resampler"
 };
 
 /** @brief units of parameters */
@@ -88,6 +119,8 @@ static const std::string parameterSuffix[NUM_PARAMETERS] = {
     " %",
     " %",
     " %",
+    "",
+    "",
     ""
 };
 
@@ -101,6 +134,8 @@ static const float parameterMin[NUM_PARAMETERS] = {
     0.f,
     0.f,
     0.f,
+    0.f,
+    0.f,
     0.f
 };
 
@@ -114,7 +149,9 @@ static const float parameterMax[NUM_PARAMETERS] = {
     100.f,
     100.f,
     100.f,
-    4.f
+    4.f,
+    NUM_RATE_CONVERSION_RATIOS - 1,
+    NUM_RESAMPLERS - 1
 };
 
 /** @brief step values of parameters */
@@ -127,6 +164,8 @@ static const float parameterStep[NUM_PARAMETERS] = {
     0.5f,
     0.5f,
     0.5f,
+    1.f,
+    1.f,
     1.f
 };
 
@@ -140,6 +179,8 @@ static const float parameterInitialValue[NUM_PARAMETERS] = {
     0.f,
     0.f,
     70.f,
+    0.f,
+    1.f,
     0.f
 };
 
@@ -174,10 +215,15 @@ public:
     void setup(const float freq_, const float sampleRate_);
         
     /**
-     * @brief Generates the next value of the LFO's waveform.
-     * @return The next value of the LFO, scaled by its amplitude.
+     * @brief Generates the next values of the LFO's waveform.
+     *
+     * The phases are accumulated sample by sample, so blocks of any size produce the same values. The waveform is
+     * selected once per block and computed four samples at a time, except for the random waveform.
+     *
+     * @param output_ Receives the values, scaled by the amplitude, needs room for `numSamples_` rounded up to a multiple of 4.
+     * @param numSamples_ The number of values.
      */
-    float getNextValue();
+    void getNextBlock(float* output_, const uint numSamples_);
     
     /**
      * @brief Sets the sample rate for the LFO.
@@ -203,40 +249,61 @@ public:
      */
     void setWaveform(Waveform waveform_);
     
+    /**
+     * @brief Restarts the sequence of the random waveform.
+     * @param seed_ The seed, see `RandomGenerator::setSeed()`.
+     */
+    void setRandomSeed(const uint32_t seed_) { random.setSeed(seed_, RANDOM_STREAM); }
+    
     void resetPhases();
     
 private:
     /**
-     * @brief Generates the next value of the sine waveform.
-     * @return The sine waveform value at the current phase.
+     * @brief Computes the sine waveform.
+     * @param phase_ Four phases in radians.
+     * @return The sine waveform values at the phases.
      */
-    float getSine();
+    static float32x4_t getSine(const float32x4_t phase_);
 
     /**
-     * @brief Generates the next value of the triangle waveform.
-     * @return The triangle waveform value at the current phase.
+     * @brief Computes the triangle waveform.
+     * @param phase_ Four phases in radians.
+     * @return The triangle waveform values at the phases.
      */
-    float getTriangle();
+    static float32x4_t getTriangle(const float32x4_t phase_);
 
     /**
-     * @brief Generates the next value of the saw waveform.
-     * @return The saw waveform value at the current phase.
+     * @brief Computes the saw waveform.
+     * @param phase_ Four phases in radians.
+     * @return The saw waveform values at the phases.
      */
-    float getSaw();
+    static float32x4_t getSaw(const float32x4_t phase_);
 
     /**
-     * @brief Generates the next value of the pulse waveform.
-     * @return The pulse waveform value at the current phase.
+     * @brief Computes the pulse waveform.
+     * @param phase_ Four phases in radians.
+     * @return The pulse waveform values at the phases.
+     */
+    static float32x4_t getPulse(const float32x4_t phase_);
+    
+    /**
+     * @brief Replaces a block of phases with the values of a waveform, scaled by the amplitude.
+     * @tparam getWaveform The waveform function, inlined into the loop.
+     * @param values_ The phases, receive the values, four at a time.
+     * @param numSamples_ The number of phases.
      */
-    float getPulse();
+    template <float32x4_t (*getWaveform)(const float32x4_t)>
+    void applyWaveform(float* values_, const uint numSamples_) const;
 
     /**
-     * @brief Generates the next value of the random waveform.
-     * @return A random value updated once per waveform cycle.
+     * @brief Generates the next values of the random waveform.
+     * @param output_ Receives the random values, updated once per waveform cycle.
+     * @param numSamples_ The number of values.
      */
-    float getRandom();
+    void getRandomBlock(float* output_, const uint numSamples_);
     
-    float (LFO::*getValue)(); ///< Function pointer to the currently selected waveform generator function.
+    /** @brief Advances the phase by one sample and wraps it. */
+    void advancePhase();
 
     float sampleRate; ///< The current sample rate of the audio system in Hz.
     float invSampleRate; ///< The reciprocal of the sample rate (1 / sampleRate).
@@ -250,6 +317,9 @@ private:
     
     bool phaseWrapped = false; ///< Flag indicating whether the phase has wrapped around in the current cycle.
     float nextValue = 0.f; ///< The next value for random waveform generation.
+    RandomGenerator random { DEFAULT_RANDOM_SEED, RANDOM_STREAM }; ///< Draws the values of the random waveform.
+    
+    static const uint32_t RANDOM_STREAM = 1; ///< The stream of the random waveform, the noise of the ring modulator uses stream 0.
 };
 
 
@@ -273,9 +343,14 @@ public:
             
     /**
      * @brief Generates the next values of the oscillator's waveform.
-     * @return A float32x2_t array containing the current and (optionally) phase-shifted waveform values.
+     *
+     * The LFO and the phase increments of the whole block are computed first, then the sines of both channels,
+     * two samples per quad.
+     *
+     * @param output_ Receives the current and the phase-shifted waveform values.
+     * @param numSamples_ The number of stereo values, at most MAX_OVERSAMPLED_CHUNK_SIZE.
      */
-    float32x2_t getNextValues();
+    void getNextBlock(float32x2_t* output_, const uint numSamples_);
     
     /**
      * @brief Sets the sample rate for the oscillator.
@@ -308,10 +383,11 @@ private:
     float frequency; ///< The frequency of the oscillator in Hz.
     float phase; ///< The current phase of the oscillator waveform, in radians.
     float increment; ///< The phase increment per sample, determined by frequency and sample rate.
-    float phaseShift; ///< The phase shift applied to the secondary output, in radians.
-    bool phaseIsShifted = false; ///< Flag indicating whether a phase shift is applied to the secondary output.
+    float phaseShift = 0.f; ///< The phase shift applied to the secondary output, in radians.
     
     LFO modulator; ///< An instance of the LFO class used for frequency modulation.
+    std::array<float, MAX_OVERSAMPLED_CHUNK_SIZE> modulation; ///< The LFO values of a block, then the factors of the phase increment.
+    std::array<float, MAX_OVERSAMPLED_CHUNK_SIZE> phases; ///< The phases of a block.
 };
 
 
@@ -332,6 +408,19 @@ private:
 class RingModulator
 {
 public:
+    /**
+     * @enum Resampler
+     * @brief The filters of the oversampling.
+     *
+     * LINEAR_PHASE uses polyphase FIR filters of OVERSAMPLING_FILTER_LENGTH taps at 2x and cascades of half-band stages
+     * above, the first one with OVERSAMPLING_FILTER_LENGTH taps. A single polyphase filter of that length gets too short
+     * for the narrow transition band of the higher ratios, the cascade keeps the passband and the attenuation of 2x.
+     * Both delay the signal by about OVERSAMPLING_FILTER_LENGTH / 2 samples. LOW_LATENCY uses cascades of allpass
+     * half-band stages, which delay it by two to three samples in the passband, with a fraction of the multiplications,
+     * but their phase isn't linear.
+     */
+    enum Resampler { LINEAR_PHASE, LOW_LATENCY };
+    
     /**
      * @brief Initializes the ring modulator with the given sample rate and block size.
      * @param sampleRate_ The sample rate in Hz.
@@ -348,6 +437,17 @@ public:
      */
     float32x2_t processAudioSamples(const float32x2_t input_, const uint sampleIndex_);
     
+    /**
+     * @brief Processes a block of non-interleaved stereo audio samples using ring modulation.
+     *
+     * The ramps are updated once every RAMP_UPDATE_RATE samples, without a per-sample check.
+     *
+     * @param input_ Pointers to the left and right input channel.
+     * @param output_ Pointers to the left and right output channel, may alias the input.
+     * @param numFrames_ The number of samples per channel to process.
+     */
+    void processAudioBlock(const float* const input_[2], float* const output_[2], const uint numFrames_);
+    
     /**
      * @brief Updates internal parameters for the audio processing block.
      */
@@ -355,19 +455,93 @@ public:
     
     void resetPhases();
     
+    /**
+     * @brief Restarts the sequences of the noise and of the random LFO waveform, so a render can be reproduced.
+     * @param seed_ The seed, see `RandomGenerator::setSeed()`.
+     */
+    void setRandomSeed(const uint32_t seed_);
+    
     /**
      * @brief Handles changes to parameters.
-     * @param parameterID The identifier of the changed parameter.
+     * @param parameter The index of the changed parameter, resolved from its ID once at setup.
      * @param newValue The new value of the parameter.
      */
-    void parameterChanged(const String& parameterID, float newValue);
+    void parameterChanged(const Parameters parameter, float newValue);
+    
+    /**
+     * @brief Sets the oversampling, see `setOversamplingRatio()`.
+     * @param value_ the index of the `ringmod_oversampling` choice, 0 (off) to 4 select the ratios 1, 2, 4, 8 and 16
+     */
+    void setOversampling(const uint value_);
+    
+    /**
+     * @brief Sets the filters of the oversampling, the switch is crossfaded like a switch of the ratio.
+     * @param value_ the index of the `ringmod_resampler` choice, see `Resampler`
+     */
+    void setResampler(const uint value_);
     
 private:
+    /**
+     * @struct OversamplingPath
+     * @brief The resamplers and the modulator of one oversampling ratio and resampler.
+     *
+     * There are two paths, so the old ratio can be faded out while the new one fades in. The bitcrusher and
+     * the saturation don't depend on the rate, both paths share them.
+     */
+    struct OversamplingPath
+    {
+        InterpolatorStereo interpolator; ///< Interpolator for upsampling at 2x.
+        DecimatorStereo decimator; ///< Decimator for downsampling at 2x.
+        HalfbandInterpolatorStereo halfbandInterpolator; ///< Interpolator for upsampling above 2x.
+        HalfbandDecimatorStereo halfbandDecimator; ///< Decimator for downsampling above 2x.
+        AllpassInterpolatorStereo allpassInterpolator; ///< Interpolator for upsampling with low latency.
+        AllpassDecimatorStereo allpassDecimator; ///< Decimator for downsampling with low latency.
+        Oscillator modulator; ///< Modulator oscillator instance, running at the oversampled rate.
+        uint ratio = 2; ///< Oversampling ratio for the audio processing.
+        Resampler resampler = LINEAR_PHASE; ///< The resamplers in use.
+    };
+    
     /**
      * @brief Updates internal ramps for smooth parameter transitions.
      */
     void updateRamps();
     
+    /**
+     * @brief Processes one stereo sample without updating the ramps.
+     * @param input_ The stereo input sample.
+     * @return The processed stereo sample.
+     */
+    float32x2_t processSample(const float32x2_t input_);
+    
+    /**
+     * @brief Processes one stereo sample through an oversampling path, without the gain compensation.
+     * @param path_ The oversampling path.
+     * @param input_ The stereo input sample.
+     * @return The processed stereo sample.
+     */
+    float32x2_t processPathSample(OversamplingPath& path_, const float32x2_t input_);
+    
+    /**
+     * @brief Processes a chunk of at most RAMP_UPDATE_RATE samples through an oversampling path, without the gain compensation.
+     * @param path_ The oversampling path.
+     * @param input_ Pointers to the left and right input channel.
+     * @param output_ Pointers to the left and right output channel, may alias the input.
+     * @param numFrames_ The number of samples per channel.
+     */
+    void processPathBlock(OversamplingPath& path_, const float* const input_[2], float* const output_[2], const uint numFrames_);
+    
+    /**
+     * @brief Processes oversampled stereo samples in place: bitcrusher, ring modulation and noise.
+     *
+     * The bitcrusher, the modulator and the noise run sample by sample, the ring modulation saturates
+     * the whole block with vector functions.
+     *
+     * @param path_ The oversampling path, which holds the modulator of its rate.
+     * @param samples_ The upsampled stereo samples, receive the processed samples before decimation.
+     * @param numSamples_ The number of samples, at most MAX_OVERSAMPLED_CHUNK_SIZE.
+     */
+    void processOversampledBlock(OversamplingPath& path_, float32x2_t* samples_, const uint numSamples_);
+    
     // Setters for various parameters
     void setTune(const float freq_);
     void setRate(const float rate_);
@@ -376,9 +550,29 @@ private:
     void setSaturation(const float sat_);
     void setSpread(const float spread_);
     void setNoise(const float noise_);
+    
+    /**
+     * @brief Switches the oversampling ratio without allocating, see `updateOversampling()`.
+     * @param ratio_ The new ratio, 1 processes at the sample rate without resampling.
+     */
     void setOversamplingRatio(const uint ratio_);
     
-    float32x2_t (RingModulator::*processRingModulation)(const float32x2_t, const float32x2_t); ///< Function pointer to the ring modulation function.
+    /**
+     * @brief Switches to the selected ratio and resampler if the active path doesn't use them.
+     *
+     * The other path takes over the modulator of the current one, selects the precomputed filters of the new ratio
+     * and resampler and fades in while the current path fades out. A selection during the crossfade is switched to
+     * once it has finished.
+     */
+    void updateOversampling();
+    
+    /** @brief Sets the ratio and the resampler of a path and the rate of its modulator, clears the history of its resamplers. */
+    void setPathOversampling(OversamplingPath& path_, const uint ratio_, const Resampler resampler_);
+    
+    /** @brief Ends the crossfade between the oversampling paths and switches to a selection made in the meantime. */
+    void finishCrossfade();
+    
+    void (RingModulator::*processRingModulation)(const float32x2_t*, const float32x2_t*, float32x2_t*, const uint); ///< Function pointer to the ring modulation function.
     
     /**
      * @brief Applies diode-based ring modulation to the input signals.
@@ -393,11 +587,14 @@ private:
      * - For x <  0: y(x) = tanh((saturation / asymmetry) * x) / tanh(saturation / asymmetry)
      * @endcode
      *
-     * @param carrier_ The carrier signal, represented as a `float32x2_t` vector (stereo signal).
-     * @param modulator_ The modulator signal, represented as a `float32x2_t` vector (stereo signal).
-     * @return A `float32x2_t` vector containing the ring-modulated output signal.
+     * Both diodes of both channels are saturated in one quad, see `getDiodeRingModulationFrame()`.
+     *
+     * @param carrier_ The carrier signal, `numSamples_` stereo samples.
+     * @param modulator_ The modulator signal, `numSamples_` stereo samples.
+     * @param output_ Receives the ring-modulated output signal.
+     * @param numSamples_ The number of stereo samples.
      */
-    float32x2_t getDiodeRingModulation(const float32x2_t carrier_, const float32x2_t modulator_);
+    void getDiodeRingModulation(const float32x2_t* carrier_, const float32x2_t* modulator_, float32x2_t* output_, const uint numSamples_);
 
     /**
      * @brief Applies transistor-based ring modulation to the input signals.
@@ -413,11 +610,14 @@ private:
      * @endcode
      * The resulting output is further shaped using coefficients `a1`, `a2`, `a3`, and `a4` for fine-tuned transistor emulation.
      *
-     * @param carrier_ The carrier signal, represented as a `float32x2_t` vector (stereo signal).
-     * @param modulator_ The modulator signal, represented as a `float32x2_t` vector (stereo signal).
-     * @return A `float32x2_t` vector containing the ring-modulated output signal.
+     * Two stereo samples are processed in one quad, see `getTransistorRingModulationFrames()`.
+     *
+     * @param carrier_ The carrier signal, `numSamples_` stereo samples.
+     * @param modulator_ The modulator signal, `numSamples_` stereo samples.
+     * @param output_ Receives the ring-modulated output signal.
+     * @param numSamples_ The number of stereo samples.
      */
-    float32x2_t getTransistorRingModulation(const float32x2_t carrier_, const float32x2_t modulator_);
+    void getTransistorRingModulation(const float32x2_t* carrier_, const float32x2_t* modulator_, float32x2_t* output_, const uint numSamples_);
 
     /**
      * @brief Applies a combination of diode and transistor-based ring modulation.
@@ -428,13 +628,29 @@ private:
      * The combined modulation creates a hybrid effect, simulating both diode and transistor nonlinearities.
      * It is particularly useful for achieving a unique, blended tone not achievable with pure diode or transistor modulation alone.
      *
-     * @param carrier_ The carrier signal, represented as a `float32x2_t` vector (stereo signal).
-     * @param modulator_ The modulator signal, represented as a `float32x2_t` vector (stereo signal).
-     * @return A `float32x2_t` vector containing the blended ring-modulated output signal.
+     * @param carrier_ The carrier signal, `numSamples_` stereo samples.
+     * @param modulator_ The modulator signal, `numSamples_` stereo samples.
+     * @param output_ Receives the blended ring-modulated output signal.
+     * @param numSamples_ The number of stereo samples.
+     */
+    void getTransistorDiodeRingModulation(const float32x2_t* carrier_, const float32x2_t* modulator_, float32x2_t* output_, const uint numSamples_);
+    
+    /**
+     * @brief Applies the diode ring modulation to one stereo sample.
+     * @param carrier_ The stereo carrier sample.
+     * @param modulator_ The stereo modulator sample.
+     * @return The ring-modulated stereo sample.
+     */
+    float32x2_t getDiodeRingModulationFrame(const float32x2_t carrier_, const float32x2_t modulator_);
+    
+    /**
+     * @brief Applies the transistor ring modulation to two stereo samples.
+     * @param carrier_ Two stereo carrier samples, [left 0, right 0, left 1, right 1].
+     * @param modulator_ Two stereo modulator samples in the same layout.
+     * @return The two ring-modulated stereo samples.
      */
-    float32x2_t getTransistorDiodeRingModulation(const float32x2_t carrier_, const float32x2_t modulator_);
+    float32x4_t getTransistorRingModulationFrames(const float32x4_t carrier_, const float32x4_t modulator_);
     
-    inline float getNoise(); ///< Generates a random noise value.
     inline void saturate(float& signal_, const float& saturation, const float asymmetry = 1.f); ///< Applies saturation to the signal.
     void calculateSaturationVariables(); ///< Precomputes variables for efficient saturation processing.
     
@@ -452,17 +668,14 @@ private:
     LinearRamp typeBlendingWet; ///< Ramp for wet blending between modulation types.
     float32_t typeBlendingDry; ///< Dry blending value for modulation types.
 
-    Oscillator modulator; ///< Modulator oscillator instance.
     BitCrusher bitCrusher; ///< Bitcrusher instance for sample rate and resolution reduction.
 
     LinearRamp diodeSaturation; ///< Ramp for diode saturation.
     LinearRamp transistorSaturation; ///< Ramp for transistor saturation.
-    float tanhDiodeSaturation_inversed; ///< Inverse of the diode saturation tanh value.
-    float tanhTransistorSaturation_inversed; ///< Inverse of the transistor saturation tanh value.
-    float tanhDiodeSaturationAsym_inversed[2]; ///< Inverse tanh values for asymmetric diode saturation.
-    float tanhTransistorSaturationAsym_inversed; ///< Inverse tanh value for asymmetric transistor saturation.
-    float diodeSatuaration_o_Asymmetry[2]; ///< Saturation divided by asymmetry for diodes.
-    float transistorSaturation_o_Asymmetry; ///< Saturation divided by asymmetry for transistors.
+    float32x4_t diodeGain[2]; ///< [positive, negative] saturation gains of the diodes, lanes [diode 1 left, right, diode 2 left, right].
+    float32x4_t diodeScale[2]; ///< [positive, negative] inverses of the tanh of the diode saturation, same lanes.
+    float32x4_t transistorGain[2]; ///< [positive, negative] saturation gains of the transistors.
+    float32x4_t transistorScale[2]; ///< [positive, negative] inverses of the tanh of the transistor saturation.
     const float transistorAsymmetry = 0.99f; ///< Default transistor asymmetry value.
     const float diodeAsymmetry[2] = { 0.96f, 0.87f }; ///< Default diode asymmetry values.
     const float32_t a1 = 0.1f; ///< Parameter for modulation formula.
@@ -472,9 +685,19 @@ private:
 
     float32_t noiseWet, noiseDry; ///< Wet and dry levels for noise modulation.
 
-    InterpolatorStereo interpolator; ///< Interpolator for upsampling.
-    DecimatorStereo decimator; ///< Decimator for downsampling.
-    uint oversampleRatio = 2; ///< Oversampling ratio for the audio processing.
+    OversamplingPath paths[2]; ///< The path of the current ratio and the one of the previous ratio, which is faded out after a switch.
+    OversamplingPath* activePath = nullptr; ///< The path of the current ratio.
+    OversamplingPath* fadingPath = nullptr; ///< The path of the previous ratio while the crossfade runs, nullptr otherwise.
+    uint targetRatio = 2; ///< The selected ratio, the active path switches to it once no crossfade runs.
+    Resampler targetResampler = LINEAR_PHASE; ///< The selected resampler, the active path switches to it once no crossfade runs.
+    float crossfadeGain = 1.f; ///< Gain of the active path during the crossfade, 0...1, the fading path gets the rest.
+    float crossfadeIncr = 0.f; ///< Increment of the crossfade gain per sample.
+    std::array<float32x2_t, MAX_OVERSAMPLED_CHUNK_SIZE> oversampledBuffer; ///< One upsampled chunk of a block.
+    std::array<float32x2_t, MAX_OVERSAMPLED_CHUNK_SIZE> carrierBuffer; ///< The bitcrushed input of an oversampled block.
+    std::array<float32x2_t, MAX_OVERSAMPLED_CHUNK_SIZE> modulatorBuffer; ///< The modulator of an oversampled block.
+    std::array<float32x2_t, MAX_OVERSAMPLED_CHUNK_SIZE> noiseBuffer; ///< The noise of an oversampled block.
+    NoiseGenerator noise; ///< Fills the noise buffer, shared by both oversampling paths.
+    std::array<float, RAMP_UPDATE_RATE> fadingBuffer[2]; ///< The output of the fading path for one chunk.
 };
 
 } // namspace RingModulation
@@ -37,9 +37,9 @@ inline float** decomposeFilter(const float* filterCoefficients_, const uint filt
 }
 
 
-inline const float* getFilterCoefficients(const float sampleRate_, const uint filterLength_, const uint ratio_)
+inline const float* getFilterTable(const float sampleRate_, const uint filterLength_, const uint ratio_)
 {
-    // for now no other samplerate than 44100 or 48000 is accepted
+    // there are only tables for 44100 and 48000
     if (sampleRate_ != 44100.f && sampleRate_ != 48000.f) return nullptr;
     
     if (sampleRate_ == 44100.f)
@@ -102,6 +102,15 @@ inline const float* getFilterCoefficients(const float sampleRate_, const uint fi
 }
 
 
+inline const float* getFilterCoefficients(const float sampleRate_, const uint filterLength_, const uint ratio_)
+{
+    // prefer the predefined tables, every other configuration is designed
+    if (const float* table = getFilterTable(sampleRate_, filterLength_, ratio_)) return table;
+    
+    return getOversamplingLowpass(filterLength_, ratio_);
+}
+
+
 // =======================================================================================
 // MARK: - CONVOLVER
 // =======================================================================================
@@ -129,32 +138,17 @@ void Convolver::setup(const uint filterLength_, const float *filterCoeffs_)
 float Convolver::processAudioSample(const float input_)
 {
     float output = 0.f;
-    int readPointer = writePointer;
     float32x4_t sumVector = vdupq_n_f32(0.f);
     
-    // write new sample to buffer
-    buffer.at(writePointer) = input_;
+    // the write pointer runs backwards, the new sample is written to both halves of the buffer
+    writePointer = (writePointer == 0) ? filterLength - 1 : writePointer - 1;
+    buffer[writePointer] = buffer[writePointer + filterLength] = input_;
     
-    // increase the write Pointer
-    if (++writePointer >= filterLength) writePointer -= filterLength;
+    // the last filterLength samples start at the write pointer, newest first
+    const float* window = buffer.data() + writePointer;
     
-    for (uint n = 0; n <= filterLength - 4; n += 4)
-    {
-        // read out the next 4 samples from the samplebuffer
-        float copyArray[4];
-        for (uint i = 0; i < 4; ++i)
-        {
-            copyArray[i] = buffer[readPointer--];
-            if (readPointer < 0) readPointer += filterLength;
-        }
-        
-        // store the values in simd vectors
-        float32x4_t vector1 = vld1q_f32(filterCoefficients.data() + n);
-        float32x4_t vector2 = vld1q_f32(copyArray);
-        
-        // process the sum of products
-        sumVector = vmlaq_f32(sumVector, vector1, vector2);
-    }
+    for (uint n = 0; n < filterLength; n += 4)
+        sumVector = vmlaq_f32(sumVector, vld1q_f32(filterCoefficients.data() + n), vld1q_f32(window + n));
     
     // accumulate the 4 values of the simd vector horizontally to form the output value
     float32x2_t sumPair = vadd_f32(vget_low_f32(sumVector), vget_high_f32(sumVector));
@@ -170,38 +164,23 @@ void ConvolverStereo::setup(const uint filterLength_, const float *filterCoeffs_
         engine_rt_error("Convolver Length needs to be a multiple of 4", __FILE__, __LINE__, true);
     
     filterLength = filterLength_;
-    writePointer = 0;
 
-    // copy the coefficient array to the internal vector
-    for (uint n = 0; n < MAX_FILTER_LENGTH; ++n)
-    {
-        if (n < filterLength_) filterCoefficients[n] = filterCoeffs_[n];
-        else filterCoefficients[n] = 0.f;
-    }
+    // copy the coefficient array to the internal vector, once for each channel
+    std::fill(coefficientPairs.begin(), coefficientPairs.end(), 0.f);
+    
+    for (uint n = 0; n < filterLength_; ++n)
+        coefficientPairs[2 * n] = coefficientPairs[2 * n + 1] = filterCoeffs_[n];
 
     // fill buffer with 0s
-    std::fill(buffer.begin(), buffer.end(), vdup_n_f32(0.f));
+    delayLine.setup(filterLength);
 }
 
 
 float32x2_t ConvolverStereo::processAudioSamples(const float32x2_t input_)
 {
-    float32x2_t output = vdup_n_f32(0.f);
-    int readPointer = writePointer;
-    
-    // write new sample to buffer
-    buffer.at(writePointer) = input_;
+    const float* window = delayLine.write(input_);
     
-    // increase the write Pointer
-    if (++writePointer >= filterLength) writePointer -= filterLength;
-    
-    for (uint n = 0; n < filterLength; ++n)
-    {
-        output = vmla_n_f32(output, buffer[readPointer--], filterCoefficients[n]);
-        if (readPointer < 0) readPointer += filterLength;
-    }
-    
-    return output;
+    return reduceStereoSum(convolveStereo(vdupq_n_f32(0.f), window, coefficientPairs.data(), filterLength));
 }
 
 
@@ -268,6 +247,37 @@ void InterpolatorStereo::setup(const float sampleRate_, const uint ratio_, const
 {
     sampleRate = sampleRate_;
     filterLength = filterLength_;
+    
+    // prepare a bank of polyphase filters for every ratio, switching the ratio only selects one
+    for (uint index = 0; index < NUM_RATE_CONVERSION_RATIOS; ++index)
+    {
+        const uint bankRatio = 1u << index;
+        
+        // every polyphase filter needs an even number of taps
+        if (filterLength % (2 * bankRatio) != 0) continue;
+        
+        // retrieve the matching set of filter coefficients
+        const float* filterCoefficients = getFilterCoefficients(sampleRate, filterLength, bankRatio);
+        
+        // check if we found valid values
+        if (!filterCoefficients) engine_rt_error("No machting FIR LPF found for these specifications!", __FILE__, __LINE__, true);
+        
+        // the gain compensation is a power of two, scaling the coefficients gives the same result as scaling the output
+        const float32_t gainCompensation = (float32_t)bankRatio;
+        const uint bankPhaseLength = filterLength / bankRatio;
+        float32_t* bank = coefficientPairs.data() + 2 * MAX_FILTER_LENGTH * index;
+        
+        // store the poly phase filters one after another, every coefficient once for each channel:
+        // the output sample i of an input sample is computed with the coefficients i, i + ratio, i + 2 * ratio, ...
+        for (uint i = 0; i < bankRatio; i++)
+        {
+            for (uint n = 0; n < bankPhaseLength; ++n)
+            {
+                const float coefficient = filterCoefficients[n * bankRatio + i] * gainCompensation;
+                bank[2 * (i * bankPhaseLength + n)] = bank[2 * (i * bankPhaseLength + n) + 1] = coefficient;
+            }
+        }
+    }
 
     setInterpolationRatio(ratio_);
 }
@@ -276,45 +286,43 @@ void InterpolatorStereo::setup(const float sampleRate_, const uint ratio_, const
 InterpolatorStereoOutput InterpolatorStereo::interpolateAudio(const float32x2_t input_)
 {
     InterpolatorStereoOutput output;
-    int m = ratio - 1;
+    
+    // all polyphase filters read the same window
+    const float* window = delayLine.write(input_);
     
     for (uint n = 0; n < ratio; ++n)
-        output.audioData[n] = vmul_n_f32(polyPhaseConvolver[m--].processAudioSamples(input_), gainCompensation);
+        output.audioData[n] = reduceStereoSum(convolveStereo(vdupq_n_f32(0.f), window, getPhase(n), phaseLength));
     
     return output;
 }
 
 
-void InterpolatorStereo::setInterpolationRatio(const uint ratio_)
+void InterpolatorStereo::interpolateBlock(const float* const input_[2], float32x2_t* output_, const uint numFrames_)
 {
-    ratio = ratio_;
-    gainCompensation = (float32_t)ratio;
-    
-    // retrieve the matching set of filter coefficients
-    const float* filterCoefficients = getFilterCoefficients(sampleRate, filterLength, ratio);
-    
-    // check if we found valid values
-    if (!filterCoefficients) engine_rt_error("No machting FIR LPF found for these specifications!", __FILE__, __LINE__, true);
+    for (uint k = 0; k < numFrames_; ++k)
+    {
+        const float* window = delayLine.write(makeStereo(input_[0][k], input_[1][k]));
+        
+        for (uint n = 0; n < ratio; ++n)
+            *output_++ = reduceStereoSum(convolveStereo(vdupq_n_f32(0.f), window, getPhase(n), phaseLength));
+    }
+}
 
-    // for polyphase processing:
-    // decompose the filter coefficients to a set of new poly phase filter coefficients
-    float** polyPhaseFilterCoefficients = decomposeFilter(filterCoefficients, filterLength, ratio);
+
+void InterpolatorStereo::setInterpolationRatio(const uint ratio_)
+{
+    const uint index = getRatioIndex(ratio_);
     
-    // check for valid values
-    if (!polyPhaseFilterCoefficients)
-        engine_rt_error("Decomposing of Oversampling Filter wasn't succesfull!", __FILE__, __LINE__, true);
+    // check if setup() prepared a bank for this ratio
+    if (index == NUM_RATE_CONVERSION_RATIOS || filterLength % (2 * ratio_) != 0)
+        engine_rt_error("No polyphase filters for an interpolation ratio of " + TOSTRING(ratio_), __FILE__, __LINE__, true);
     
-    // calc the length of each poly phase filter (subband)
-    uint subBandLength = filterLength / ratio;
+    ratio = ratio_;
+    phaseLength = filterLength / ratio;
+    phases = coefficientPairs.data() + 2 * MAX_FILTER_LENGTH * index;
     
-    // setup each poly phase convolver
-    for (uint i = 0; i < ratio; i++)
-    {
-        polyPhaseConvolver[i].setup(subBandLength, polyPhaseFilterCoefficients[i]);
-        delete[] polyPhaseFilterCoefficients[i];
-    }
-
-    delete[] polyPhaseFilterCoefficients;
+    // the history is as long as a polyphase filter of the new ratio
+    delayLine.setup(phaseLength);
 }
 
 
@@ -380,48 +388,495 @@ void DecimatorStereo::setup(const float sampleRate_, const uint ratio_, const ui
     sampleRate = sampleRate_;
     filterLength = filterLength_;
     
+    // prepare the lowpass of every ratio, switching the ratio only selects one
+    for (uint index = 0; index < NUM_RATE_CONVERSION_RATIOS; ++index)
+    {
+        const uint filterRatio = 1u << index;
+        
+        // the same ratios as the banks of the interpolator
+        if (filterLength % (2 * filterRatio) != 0) continue;
+        
+        // retrieve the matching set of filter coefficients
+        const float* filterCoefficients = getFilterCoefficients(sampleRate, filterLength, filterRatio);
+        
+        // check if we found valid values
+        if (!filterCoefficients) engine_rt_error("No machting FIR LPF found for these specifications!", __FILE__, __LINE__, true);
+        
+        // the polyphase filters are evaluated at once over the oversampled history, newest first:
+        // interleaved in the order of the history they are the lowpass itself, every coefficient once for each channel
+        float32_t* pairs = coefficientPairs.data() + 2 * MAX_FILTER_LENGTH * index;
+        
+        for (uint n = 0; n < filterLength; ++n)
+            pairs[2 * n] = pairs[2 * n + 1] = filterCoefficients[n];
+    }
+    
     setDecimationRatio(ratio_);
 }
 
 
 float32x2_t DecimatorStereo::decimateAudio(const DecimatorStereoInput input_)
 {
-    float32x2_t output = vdup_n_f32(0.f);
+    const float* window = nullptr;
     
-    for (uint n = 0; n < ratio; ++n)
-        output = vadd_f32(output, polyPhaseConvolver[n].processAudioSamples(input_.audioData[n]));
+    // all polyphase filters are evaluated at once over the oversampled history
+    for (uint n = 0; n < ratio; ++n) window = delayLine.write(input_.audioData[n]);
 
-    return output;
+    return reduceStereoSum(convolveStereo(vdupq_n_f32(0.f), window, filter, filterLength));
+}
+
+
+void DecimatorStereo::decimateBlock(const float32x2_t* input_, float* const output_[2], const uint numFrames_)
+{
+    for (uint k = 0; k < numFrames_; ++k)
+    {
+        const float* window = nullptr;
+        
+        for (uint n = 0; n < ratio; ++n) window = delayLine.write(*input_++);
+        
+        const float32x2_t output = reduceStereoSum(convolveStereo(vdupq_n_f32(0.f), window, filter, filterLength));
+        output_[0][k] = vget_lane_f32(output, 0);
+        output_[1][k] = vget_lane_f32(output, 1);
+    }
 }
 
 
 void DecimatorStereo::setDecimationRatio(const uint ratio_)
 {
+    const uint index = getRatioIndex(ratio_);
+    
+    // check if setup() prepared a filter for this ratio
+    if (index == NUM_RATE_CONVERSION_RATIOS || filterLength % (2 * ratio_) != 0)
+        engine_rt_error("No polyphase filters for a decimation ratio of " + TOSTRING(ratio_), __FILE__, __LINE__, true);
+    
     ratio = ratio_;
+    filter = coefficientPairs.data() + 2 * MAX_FILTER_LENGTH * index;
     
-    // retrieve the matching set of filter coefficients
-    const float* filterCoefficients = getFilterCoefficients(sampleRate, filterLength, ratio);
+    delayLine.setup(filterLength);
+}
+
+
+// =======================================================================================
+// MARK: - HALF-BAND CASCADE
+// =======================================================================================
+
+void HalfbandStageStereo::setup(const uint filterLength_)
+{
+    const float* filterCoefficients = getHalfbandLowpass(filterLength_);
     
-    // check if we found valid values
-    if (!filterCoefficients) engine_rt_error("No machting FIR LPF found for these specifications!", __FILE__, __LINE__, true);
+    if (!filterCoefficients) engine_rt_error("Half-band filters need a length of a multiple of 4 from 8 to " + TOSTRING(MAX_FILTER_LENGTH), __FILE__, __LINE__, true);
+    
+    numTaps = filterLength_ / 2;
+    centerDelay = filterLength_ / 4 - 1;
+    
+    // the coefficients on even indices are the nonzero ones, the center one is on an odd index
+    for (uint n = 0; n < numTaps; ++n)
+        coefficientPairs[2 * n] = coefficientPairs[2 * n + 1] = filterCoefficients[2 * n];
+    
+    reset();
+}
 
-    // for polyphase processing:
-    // decompose the filter coefficients to a set of new poly phase filter coefficients
-    float** polyPhaseFilterCoefficients = decomposeFilter(filterCoefficients, filterLength, ratio);
+
+void HalfbandStageStereo::reset()
+{
+    std::fill(history.begin(), history.end(), vdup_n_f32(0.f));
+    std::fill(centerHistory.begin(), centerHistory.end(), vdup_n_f32(0.f));
+}
+
+
+void HalfbandStageStereo::interpolateBlock(const float32x2_t* input_, float32x2_t* output_, const uint numSamples_)
+{
+    // append the block behind the last numTaps - 1 samples
+    std::copy(input_, input_ + numSamples_, history.begin() + numTaps - 1);
     
-    // check for valid values
-    if (!polyPhaseFilterCoefficients)
-        engine_rt_error("Decomposing of Oversampling Filter wasn't succesfull!", __FILE__, __LINE__, true);
+    for (uint n = 0; n < numSamples_; ++n)
+    {
+        const float* window = (const float*)(history.data() + n);
+        
+        // the gain of 2 makes up for the inserted zeros, it turns the center coefficient into a plain delay
+        *output_++ = vmul_n_f32(reduceStereoSum(convolveStereo(vdupq_n_f32(0.f), window, coefficientPairs.data(), numTaps)), 2.f);
+        *output_++ = history[n + numTaps - 1 - centerDelay];
+    }
     
-    // calc the length of each poly phase filter (subband)
-    uint subBandLength = filterLength / ratio;
+    std::copy(history.begin() + numSamples_, history.begin() + numSamples_ + numTaps - 1, history.begin());
+}
+
+
+void HalfbandStageStereo::decimateBlock(const float32x2_t* input_, float32x2_t* output_, const uint numSamples_)
+{
+    // the odd samples run through the taps, the even ones through the delay
+    for (uint n = 0; n < numSamples_; ++n)
+    {
+        centerHistory[centerDelay + n] = input_[2 * n];
+        history[numTaps - 1 + n] = input_[2 * n + 1];
+    }
     
-    // setup each poly phase convolver
-    for (uint i = 0; i < ratio; i++)
+    for (uint n = 0; n < numSamples_; ++n)
     {
-        polyPhaseConvolver[i].setup(subBandLength, polyPhaseFilterCoefficients[i]);
-        delete[] polyPhaseFilterCoefficients[i];
+        const float* window = (const float*)(history.data() + n);
+        
+        const float32x2_t output = reduceStereoSum(convolveStereo(vdupq_n_f32(0.f), window, coefficientPairs.data(), numTaps));
+        output_[n] = vmla_n_f32(output, centerHistory[n], 0.5f);
     }
+    
+    std::copy(history.begin() + numSamples_, history.begin() + numSamples_ + numTaps - 1, history.begin());
+    std::copy(centerHistory.begin() + numSamples_, centerHistory.begin() + numSamples_ + centerDelay, centerHistory.begin());
+}
 
-    delete[] polyPhaseFilterCoefficients;
+
+void HalfbandInterpolatorStereo::setup(const uint ratio_, const uint filterLength_)
+{
+    // the lengths of the stages don't depend on the ratio, the designs are cached, only the first setup allocates
+    for (uint n = 0; n < MAX_HALFBAND_STAGES; ++n) stages[n].setup(getHalfbandStageLength(filterLength_, n));
+    
+    setInterpolationRatio(ratio_);
+}
+
+
+InterpolatorStereoOutput HalfbandInterpolatorStereo::interpolateAudio(const float32x2_t input_)
+{
+    InterpolatorStereoOutput output;
+    
+    interpolate(&input_, output.audioData, 1);
+    
+    return output;
+}
+
+
+void HalfbandInterpolatorStereo::interpolateBlock(const float* const input_[2], float32x2_t* output_, const uint numFrames_)
+{
+    // the last stage gets ratio / 2 samples per frame
+    const uint chunkSize = std::min(HALFBAND_BLOCKSIZE, std::max(1u, 2 * HALFBAND_BLOCKSIZE / ratio));
+    float32x2_t chunk[HALFBAND_BLOCKSIZE];
+    
+    for (uint start = 0; start < numFrames_; start += chunkSize)
+    {
+        const uint numChunkFrames = std::min(chunkSize, numFrames_ - start);
+        
+        for (uint n = 0; n < numChunkFrames; ++n) chunk[n] = makeStereo(input_[0][start + n], input_[1][start + n]);
+        
+        interpolate(chunk, output_ + start * ratio, numChunkFrames);
+    }
+}
+
+
+void HalfbandInterpolatorStereo::setInterpolationRatio(const uint ratio_)
+{
+    if (ratio_ == 0 || ratio_ > MAX_RATE_CONVERSION_RATIO || (ratio_ & (ratio_ - 1)) != 0)
+        engine_rt_error("Half-band cascades need a power of two ratio up to " + TOSTRING(MAX_RATE_CONVERSION_RATIO), __FILE__, __LINE__, true);
+    
+    ratio = ratio_;
+    numStages = 0;
+    
+    while ((1u << numStages) < ratio) ++numStages;
+    
+    for (uint n = 0; n < numStages; ++n) stages[n].reset();
+}
+
+
+void HalfbandInterpolatorStereo::interpolate(const float32x2_t* input_, float32x2_t* output_, const uint numFrames_)
+{
+    float32x2_t buffer[2][HALFBAND_BLOCKSIZE];
+    const float32x2_t* stageInput = input_;
+    uint numSamples = numFrames_;
+    
+    if (numStages == 0) std::copy(input_, input_ + numFrames_, output_);
+    
+    // every stage doubles the number of samples, the last one writes to the output
+    for (uint n = 0; n < numStages; ++n)
+    {
+        float32x2_t* stageOutput = (n == numStages - 1) ? output_ : buffer[n % 2];
+        
+        stages[n].interpolateBlock(stageInput, stageOutput, numSamples);
+        
+        stageInput = stageOutput;
+        numSamples *= 2;
+    }
+}
+
+
+void HalfbandDecimatorStereo::setup(const uint ratio_, const uint filterLength_)
+{
+    // the lengths of the stages don't depend on the ratio, the designs are cached, only the first setup allocates
+    for (uint n = 0; n < MAX_HALFBAND_STAGES; ++n) stages[n].setup(getHalfbandStageLength(filterLength_, n));
+    
+    setDecimationRatio(ratio_);
+}
+
+
+float32x2_t HalfbandDecimatorStereo::decimateAudio(const DecimatorStereoInput input_)
+{
+    float32x2_t output;
+    
+    decimate(input_.audioData, &output, 1);
+    
+    return output;
+}
+
+
+void HalfbandDecimatorStereo::decimateBlock(const float32x2_t* input_, float* const output_[2], const uint numFrames_)
+{
+    // the first stage returns ratio / 2 samples per frame
+    const uint chunkSize = std::min(HALFBAND_BLOCKSIZE, std::max(1u, 2 * HALFBAND_BLOCKSIZE / ratio));
+    float32x2_t chunk[HALFBAND_BLOCKSIZE];
+    
+    for (uint start = 0; start < numFrames_; start += chunkSize)
+    {
+        const uint numChunkFrames = std::min(chunkSize, numFrames_ - start);
+        
+        decimate(input_ + start * ratio, chunk, numChunkFrames);
+        
+        for (uint n = 0; n < numChunkFrames; ++n)
+        {
+            output_[0][start + n] = vget_lane_f32(chunk[n], 0);
+            output_[1][start + n] = vget_lane_f32(chunk[n], 1);
+        }
+    }
+}
+
+
+void HalfbandDecimatorStereo::setDecimationRatio(const uint ratio_)
+{
+    if (ratio_ == 0 || ratio_ > MAX_RATE_CONVERSION_RATIO || (ratio_ & (ratio_ - 1)) != 0)
+        engine_rt_error("Half-band cascades need a power of two ratio up to " + TOSTRING(MAX_RATE_CONVERSION_RATIO), __FILE__, __LINE__, true);
+    
+    ratio = ratio_;
+    numStages = 0;
+    
+    while ((1u << numStages) < ratio) ++numStages;
+    
+    for (uint n = 0; n < numStages; ++n) stages[n].reset();
+}
+
+
+void HalfbandDecimatorStereo::decimate(const float32x2_t* input_, float32x2_t* output_, const uint numFrames_)
+{
+    float32x2_t buffer[2][HALFBAND_BLOCKSIZE];
+    const float32x2_t* stageInput = input_;
+    uint numSamples = numFrames_ * ratio;
+    
+    if (numStages == 0) std::copy(input_, input_ + numFrames_, output_);
+    
+    // from the highest rate down, every stage halves the number of samples, the last one writes to the output
+    for (int n = (int)numStages - 1; n >= 0; --n)
+    {
+        numSamples /= 2;
+        float32x2_t* stageOutput = (n == 0) ? output_ : buffer[n % 2];
+        
+        stages[n].decimateBlock(stageInput, stageOutput, numSamples);
+        
+        stageInput = stageOutput;
+    }
+}
+
+
+// =======================================================================================
+// MARK: - ALLPASS HALF-BAND CASCADE
+// =======================================================================================
+
+void AllpassHalfbandStageStereo::setup(const uint stage_)
+{
+    uint numCoefficients;
+    const float* filterCoefficients = getAllpassHalfbandStage(stage_, numCoefficients);
+    
+    numSections = numCoefficients / 2;
+    
+    // the even coefficients belong to the first branch, the odd ones to the second one
+    for (uint n = 0; n < numSections; ++n)
+        coefficients[n] = makeQuad(filterCoefficients[2 * n], filterCoefficients[2 * n], filterCoefficients[2 * n + 1], filterCoefficients[2 * n + 1]);
+    
+    reset();
+}
+
+
+void AllpassHalfbandStageStereo::reset()
+{
+    std::fill(history.begin(), history.end(), vdupq_n_f32(0.f));
+}
+
+
+float32x4_t AllpassHalfbandStageStereo::processBranches(float32x4_t input_)
+{
+    // y[n] = x[n-1] + a * x[n] - a * y[n-1], the last output of a section is the last input of the next one,
+    // only the last product depends on the previous output
+    for (uint n = 0; n < numSections; ++n)
+    {
+        const float32x4_t output = vmlsq_f32(vmlaq_f32(history[n], coefficients[n], input_), coefficients[n], history[n + 1]);
+        history[n] = input_;
+        input_ = output;
+    }
+    
+    history[numSections] = input_;
+    
+    return input_;
+}
+
+
+void AllpassHalfbandStageStereo::interpolateBlock(const float32x2_t* input_, float32x2_t* output_, const uint numSamples_)
+{
+    // both branches get the input sample, each one returns one of the two output samples
+    for (uint n = 0; n < numSamples_; ++n)
+    {
+        const float32x4_t output = processBranches(vcombine_f32(input_[n], input_[n]));
+        
+        *output_++ = vget_low_f32(output);
+        *output_++ = vget_high_f32(output);
+    }
+}
+
+
+void AllpassHalfbandStageStereo::decimateBlock(const float32x2_t* input_, float32x2_t* output_, const uint numSamples_)
+{
+    // the first branch gets the odd samples, the second one the even ones, the output is their mean
+    for (uint n = 0; n < numSamples_; ++n)
+    {
+        const float32x4_t output = processBranches(vcombine_f32(input_[2 * n + 1], input_[2 * n]));
+        
+        output_[n] = vmul_n_f32(vadd_f32(vget_low_f32(output), vget_high_f32(output)), 0.5f);
+    }
+}
+
+
+void AllpassInterpolatorStereo::setup(const uint ratio_)
+{
+    // the designs are cached, only the first setup allocates
+    for (uint n = 0; n < MAX_HALFBAND_STAGES; ++n) stages[n].setup(n);
+    
+    setInterpolationRatio(ratio_);
+}
+
+
+InterpolatorStereoOutput AllpassInterpolatorStereo::interpolateAudio(const float32x2_t input_)
+{
+    InterpolatorStereoOutput output;
+    
+    interpolate(&input_, output.audioData, 1);
+    
+    return output;
+}
+
+
+void AllpassInterpolatorStereo::interpolateBlock(const float* const input_[2], float32x2_t* output_, const uint numFrames_)
+{
+    // the last stage gets ratio / 2 samples per frame
+    const uint chunkSize = std::min(HALFBAND_BLOCKSIZE, std::max(1u, 2 * HALFBAND_BLOCKSIZE / ratio));
+    float32x2_t chunk[HALFBAND_BLOCKSIZE];
+    
+    for (uint start = 0; start < numFrames_; start += chunkSize)
+    {
+        const uint numChunkFrames = std::min(chunkSize, numFrames_ - start);
+        
+        for (uint n = 0; n < numChunkFrames; ++n) chunk[n] = makeStereo(input_[0][start + n], input_[1][start + n]);
+        
+        interpolate(chunk, output_ + start * ratio, numChunkFrames);
+    }
+}
+
+
+void AllpassInterpolatorStereo::setInterpolationRatio(const uint ratio_)
+{
+    if (ratio_ == 0 || ratio_ > MAX_RATE_CONVERSION_RATIO || (ratio_ & (ratio_ - 1)) != 0)
+        engine_rt_error("Half-band cascades need a power of two ratio up to " + TOSTRING(MAX_RATE_CONVERSION_RATIO), __FILE__, __LINE__, true);
+    
+    ratio = ratio_;
+    numStages = 0;
+    
+    while ((1u << numStages) < ratio) ++numStages;
+    
+    for (uint n = 0; n < numStages; ++n) stages[n].reset();
+}
+
+
+void AllpassInterpolatorStereo::interpolate(const float32x2_t* input_, float32x2_t* output_, const uint numFrames_)
+{
+    float32x2_t buffer[2][HALFBAND_BLOCKSIZE];
+    const float32x2_t* stageInput = input_;
+    uint numSamples = numFrames_;
+    
+    if (numStages == 0) std::copy(input_, input_ + numFrames_, output_);
+    
+    // every stage doubles the number of samples, the last one writes to the output
+    for (uint n = 0; n < numStages; ++n)
+    {
+        float32x2_t* stageOutput = (n == numStages - 1) ? output_ : buffer[n % 2];
+        
+        stages[n].interpolateBlock(stageInput, stageOutput, numSamples);
+        
+        stageInput = stageOutput;
+        numSamples *= 2;
+    }
+}
+
+
+void AllpassDecimatorStereo::setup(const uint ratio_)
+{
+    // the designs are cached, only the first setup allocates
+    for (uint n = 0; n < MAX_HALFBAND_STAGES; ++n) stages[n].setup(n);
+    
+    setDecimationRatio(ratio_);
+}
+
+
+float32x2_t AllpassDecimatorStereo::decimateAudio(const DecimatorStereoInput input_)
+{
+    float32x2_t output;
+    
+    decimate(input_.audioData, &output, 1);
+    
+    return output;
+}
+
+
+void AllpassDecimatorStereo::decimateBlock(const float32x2_t* input_, float* const output_[2], const uint numFrames_)
+{
+    // the first stage returns ratio / 2 samples per frame
+    const uint chunkSize = std::min(HALFBAND_BLOCKSIZE, std::max(1u, 2 * HALFBAND_BLOCKSIZE / ratio));
+    float32x2_t chunk[HALFBAND_BLOCKSIZE];
+    
+    for (uint start = 0; start < numFrames_; start += chunkSize)
+    {
+        const uint numChunkFrames = std::min(chunkSize, numFrames_ - start);
+        
+        decimate(input_ + start * ratio, chunk, numChunkFrames);
+        
+        for (uint n = 0; n < numChunkFrames; ++n)
+        {
+            output_[0][start + n] = vget_lane_f32(chunk[n], 0);
+            output_[1][start + n] = vget_lane_f32(chunk[n], 1);
+        }
+    }
+}
+
+
+void AllpassDecimatorStereo::setDecimationRatio(const uint ratio_)
+{
+    if (ratio_ == 0 || ratio_ > MAX_RATE_CONVERSION_RATIO || (ratio_ & (ratio_ - 1)) != 0)
+        engine_rt_error("Half-band cascades need a power of two ratio up to " + TOSTRING(MAX_RATE_CONVERSION_RATIO), __FILE__, __LINE__, true);
+    
+    ratio = ratio_;
+    numStages = 0;
+    
+    while ((1u << numStages) < ratio) ++numStages;
+    
+    for (uint n = 0; n < numStages; ++n) stages[n].reset();
+}
+
+
+void AllpassDecimatorStereo::decimate(const float32x2_t* input_, float32x2_t* output_, const uint numFrames_)
+{
+    float32x2_t buffer[2][HALFBAND_BLOCKSIZE];
+    const float32x2_t* stageInput = input_;
+    uint numSamples = numFrames_ * ratio;
+    
+    if (numStages == 0) std::copy(input_, input_ + numFrames_, output_);
+    
+    // from the highest rate down, every stage halves the number of samples, the last one writes to the output
+    for (int n = (int)numStages - 1; n >= 0; --n)
+    {
+        numSamples /= 2;
+        float32x2_t* stageOutput = (n == 0) ? output_ : buffer[n % 2];
+        
+        stages[n].decimateBlock(stageInput, stageOutput, numSamples);
+        
+        stageInput = stageOutput;
+    }
 }
@@ -1,9 +1,7 @@
 #pragma once
 
 #include "../Functions.h"
-
-static const uint MAX_RATE_CONVERSION_RATIO = 8;
-static const uint MAX_FILTER_LENGTH = 256;
+#include "FilterDesign.h"
 
 // =======================================================================================
 // MARK: - HELPER FUNCTIONS
@@ -37,8 +35,110 @@ inline float** decomposeFilter(const float* filterCoefficients_, const uint filt
  * @param ratio_ The upsampling or downsampling ratio (supported values: 2, 4, or 8).
  * @return A pointer to a predefined filter coefficient array, or `nullptr` if the configuration is unsupported.
  */
+inline const float* getFilterTable(const float sampleRate_, const uint filterLength_, const uint ratio_);
+
+/**
+ * @brief Retrieves the low-pass filter coefficients for up- and downsampling.
+ *
+ * Uses the predefined table if there is one for the configuration, otherwise a Kaiser lowpass
+ * that is designed on the first request (see `getOversamplingLowpass()`).
+ *
+ * @param sampleRate_ The sample rate in Hz.
+ * @param filterLength_ The length of the desired filter, at most MAX_FILTER_LENGTH.
+ * @param ratio_ The upsampling or downsampling ratio, at most MAX_RATE_CONVERSION_RATIO.
+ * @return A pointer to the filter coefficient array, or `nullptr` if the configuration is invalid.
+ */
 inline const float* getFilterCoefficients(const float sampleRate_, const uint filterLength_, const uint ratio_);
 
+/**
+ * @brief Returns the index of the polyphase bank of a ratio.
+ * @param ratio_ The up- or downsampling ratio.
+ * @return log2 of the ratio, NUM_RATE_CONVERSION_RATIOS if the ratio isn't a power of two up to MAX_RATE_CONVERSION_RATIO.
+ */
+inline uint getRatioIndex(const uint ratio_)
+{
+    for (uint n = 0; n < NUM_RATE_CONVERSION_RATIOS; ++n)
+        if ((1u << n) == ratio_) return n;
+    
+    return NUM_RATE_CONVERSION_RATIOS;
+}
+
+/**
+ * @brief Multiplies a window of stereo samples with a set of coefficients and adds the products to a running sum.
+ *
+ * The samples and the coefficients are read as contiguous arrays, two taps per SIMD vector, without any index wrapping.
+ *
+ * @param sum_ The running sum, lanes 0 and 2 hold the left, lanes 1 and 3 the right channel.
+ * @param window_ Interleaved stereo samples (L R L R ...), the newest sample first.
+ * @param coefficientPairs_ The coefficients, every coefficient twice, once for each channel.
+ * @param numTaps_ The number of taps, must be a multiple of 2.
+ * @return The new running sum, `reduceStereoSum()` turns it into the stereo output.
+ */
+inline float32x4_t convolveStereo(float32x4_t sum_, const float* window_, const float* coefficientPairs_, const uint numTaps_)
+{
+    for (uint n = 0; n < 2 * numTaps_; n += 4)
+        sum_ = vmlaq_f32(sum_, vld1q_f32(coefficientPairs_ + n), vld1q_f32(window_ + n));
+    
+    return sum_;
+}
+
+/** @brief Adds the two stereo halves of a running sum of `convolveStereo()`. */
+inline float32x2_t reduceStereoSum(const float32x4_t sum_)
+{
+    return vadd_f32(vget_low_f32(sum_), vget_high_f32(sum_));
+}
+
+
+// =======================================================================================
+// MARK: - MIRRORED DELAY LINE
+// =======================================================================================
+
+/**
+ * @class MirroredDelayLineStereo
+ * @brief The input history of an FIR filter, as one contiguous window of interleaved stereo samples.
+ *
+ * The buffer has twice the length of the filter and every sample is written to both halves. The write pointer
+ * runs backwards, so the newest `length` samples always start at the write pointer and lie in one piece,
+ * newest first, and a dot product never has to wrap around.
+ */
+class MirroredDelayLineStereo
+{
+public:
+    /**
+     * @brief Sets the length and clears the buffer.
+     * @param length_ The length of the window in samples, at most MAX_FILTER_LENGTH.
+     */
+    void setup(const uint length_)
+    {
+        length = length_;
+        writePointer = 0;
+        std::fill(buffer.begin(), buffer.end(), 0.f);
+    }
+    
+    /**
+     * @brief Writes a stereo sample.
+     * @param input_ The stereo sample.
+     * @return The window of the last `length` samples, interleaved, the new sample first.
+     */
+    const float* write(const float32x2_t input_)
+    {
+        writePointer = (writePointer == 0) ? length - 1 : writePointer - 1;
+        
+        float* first = buffer.data() + 2 * writePointer;
+        float* second = first + 2 * length;
+        
+        first[0] = second[0] = vget_lane_f32(input_, 0);
+        first[1] = second[1] = vget_lane_f32(input_, 1);
+        
+        return first;
+    }
+
+private:
+    uint length = 0; ///< The length of the window in samples.
+    uint writePointer = 0; ///< The position of the newest sample in the first half.
+    alignas(16) std::array<float, 4 * MAX_FILTER_LENGTH> buffer; ///< Two copies of the window, interleaved stereo.
+};
+
 
 // =======================================================================================
 // MARK: - CONVOLVER
@@ -71,9 +171,9 @@ public:
 
 private:
     uint filterLength; ///< The length of the FIR filter.
-    std::array<float, MAX_FILTER_LENGTH> buffer; ///< Circular buffer for storing input samples.
-    std::array<float, MAX_FILTER_LENGTH> filterCoefficients; ///< Array of filter coefficients.
-    uint writePointer; ///< Pointer to the current position in the circular buffer.
+    alignas(16) std::array<float, 2 * MAX_FILTER_LENGTH> buffer; ///< Mirrored delay line, the last samples are one contiguous window.
+    alignas(16) std::array<float, MAX_FILTER_LENGTH> filterCoefficients; ///< Array of filter coefficients.
+    uint writePointer; ///< Position of the newest sample, runs backwards.
 };
 
 /**
@@ -103,9 +203,8 @@ public:
 
 private:
     uint filterLength; ///< The length of the FIR filter.
-    std::array<float32x2_t, MAX_FILTER_LENGTH> buffer; ///< Circular buffer for storing input stereo samples.
-    std::array<float32_t, MAX_FILTER_LENGTH> filterCoefficients; ///< Array of filter coefficients.
-    uint writePointer; ///< Pointer to the current position in the circular buffer.
+    MirroredDelayLineStereo delayLine; ///< The input history as one contiguous window.
+    alignas(16) std::array<float32_t, 2 * MAX_FILTER_LENGTH> coefficientPairs; ///< Every filter coefficient twice, for both channels.
 };
 
 
@@ -206,12 +305,12 @@ public:
     /**
      * @brief Configures the stereo interpolator with the given sample rate, ratio, and filter length.
      *
-     * Initializes the stereo interpolator with the specified sample rate, interpolation ratio,
-     * and FIR filter length. Sets up the polyphase filters for stereo processing.
+     * Decomposes the lowpass of every ratio into a bank of polyphase filters for stereo processing,
+     * which is the only allocation of the interpolator, and selects the bank of the given ratio.
      *
      * @param sampleRate_ The sample rate of the input signal in Hz.
-     * @param ratio_ The interpolation ratio (e.g., 2, 4, 8).
-     * @param filterLength_ The length of the FIR filter.
+     * @param ratio_ The interpolation ratio, a power of two (e.g., 2, 4, 8).
+     * @param filterLength_ The length of the FIR filter, banks are only prepared for the ratios `r` with `filterLength_ % (2 * r) == 0`.
      */
     void setup(const float sampleRate_, const uint ratio_, const uint filterLength_);
     
@@ -227,20 +326,40 @@ public:
     InterpolatorStereoOutput interpolateAudio(const float32x2_t input_);
     
     /**
-     * @brief Updates the interpolation ratio and reconfigures the polyphase filters.
+     * @brief Interpolates a block of non-interleaved stereo samples.
      *
-     * Adjusts the interpolation ratio and reinitializes the polyphase filter coefficients.
+     * Same result as calling `interpolateAudio()` for every sample, without the per-sample output struct.
+     *
+     * @param input_ Pointers to the left and right input channel.
+     * @param output_ Receives `ratio` stereo samples per input sample, `numFrames_ * ratio` in total.
+     * @param numFrames_ The number of input samples per channel.
+     */
+    void interpolateBlock(const float* const input_[2], float32x2_t* output_, const uint numFrames_);
+    
+    /**
+     * @brief Updates the interpolation ratio.
+     *
+     * Selects the polyphase bank that `setup()` prepared for the ratio and clears the input history,
+     * it neither allocates nor designs filters, so it can be called from the audio thread.
      *
      * @param ratio_ The new interpolation ratio.
      */
     void setInterpolationRatio(const uint ratio_);
+    
+    /** @brief Returns the current interpolation ratio. */
+    uint getInterpolationRatio() const { return ratio; }
 
 private:
+    /** @brief Returns the coefficient pairs of the polyphase filter that computes the given output sample. */
+    const float* getPhase(const uint outputIndex_) const { return phases + 2 * outputIndex_ * phaseLength; }
+    
     float sampleRate; ///< The sample rate of the input audio signal in Hz.
     uint ratio; ///< The current interpolation ratio.
     uint filterLength; ///< The length of the FIR filter.
-    ConvolverStereo polyPhaseConvolver[MAX_RATE_CONVERSION_RATIO]; ///< Array of polyphase convolvers for stereo processing.
-    float32_t gainCompensation; ///< Gain compensation factor for interpolated samples.
+    uint phaseLength; ///< The length of each polyphase filter.
+    const float* phases = nullptr; ///< The polyphase bank of the current ratio.
+    MirroredDelayLineStereo delayLine; ///< The input history, which all polyphase filters share.
+    alignas(16) std::array<float32_t, 2 * MAX_FILTER_LENGTH * NUM_RATE_CONVERSION_RATIOS> coefficientPairs; ///< A bank for every ratio, its polyphase filters one after another, as coefficient pairs, scaled by the gain compensation.
 };
 
 
@@ -336,12 +455,12 @@ public:
     /**
      * @brief Configures the stereo decimator with the given sample rate, ratio, and filter length.
      *
-     * Initializes the stereo decimator with the specified sample rate, decimation ratio,
-     * and FIR filter length. Sets up the polyphase filters for stereo processing.
+     * Prepares the lowpass of every ratio as coefficient pairs for stereo processing, which is
+     * the only allocation of the decimator, and selects the one of the given ratio.
      *
      * @param sampleRate_ The sample rate of the input signal in Hz.
-     * @param ratio_ The decimation ratio (e.g., 2, 4, 8).
-     * @param filterLength_ The length of the FIR filter.
+     * @param ratio_ The decimation ratio, a power of two (e.g., 2, 4, 8).
+     * @param filterLength_ The length of the FIR filter, filters are only prepared for the ratios `r` with `filterLength_ % (2 * r) == 0`.
      */
     void setup(const float sampleRate_, const uint ratio_, const uint filterLength_);
     
@@ -357,19 +476,334 @@ public:
     float32x2_t decimateAudio(const DecimatorStereoInput input_);
     
     /**
-     * @brief Updates the decimation ratio and reconfigures the polyphase filters.
+     * @brief Decimates a block of oversampled stereo samples into non-interleaved output channels.
      *
-     * Adjusts the decimation ratio and reinitializes the polyphase filter coefficients.
+     * Same result as calling `decimateAudio()` for every group of `ratio` samples.
+     *
+     * @param input_ `numFrames_ * ratio` oversampled stereo samples.
+     * @param output_ Pointers to the left and right output channel.
+     * @param numFrames_ The number of output samples per channel.
+     */
+    void decimateBlock(const float32x2_t* input_, float* const output_[2], const uint numFrames_);
+    
+    /**
+     * @brief Updates the decimation ratio.
+     *
+     * Selects the filter that `setup()` prepared for the ratio and clears the input history,
+     * it neither allocates nor designs filters, so it can be called from the audio thread.
      *
      * @param ratio_ The new decimation ratio.
      */
     void setDecimationRatio(const uint ratio_);
+    
+    /** @brief Returns the current decimation ratio. */
+    uint getDecimationRatio() const { return ratio; }
 
 private:
     float sampleRate; ///< The sample rate of the input audio signal in Hz.
     uint ratio; ///< The current decimation ratio.
     uint filterLength; ///< The length of the FIR filter.
-    ConvolverStereo polyPhaseConvolver[MAX_RATE_CONVERSION_RATIO]; ///< Array of polyphase convolvers for stereo processing.
+    const float* filter = nullptr; ///< The coefficient pairs of the current ratio.
+    MirroredDelayLineStereo delayLine; ///< The oversampled input history.
+    alignas(16) std::array<float32_t, 2 * MAX_FILTER_LENGTH * NUM_RATE_CONVERSION_RATIOS> coefficientPairs; ///< The lowpass of every ratio, as coefficient pairs.
+};
+
+
+// =======================================================================================
+// MARK: - HALF-BAND CASCADE
+// =======================================================================================
+
+/** @brief the number of 2x stages of a half-band cascade at the highest ratio */
+static const uint MAX_HALFBAND_STAGES = 4;
+
+/** @brief the number of lower rate samples a half-band stage processes at once */
+static const uint HALFBAND_BLOCKSIZE = 64;
+
+/**
+ * @class HalfbandStageStereo
+ * @brief A 2x up- or downsampling stage with a half-band FIR filter.
+ *
+ * Every second coefficient of a half-band filter is 0, except for the center one, which is 0.5. One polyphase
+ * branch is therefore a plain delay and the other one holds all the taps, a stage costs half the multiplications
+ * of a regular polyphase filter of the same length. The taps of that branch are symmetric, so they are applied
+ * to the history in chronological order: the new samples are appended to a linear buffer behind the last ones,
+ * every output reads a contiguous window, and the end of the buffer is moved to the front after each block.
+ * A stage is used either for upsampling or for downsampling.
+ */
+class HalfbandStageStereo
+{
+public:
+    /**
+     * @brief Sets up the stage and clears its history.
+     * @param filterLength_ The length of the half-band filter, see `getHalfbandLowpass()`.
+     */
+    void setup(const uint filterLength_);
+    
+    /** @brief Clears the history. */
+    void reset();
+    
+    /**
+     * @brief Upsamples a block of stereo samples.
+     * @param input_ The input samples.
+     * @param output_ Receives two samples per input sample.
+     * @param numSamples_ The number of input samples, at most HALFBAND_BLOCKSIZE.
+     */
+    void interpolateBlock(const float32x2_t* input_, float32x2_t* output_, const uint numSamples_);
+    
+    /**
+     * @brief Downsamples a block of stereo samples.
+     * @param input_ Two input samples per output sample.
+     * @param output_ Receives the output samples.
+     * @param numSamples_ The number of output samples, at most HALFBAND_BLOCKSIZE.
+     */
+    void decimateBlock(const float32x2_t* input_, float32x2_t* output_, const uint numSamples_);
+
+private:
+    uint numTaps; ///< The number of taps of the branch with the nonzero coefficients.
+    uint centerDelay; ///< The delay of the other branch, in samples of the lower rate.
+    alignas(16) std::array<float32x2_t, MAX_FILTER_LENGTH / 2 + HALFBAND_BLOCKSIZE> history; ///< The last input samples (the odd ones when downsampling), oldest first.
+    alignas(16) std::array<float32x2_t, MAX_FILTER_LENGTH / 4 + HALFBAND_BLOCKSIZE> centerHistory; ///< The last even input samples when downsampling.
+    alignas(16) std::array<float32_t, MAX_FILTER_LENGTH> coefficientPairs; ///< The nonzero coefficients, as coefficient pairs.
+};
+
+/**
+ * @class HalfbandInterpolatorStereo
+ * @brief Upsamples by a power of two with a cascade of half-band stages.
+ *
+ * A drop-in for `InterpolatorStereo`. The first stage has the given filter length and sets the passband.
+ * The following stages only have to remove the images around the lower sample rates, their transition bands
+ * are much wider and they get by with a few taps (see `getHalfbandStageLength()`). High ratios reach the
+ * attenuation of the first stage with a fraction of the multiplications of a single polyphase filter. The stages
+ * don't depend on the ratio, they are all set up at once and changing the ratio doesn't allocate.
+ */
+class HalfbandInterpolatorStereo
+{
+public:
+    /**
+     * @brief Sets up the stages of every ratio.
+     * @param ratio_ The interpolation ratio, a power of two up to MAX_RATE_CONVERSION_RATIO.
+     * @param filterLength_ The length of the first stage.
+     */
+    void setup(const uint ratio_, const uint filterLength_);
+    
+    /**
+     * @brief Interpolates a stereo sample.
+     * @param input_ The stereo input sample.
+     * @return `ratio` upsampled stereo samples.
+     */
+    InterpolatorStereoOutput interpolateAudio(const float32x2_t input_);
+    
+    /**
+     * @brief Interpolates a block of non-interleaved stereo samples, stage by stage.
+     * @param input_ Pointers to the left and right input channel.
+     * @param output_ Receives `ratio` stereo samples per input sample, `numFrames_ * ratio` in total.
+     * @param numFrames_ The number of input samples per channel.
+     */
+    void interpolateBlock(const float* const input_[2], float32x2_t* output_, const uint numFrames_);
+    
+    /**
+     * @brief Updates the interpolation ratio and clears the history of the stages, safe to call from the audio thread.
+     * @param ratio_ The new interpolation ratio, a power of two.
+     */
+    void setInterpolationRatio(const uint ratio_);
+
+private:
+    /** @brief Runs stereo samples through all stages, the stage at the highest rate gets at most HALFBAND_BLOCKSIZE samples. */
+    void interpolate(const float32x2_t* input_, float32x2_t* output_, const uint numFrames_);
+    
+    uint ratio; ///< The current interpolation ratio.
+    uint numStages; ///< The number of stages, log2 of the ratio.
+    HalfbandStageStereo stages[MAX_HALFBAND_STAGES]; ///< The stages, from the lowest to the highest rate.
+};
+
+/**
+ * @class HalfbandDecimatorStereo
+ * @brief Downsamples by a power of two with a cascade of half-band stages.
+ *
+ * A drop-in for `DecimatorStereo`, see `HalfbandInterpolatorStereo`.
+ */
+class HalfbandDecimatorStereo
+{
+public:
+    /**
+     * @brief Sets up the stages of every ratio.
+     * @param ratio_ The decimation ratio, a power of two up to MAX_RATE_CONVERSION_RATIO.
+     * @param filterLength_ The length of the last stage, which runs at twice the output rate.
+     */
+    void setup(const uint ratio_, const uint filterLength_);
+    
+    /**
+     * @brief Decimates `ratio` stereo samples.
+     * @param input_ A `DecimatorStereoInput` struct containing the stereo audio data to decimate.
+     * @return The downsampled stereo audio sample.
+     */
+    float32x2_t decimateAudio(const DecimatorStereoInput input_);
+    
+    /**
+     * @brief Decimates a block of oversampled stereo samples into non-interleaved output channels, stage by stage.
+     * @param input_ `numFrames_ * ratio` oversampled stereo samples.
+     * @param output_ Pointers to the left and right output channel.
+     * @param numFrames_ The number of output samples per channel.
+     */
+    void decimateBlock(const float32x2_t* input_, float* const output_[2], const uint numFrames_);
+    
+    /**
+     * @brief Updates the decimation ratio and clears the history of the stages, safe to call from the audio thread.
+     * @param ratio_ The new decimation ratio, a power of two.
+     */
+    void setDecimationRatio(const uint ratio_);
+
+private:
+    /** @brief Runs stereo samples through all stages, the stage at the highest rate returns at most HALFBAND_BLOCKSIZE samples. */
+    void decimate(const float32x2_t* input_, float32x2_t* output_, const uint numFrames_);
+    
+    uint ratio; ///< The current decimation ratio.
+    uint numStages; ///< The number of stages, log2 of the ratio.
+    HalfbandStageStereo stages[MAX_HALFBAND_STAGES]; ///< The stages, from the lowest to the highest rate.
+};
+
+
+// =======================================================================================
+// MARK: - ALLPASS HALF-BAND CASCADE
+// =======================================================================================
+
+/**
+ * @class AllpassHalfbandStageStereo
+ * @brief A 2x up- or downsampling stage with an elliptic half-band filter made of allpass sections.
+ *
+ * Both branches of the filter (see `designAllpassHalfband()`) run at the lower rate, side by side in one SIMD vector:
+ * lanes 0 and 1 hold the left and right sample of the first branch, lanes 2 and 3 the ones of the second branch.
+ * A section of both branches costs one multiply-add per sample. The filter is recursive, its group delay is a few
+ * samples in the passband instead of half the length of a linear phase filter, but it varies with the frequency.
+ * A stage is used either for upsampling or for downsampling.
+ */
+class AllpassHalfbandStageStereo
+{
+public:
+    /**
+     * @brief Sets up the stage and clears its history.
+     * @param stage_ The index of the stage in its cascade, which selects the filter, see `getAllpassHalfbandStage()`.
+     */
+    void setup(const uint stage_);
+    
+    /** @brief Clears the history of the sections. */
+    void reset();
+    
+    /**
+     * @brief Upsamples a block of stereo samples.
+     * @param input_ The input samples.
+     * @param output_ Receives two samples per input sample.
+     * @param numSamples_ The number of input samples.
+     */
+    void interpolateBlock(const float32x2_t* input_, float32x2_t* output_, const uint numSamples_);
+    
+    /**
+     * @brief Downsamples a block of stereo samples.
+     * @param input_ Two input samples per output sample.
+     * @param output_ Receives the output samples.
+     * @param numSamples_ The number of output samples.
+     */
+    void decimateBlock(const float32x2_t* input_, float32x2_t* output_, const uint numSamples_);
+
+private:
+    /** @brief Runs a sample of both branches through their sections. */
+    float32x4_t processBranches(float32x4_t input_);
+    
+    uint numSections; ///< The number of sections of each branch.
+    alignas(16) std::array<float32x4_t, MAX_ALLPASS_COEFFICIENTS / 2> coefficients; ///< The coefficients of both branches, in the lanes of the samples.
+    alignas(16) std::array<float32x4_t, MAX_ALLPASS_COEFFICIENTS / 2 + 1> history; ///< The last input of every section, followed by the last output of the branches.
+};
+
+/**
+ * @class AllpassInterpolatorStereo
+ * @brief Upsamples by a power of two with a cascade of allpass half-band stages.
+ *
+ * A low latency drop-in for `InterpolatorStereo`. The first stage sets the passband, the following ones only have
+ * to remove the images around the lower sample rates and get by with two coefficients. The stages don't depend on
+ * the ratio, they are all set up at once and changing the ratio doesn't allocate.
+ */
+class AllpassInterpolatorStereo
+{
+public:
+    /**
+     * @brief Sets up the stages of every ratio.
+     * @param ratio_ The interpolation ratio, a power of two up to MAX_RATE_CONVERSION_RATIO.
+     */
+    void setup(const uint ratio_);
+    
+    /**
+     * @brief Interpolates a stereo sample.
+     * @param input_ The stereo input sample.
+     * @return `ratio` upsampled stereo samples.
+     */
+    InterpolatorStereoOutput interpolateAudio(const float32x2_t input_);
+    
+    /**
+     * @brief Interpolates a block of non-interleaved stereo samples, stage by stage.
+     * @param input_ Pointers to the left and right input channel.
+     * @param output_ Receives `ratio` stereo samples per input sample, `numFrames_ * ratio` in total.
+     * @param numFrames_ The number of input samples per channel.
+     */
+    void interpolateBlock(const float* const input_[2], float32x2_t* output_, const uint numFrames_);
+    
+    /**
+     * @brief Updates the interpolation ratio and clears the history of the stages, safe to call from the audio thread.
+     * @param ratio_ The new interpolation ratio, a power of two.
+     */
+    void setInterpolationRatio(const uint ratio_);
+
+private:
+    /** @brief Runs stereo samples through all stages, the stage at the highest rate gets at most HALFBAND_BLOCKSIZE samples. */
+    void interpolate(const float32x2_t* input_, float32x2_t* output_, const uint numFrames_);
+    
+    uint ratio; ///< The current interpolation ratio.
+    uint numStages; ///< The number of stages, log2 of the ratio.
+    AllpassHalfbandStageStereo stages[MAX_HALFBAND_STAGES]; ///< The stages, from the lowest to the highest rate.
+};
+
+/**
+ * @class AllpassDecimatorStereo
+ * @brief Downsamples by a power of two with a cascade of allpass half-band stages.
+ *
+ * A low latency drop-in for `DecimatorStereo`, see `AllpassInterpolatorStereo`.
+ */
+class AllpassDecimatorStereo
+{
+public:
+    /**
+     * @brief Sets up the stages of every ratio.
+     * @param ratio_ The decimation ratio, a power of two up to MAX_RATE_CONVERSION_RATIO.
+     */
+    void setup(const uint ratio_);
+    
+    /**
+     * @brief Decimates `ratio` stereo samples.
+     * @param input_ A `DecimatorStereoInput` struct containing the stereo audio data to decimate.
+     * @return The downsampled stereo audio sample.
+     */
+    float32x2_t decimateAudio(const DecimatorStereoInput input_);
+    
+    /**
+     * @brief Decimates a block of oversampled stereo samples into non-interleaved output channels, stage by stage.
+     * @param input_ `numFrames_ * ratio` oversampled stereo samples.
+     * @param output_ Pointers to the left and right output channel.
+     * @param numFrames_ The number of output samples per channel.
+     */
+    void decimateBlock(const float32x2_t* input_, float* const output_[2], const uint numFrames_);
+    
+    /**
+     * @brief Updates the decimation ratio and clears the history of the stages, safe to call from the audio thread.
+     * @param ratio_ The new decimation ratio, a power of two.
+     */
+    void setDecimationRatio(const uint ratio_);
+
+private:
+    /** @brief Runs stereo samples through all stages, the stage at the highest rate returns at most HALFBAND_BLOCKSIZE samples. */
+    void decimate(const float32x2_t* input_, float32x2_t* output_, const uint numFrames_);
+    
+    uint ratio; ///< The current decimation ratio.
+    uint numStages; ///< The number of stages, log2 of the ratio.
+    AllpassHalfbandStageStereo stages[MAX_HALFBAND_STAGES]; ///< The stages, from the lowest to the highest rate.
 };
 
 
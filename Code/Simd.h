@@ -0,0 +1,272 @@
+#pragma once
+
+/**
+ * @file Simd.h
+ * @brief Thin header-only SIMD layer for the stereo pair (float32x2_t) and quad (float32x4_t) types.
+ *
+ * All DSP modules are written against the NEON vector types and intrinsic names. This header decides
+ * where they come from:
+ * - **NEON** (BELA, any ARM target): `<arm_neon.h>` is used directly, nothing changes.
+ * - **SSE** (x86 with SSE2): the types are compiler vector types, which GCC and Clang map onto
+ *   SSE registers. Operations the compiler can't express well (bit select, absolute value,
+ *   float to int conversion) use SSE intrinsics on the quad type.
+ * - **Scalar** (any other target): the same compiler vector types, lowered to scalar code by the compiler.
+ *
+ * Only the subset of intrinsics used in this code base is provided for the non-NEON backends.
+ * Multiply-accumulate functions are computed unfused (multiply, then add), like `vmla` on NEON,
+ * so all backends produce the same results, except for the reciprocal estimate `vrecpeq_f32()`.
+ */
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+#define GRAINMOTHER_SIMD_NEON
+#include <arm_neon.h>
+
+#else
+
+#if defined(__SSE2__)
+#define GRAINMOTHER_SIMD_SSE
+#include <emmintrin.h>
+#else
+#define GRAINMOTHER_SIMD_SCALAR
+#endif
+
+#include <cstdint>
+#include <cstring>
+
+// =======================================================================================
+// MARK: - TYPES
+// =======================================================================================
+
+typedef float float32_t;
+
+typedef float float32x2_t __attribute__((vector_size(8)));
+typedef float float32x4_t __attribute__((vector_size(16)));
+typedef int32_t int32x2_t __attribute__((vector_size(8)));
+typedef int32_t int32x4_t __attribute__((vector_size(16)));
+typedef uint32_t uint32x2_t __attribute__((vector_size(8)));
+typedef uint32_t uint32x4_t __attribute__((vector_size(16)));
+
+struct float32x4x2_t { float32x4_t val[2]; };
+
+
+// =======================================================================================
+// MARK: - STEREO PAIR (float32x2_t)
+// =======================================================================================
+
+inline float32x2_t vdup_n_f32(const float32_t value_) { return (float32x2_t){ value_, value_ }; }
+
+inline float32x2_t vadd_f32(const float32x2_t a_, const float32x2_t b_) { return a_ + b_; }
+inline float32x2_t vsub_f32(const float32x2_t a_, const float32x2_t b_) { return a_ - b_; }
+inline float32x2_t vmul_f32(const float32x2_t a_, const float32x2_t b_) { return a_ * b_; }
+inline float32x2_t vmul_n_f32(const float32x2_t a_, const float32_t b_) { return a_ * b_; }
+
+inline float32x2_t vmla_f32(const float32x2_t a_, const float32x2_t b_, const float32x2_t c_) { return a_ + b_ * c_; }
+inline float32x2_t vmla_n_f32(const float32x2_t a_, const float32x2_t b_, const float32_t c_) { return a_ + b_ * c_; }
+inline float32x2_t vmls_f32(const float32x2_t a_, const float32x2_t b_, const float32x2_t c_) { return a_ - b_ * c_; }
+inline float32x2_t vmls_n_f32(const float32x2_t a_, const float32x2_t b_, const float32_t c_) { return a_ - b_ * c_; }
+
+inline float32x2_t vneg_f32(const float32x2_t a_) { return -a_; }
+inline float32x2_t vabs_f32(const float32x2_t a_)
+{
+    return (float32x2_t)((uint32x2_t)a_ & (uint32x2_t){ 0x7FFFFFFF, 0x7FFFFFFF });
+}
+
+inline float32x2_t vpadd_f32(const float32x2_t a_, const float32x2_t b_)
+{
+    return (float32x2_t){ a_[0] + a_[1], b_[0] + b_[1] };
+}
+inline float32x2_t vrev64_f32(const float32x2_t a_) { return (float32x2_t){ a_[1], a_[0] }; }
+
+inline uint32x2_t vcle_f32(const float32x2_t a_, const float32x2_t b_) { return (uint32x2_t)(a_ <= b_); }
+inline uint32x2_t vorr_u32(const uint32x2_t a_, const uint32x2_t b_) { return a_ | b_; }
+
+inline int32x2_t vcvt_s32_f32(const float32x2_t a_) { return __builtin_convertvector(a_, int32x2_t); }
+inline float32x2_t vcvt_f32_s32(const int32x2_t a_) { return __builtin_convertvector(a_, float32x2_t); }
+
+inline float32_t vget_lane_f32(const float32x2_t v_, const int lane_) { return v_[lane_]; }
+inline uint32_t vget_lane_u32(const uint32x2_t v_, const int lane_) { return v_[lane_]; }
+
+inline float32x2_t vld1_f32(const float32_t* ptr_) { float32x2_t v; memcpy(&v, ptr_, sizeof(v)); return v; }
+
+
+// =======================================================================================
+// MARK: - QUAD (float32x4_t)
+// =======================================================================================
+
+inline float32x4_t vdupq_n_f32(const float32_t value_) { return (float32x4_t){ value_, value_, value_, value_ }; }
+inline int32x4_t vdupq_n_s32(const int32_t value_) { return (int32x4_t){ value_, value_, value_, value_ }; }
+inline uint32x4_t vdupq_n_u32(const uint32_t value_) { return (uint32x4_t){ value_, value_, value_, value_ }; }
+
+inline float32x4_t vld1q_f32(const float32_t* ptr_) { float32x4_t v; memcpy(&v, ptr_, sizeof(v)); return v; }
+inline int32x4_t vld1q_s32(const int32_t* ptr_) { int32x4_t v; memcpy(&v, ptr_, sizeof(v)); return v; }
+inline uint32x4_t vld1q_u32(const uint32_t* ptr_) { uint32x4_t v; memcpy(&v, ptr_, sizeof(v)); return v; }
+inline void vst1q_f32(float32_t* ptr_, const float32x4_t v_) { memcpy(ptr_, &v_, sizeof(v_)); }
+inline void vst1q_s32(int32_t* ptr_, const int32x4_t v_) { memcpy(ptr_, &v_, sizeof(v_)); }
+inline void vst1q_u32(uint32_t* ptr_, const uint32x4_t v_) { memcpy(ptr_, &v_, sizeof(v_)); }
+
+inline float32x4_t vld1q_lane_f32(const float32_t* ptr_, float32x4_t v_, const int lane_)
+{
+    v_[lane_] = *ptr_;
+    return v_;
+}
+
+inline float32x4_t vaddq_f32(const float32x4_t a_, const float32x4_t b_) { return a_ + b_; }
+inline float32x4_t vsubq_f32(const float32x4_t a_, const float32x4_t b_) { return a_ - b_; }
+inline float32x4_t vmulq_f32(const float32x4_t a_, const float32x4_t b_) { return a_ * b_; }
+inline float32x4_t vmulq_n_f32(const float32x4_t a_, const float32_t b_) { return a_ * b_; }
+inline float32x4_t vmlaq_f32(const float32x4_t a_, const float32x4_t b_, const float32x4_t c_) { return a_ + b_ * c_; }
+inline float32x4_t vmlsq_f32(const float32x4_t a_, const float32x4_t b_, const float32x4_t c_) { return a_ - b_ * c_; }
+inline float32x4_t vmlaq_n_f32(const float32x4_t a_, const float32x4_t b_, const float32_t c_) { return a_ + b_ * c_; }
+inline float32x4_t vnegq_f32(const float32x4_t a_) { return -a_; }
+
+inline int32x4_t vaddq_s32(const int32x4_t a_, const int32x4_t b_) { return a_ + b_; }
+inline int32x4_t vsubq_s32(const int32x4_t a_, const int32x4_t b_) { return a_ - b_; }
+inline int32x4_t vandq_s32(const int32x4_t a_, const int32x4_t b_) { return a_ & b_; }
+inline uint32x4_t vaddq_u32(const uint32x4_t a_, const uint32x4_t b_) { return a_ + b_; }
+inline uint32x4_t vandq_u32(const uint32x4_t a_, const uint32x4_t b_) { return a_ & b_; }
+inline uint32x4_t vorrq_u32(const uint32x4_t a_, const uint32x4_t b_) { return a_ | b_; }
+inline uint32x4_t veorq_u32(const uint32x4_t a_, const uint32x4_t b_) { return a_ ^ b_; }
+inline uint32x4_t vshlq_n_u32(const uint32x4_t a_, const int n_) { return a_ << n_; }
+inline uint32x4_t vshrq_n_u32(const uint32x4_t a_, const int n_) { return a_ >> n_; }
+inline float32x4_t vreinterpretq_f32_u32(const uint32x4_t a_) { return (float32x4_t)a_; }
+inline int32x4_t vreinterpretq_s32_u32(const uint32x4_t a_) { return (int32x4_t)a_; }
+
+inline uint32x4_t vcltq_f32(const float32x4_t a_, const float32x4_t b_) { return (uint32x4_t)(a_ < b_); }
+inline uint32x4_t vcgeq_f32(const float32x4_t a_, const float32x4_t b_) { return (uint32x4_t)(a_ >= b_); }
+inline uint32x4_t vcltq_u32(const uint32x4_t a_, const uint32x4_t b_) { return (uint32x4_t)(a_ < b_); }
+inline uint32x4_t vceqq_s32(const int32x4_t a_, const int32x4_t b_) { return (uint32x4_t)(a_ == b_); }
+
+inline float32x4_t vabsq_f32(const float32x4_t a_)
+{
+#ifdef GRAINMOTHER_SIMD_SSE
+    return (float32x4_t)_mm_andnot_ps(_mm_set1_ps(-0.f), (__m128)a_);
+#else
+    return (float32x4_t)((uint32x4_t)a_ & vdupq_n_u32(0x7FFFFFFF));
+#endif
+}
+
+inline float32x4_t vbslq_f32(const uint32x4_t mask_, const float32x4_t a_, const float32x4_t b_)
+{
+#ifdef GRAINMOTHER_SIMD_SSE
+    __m128 mask = (__m128)mask_;
+    return (float32x4_t)_mm_or_ps(_mm_and_ps(mask, (__m128)a_), _mm_andnot_ps(mask, (__m128)b_));
+#else
+    return (float32x4_t)((mask_ & (uint32x4_t)a_) | (~mask_ & (uint32x4_t)b_));
+#endif
+}
+
+inline int32x4_t vbslq_s32(const uint32x4_t mask_, const int32x4_t a_, const int32x4_t b_)
+{
+    return (int32x4_t)((mask_ & (uint32x4_t)a_) | (~mask_ & (uint32x4_t)b_));
+}
+
+inline uint32x4_t vbslq_u32(const uint32x4_t mask_, const uint32x4_t a_, const uint32x4_t b_)
+{
+    return (mask_ & a_) | (~mask_ & b_);
+}
+
+inline uint32x4_t vminq_u32(const uint32x4_t a_, const uint32x4_t b_)
+{
+    return vbslq_u32(vcltq_u32(a_, b_), a_, b_);
+}
+
+inline int32x4_t vcvtq_s32_f32(const float32x4_t a_)
+{
+#ifdef GRAINMOTHER_SIMD_SSE
+    return (int32x4_t)_mm_cvttps_epi32((__m128)a_);
+#else
+    return __builtin_convertvector(a_, int32x4_t);
+#endif
+}
+
+inline float32x4_t vcvtq_f32_s32(const int32x4_t a_)
+{
+#ifdef GRAINMOTHER_SIMD_SSE
+    return (float32x4_t)_mm_cvtepi32_ps((__m128i)a_);
+#else
+    return __builtin_convertvector(a_, float32x4_t);
+#endif
+}
+
+inline float32x4_t vminq_f32(const float32x4_t a_, const float32x4_t b_)
+{
+#ifdef GRAINMOTHER_SIMD_SSE
+    return (float32x4_t)_mm_min_ps((__m128)a_, (__m128)b_);
+#else
+    return vbslq_f32(vcltq_f32(a_, b_), a_, b_);
+#endif
+}
+
+inline float32x4_t vmaxq_f32(const float32x4_t a_, const float32x4_t b_)
+{
+#ifdef GRAINMOTHER_SIMD_SSE
+    return (float32x4_t)_mm_max_ps((__m128)a_, (__m128)b_);
+#else
+    return vbslq_f32(vcltq_f32(b_, a_), a_, b_);
+#endif
+}
+
+/** @brief Estimates the reciprocal, refine it with `vrecpsq_f32()`. The estimate is more precise than on NEON. */
+inline float32x4_t vrecpeq_f32(const float32x4_t a_)
+{
+#ifdef GRAINMOTHER_SIMD_SSE
+    return (float32x4_t)_mm_rcp_ps((__m128)a_);
+#else
+    return vdupq_n_f32(1.f) / a_;
+#endif
+}
+
+/** @brief The Newton-Raphson step of a reciprocal: estimate *= vrecpsq_f32(a, estimate). */
+inline float32x4_t vrecpsq_f32(const float32x4_t a_, const float32x4_t b_) { return vdupq_n_f32(2.f) - a_ * b_; }
+
+inline float32_t vgetq_lane_f32(const float32x4_t v_, const int lane_) { return v_[lane_]; }
+
+
+// =======================================================================================
+// MARK: - PAIR <-> QUAD
+// =======================================================================================
+
+inline float32x2_t vget_low_f32(const float32x4_t a_) { return (float32x2_t){ a_[0], a_[1] }; }
+inline float32x2_t vget_high_f32(const float32x4_t a_) { return (float32x2_t){ a_[2], a_[3] }; }
+inline uint32x2_t vget_low_u32(const uint32x4_t a_) { return (uint32x2_t){ a_[0], a_[1] }; }
+inline uint32x2_t vget_high_u32(const uint32x4_t a_) { return (uint32x2_t){ a_[2], a_[3] }; }
+
+inline float32x4_t vcombine_f32(const float32x2_t low_, const float32x2_t high_)
+{
+    return (float32x4_t){ low_[0], low_[1], high_[0], high_[1] };
+}
+
+/** @brief Deinterleaves two quads, val[0] receives the even and val[1] the odd elements. */
+inline float32x4x2_t vuzpq_f32(const float32x4_t a_, const float32x4_t b_)
+{
+    return { { (float32x4_t){ a_[0], a_[2], b_[0], b_[2] }, (float32x4_t){ a_[1], a_[3], b_[1], b_[3] } } };
+}
+
+#endif // NEON
+
+
+// =======================================================================================
+// MARK: - CONSTRUCTION
+// =======================================================================================
+
+/**
+ * @brief Builds a stereo pair from a left and a right value.
+ *
+ * Clang accepts brace-initialized vector types in returns, assignments and function arguments,
+ * GCC only in declarations. Use this (and `makeQuad()`) to stay portable.
+ */
+inline float32x2_t makeStereo(const float32_t left_, const float32_t right_)
+{
+    float32x2_t v = { left_, right_ };
+    return v;
+}
+
+/**
+ * @brief Builds a quad from four values, see `makeStereo()`.
+ */
+inline float32x4_t makeQuad(const float32_t a_, const float32_t b_, const float32_t c_, const float32_t d_)
+{
+    float32x4_t v = { a_, b_, c_, d_ };
+    return v;
+}
@@ -0,0 +1,111 @@
+#include "TaskScheduler.hpp"
+
+// =======================================================================================
+// MARK: - TASK SCHEDULER
+// =======================================================================================
+
+
+void TaskScheduler::setup(const float sampleRate_, const uint blockSize_, const float maxWakeupRate_, Telemetry::CpuMeter& cpuMeter_)
+{
+    blocksPerSecond = sampleRate_ / (float)blockSize_;
+    blocksPerWakeup = std::max(1u, (uint)(blocksPerSecond / maxWakeupRate_));
+    blocksSinceWakeup = blocksPerWakeup;
+    
+    cpuMeter = &cpuMeter_;
+    
+    tasks.reserve(MAX_TASKS);
+}
+
+
+uint TaskScheduler::addTask(const float rate_, std::function<void()> callback_)
+{
+    if (tasks.size() >= MAX_TASKS)
+        engine_rt_error("TaskScheduler can't handle more than " + TOSTRING(MAX_TASKS) + " tasks", __FILE__, __LINE__, true);
+    
+    Task task;
+    task.callback = callback_;
+    task.blocksPerRun = std::max(1u, (uint)(blocksPerSecond / rate_));
+    task.blockCounter = task.blocksPerRun;
+    
+    tasks.push_back(task);
+    
+    return (uint)tasks.size() - 1;
+}
+
+
+uint32_t TaskScheduler::advanceBlock()
+{
+    uint32_t dueTasks = 0;
+    
+    for (uint n = 0; n < tasks.size(); ++n)
+    {
+        if (--tasks[n].blockCounter == 0)
+        {
+            tasks[n].blockCounter = tasks[n].blocksPerRun;
+            dueTasks |= 1u << n;
+        }
+    }
+    
+    return dueTasks;
+}
+
+
+bool TaskScheduler::postTasks(const uint32_t tasks_)
+{
+    if (blocksSinceWakeup < blocksPerWakeup) ++blocksSinceWakeup;
+    
+    uint32_t posted = tasks_;
+    
+    if (tasks_)
+    {
+        // the release publishes everything the audio thread prepared for the tasks
+        const uint32_t previous = mailbox.fetch_or(tasks_, std::memory_order_release);
+        
+        if (previous & tasks_) numMissed.fetch_add(__builtin_popcount(previous & tasks_), std::memory_order_relaxed);
+        
+        posted |= previous;
+    }
+    // nothing was posted in this block, but tasks of earlier blocks may still wait for the rate limit
+    else
+    {
+        posted = mailbox.load(std::memory_order_relaxed);
+    }
+    
+    if (!posted || blocksSinceWakeup < blocksPerWakeup) return false;
+    
+    // the worker is still busy or hasn't started yet, it takes the new tasks as well
+    if (wakeupPending.load(std::memory_order_acquire)) return false;
+    
+    wakeupTicks.store((uint32_t)Telemetry::readCycleCounter(), std::memory_order_relaxed);
+    wakeupPending.store(true, std::memory_order_release);
+    blocksSinceWakeup = 0;
+    
+    return true;
+}
+
+
+void TaskScheduler::runDueTasks()
+{
+    if (cpuMeter->isEnabled())
+    {
+        const uint32_t now = (uint32_t)Telemetry::readCycleCounter();
+        cpuMeter->addMeasurement(Telemetry::TASK_WAKEUP, (uint32_t)(now - wakeupTicks.load(std::memory_order_relaxed)));
+    }
+    
+    // clear the flag first, tasks posted from now on wake the worker up again
+    wakeupPending.store(false, std::memory_order_release);
+    
+    uint32_t dueTasks = mailbox.exchange(0, std::memory_order_acquire);
+    
+    if (!dueTasks) return;
+    
+    Telemetry::CpuMeter::Measurement measurement(*cpuMeter, Telemetry::TASK_CONTROL);
+    
+    while (dueTasks)
+    {
+        const uint n = __builtin_ctz(dueTasks);
+        dueTasks &= dueTasks - 1;
+        
+        tasks[n].callback();
+    }
+}
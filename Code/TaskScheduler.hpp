@@ -0,0 +1,103 @@
+#ifndef taskscheduler_hpp
+#define taskscheduler_hpp
+
+#include "Functions.h"
+#include "Telemetry.hpp"
+
+#include <atomic>
+#include <functional>
+
+/**
+ * @file TaskScheduler.hpp
+ * @brief Runs the control tasks of the device (UI polling, display, LEDs, MIDI, preset I/O) on one worker thread.
+ *
+ * The audio thread counts the blocks and decides which tasks are due, it never runs a task itself. The due tasks
+ * are posted into a lock-free mailbox, and the worker is woken up to run them. A worker that is already awake or
+ * was woken up recently isn't woken up again, the posted tasks wait in the mailbox until the next wakeup. So there
+ * is at most one wakeup per `1 / maxWakeupRate` seconds, instead of one per task and block, and a task runs at most
+ * one wakeup interval plus the wakeup latency after it was due. The wakeup latency is measured by the CPU meter.
+ */
+
+// =======================================================================================
+// MARK: - TASK SCHEDULER
+// =======================================================================================
+
+/**
+ * @class TaskScheduler
+ * @brief Posts control tasks from the audio thread to a single, non real-time worker thread.
+ *
+ * Audio thread: `advanceBlock()` and `postTasks()` once per block, neither allocates nor blocks.
+ * Worker thread: `runDueTasks()` whenever `postTasks()` returned true.
+ * Tasks are added with `addTask()` before the audio thread is started.
+ */
+class TaskScheduler
+{
+public:
+    static const uint MAX_TASKS = 32;  ///< one bit per task in the mailbox
+    
+    /**
+     * @brief Sets up the block rate and the wakeup rate.
+     * @param sampleRate_ the sample rate
+     * @param blockSize_ num samples in one audio block
+     * @param maxWakeupRate_ the maximum number of wakeups of the worker per second
+     * @param cpuMeter_ receives the cost of the tasks and the wakeup latency
+     */
+    void setup(const float sampleRate_, const uint blockSize_, const float maxWakeupRate_, Telemetry::CpuMeter& cpuMeter_);
+    
+    /**
+     * @brief Adds a task, not while the audio thread is running.
+     * @param rate_ num runs per second, rounded to a whole number of blocks between two runs, should not exceed the wakeup rate
+     * @param callback_ the task, runs on the worker thread
+     * @return the index of the task, its bit in the masks of `advanceBlock()` and `postTasks()`
+     */
+    uint addTask(const float rate_, std::function<void()> callback_);
+    
+    /**
+     * @brief Counts down the block counters of the tasks, audio thread only.
+     *
+     * The tasks are not posted yet, so the audio thread can prepare their input (e.g. read the hardware) first.
+     *
+     * @return the mask of the tasks that are due in this block
+     */
+    uint32_t advanceBlock();
+    
+    /**
+     * @brief Posts tasks to the worker, audio thread only, call once per block (also with an empty mask).
+     *
+     * A task that is posted again before the worker ran it runs only once and is counted as missed.
+     *
+     * @param tasks_ the mask of the tasks to post
+     * @return true if the worker has to be woken up now
+     */
+    bool postTasks(const uint32_t tasks_);
+    
+    /** @brief Runs all tasks that were posted since the last call in the order they were added, worker thread only. */
+    void runDueTasks();
+    
+    /** @brief Returns the number of task runs that were skipped because the worker fell behind, since setup. */
+    uint getNumMissed() const { return numMissed.load(std::memory_order_relaxed); }
+
+private:
+    /** @brief A task and its rate. */
+    struct Task
+    {
+        std::function<void()> callback;
+        uint blocksPerRun = 1;
+        uint blockCounter = 1;  ///< audio thread only
+    };
+    
+    std::vector<Task> tasks;
+    
+    float blocksPerSecond = 1.f;
+    uint blocksPerWakeup = 1;  ///< the minimum number of blocks between two wakeups
+    uint blocksSinceWakeup = 0;  ///< audio thread only
+    
+    Telemetry::CpuMeter* cpuMeter = nullptr;
+    
+    alignas(64) std::atomic<uint32_t> mailbox { 0 };  ///< the posted tasks, one bit each
+    std::atomic<bool> wakeupPending { false };  ///< set by the audio thread with a wakeup, cleared by the worker
+    std::atomic<uint32_t> wakeupTicks { 0 };  ///< the (truncated) cycle counter when the pending wakeup was requested
+    std::atomic<uint> numMissed { 0 };
+};
+
+#endif /* taskscheduler_hpp */
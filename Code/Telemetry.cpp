@@ -0,0 +1,108 @@
+#include "Telemetry.hpp"
+
+using namespace Telemetry;
+
+// =======================================================================================
+// MARK: - CPU METER
+// =======================================================================================
+
+
+const float CpuMeter::REPORT_INTERVAL = 0.5f;
+
+
+void CpuMeter::setup(const float sampleRate_, const uint blockSize_)
+{
+    double ticksPerSecond = 1e9;
+
+#if defined(__x86_64__) || defined(__i386__)
+    // the time stamp counter runs at a fixed, but unknown rate: measure it against the steady clock
+    auto startTime = std::chrono::steady_clock::now();
+    uint64_t startTicks = readCycleCounter();
+    
+    while (std::chrono::steady_clock::now() - startTime < std::chrono::milliseconds(20)) {}
+    
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    ticksPerSecond = (double)(readCycleCounter() - startTicks) / seconds;
+#endif
+    
+    ticksPerBlock = ticksPerSecond * blockSize_ / sampleRate_;
+    blocksPerReport = std::max(1u, (uint)(REPORT_INTERVAL * sampleRate_ / blockSize_));
+    xrunThresholdTicks = (uint64_t)(1.5 * ticksPerBlock);
+}
+
+
+void CpuMeter::blockStarted()
+{
+    if (!isEnabled())
+    {
+        lastBlockTicks = 0;
+        return;
+    }
+    
+    uint64_t now = readCycleCounter();
+    
+    if (lastBlockTicks != 0 && now - lastBlockTicks > xrunThresholdTicks)
+        numXruns.fetch_add(1, std::memory_order_relaxed);
+    
+    lastBlockTicks = now;
+}
+
+
+bool CpuMeter::collect()
+{
+    const uint32_t budgetTicks = (uint32_t)std::min(ticksPerBlock, (double)UINT32_MAX);
+    
+    for (uint n = 0; n < NUM_PROBES; ++n)
+    {
+        Accumulator& accumulator = accumulators[n];
+        uint32_t ticks;
+        
+        while (buffers[n].pop(ticks))
+        {
+            accumulator.min = std::min(accumulator.min, ticks);
+            accumulator.max = std::max(accumulator.max, ticks);
+            accumulator.sum += ticks;
+            ++accumulator.count;
+            
+            if (n == ENGINE && ticks > budgetTicks) ++numOverruns;
+        }
+    }
+    
+    // the engine runs once per block, it defines when a report interval is complete
+    if (accumulators[ENGINE].count < blocksPerReport) return false;
+    
+    const float toPercent = 100.f / (float)ticksPerBlock;
+    
+    for (uint n = 0; n < NUM_PROBES; ++n)
+    {
+        Accumulator& accumulator = accumulators[n];
+        
+        if (accumulator.count > 0)
+        {
+            report[n].min = accumulator.min * toPercent;
+            report[n].max = accumulator.max * toPercent;
+            report[n].avg = (float)accumulator.sum / accumulator.count * toPercent;
+        }
+        else
+        {
+            report[n].min = report[n].avg = report[n].max = 0.f;
+        }
+        report[n].numBlocks = accumulator.count;
+        
+        accumulator = Accumulator();
+    }
+    
+    return true;
+}
+
+
+String CpuMeter::getReportLine(const Probe probe_) const
+{
+    const Statistics& statistics = report[probe_];
+    
+    char line[64];
+    snprintf(line, sizeof(line), "%s %.0f/%.0f/%.0f%%", probeNames[probe_].c_str(),
+             statistics.min, statistics.avg, statistics.max);
+    
+    return line;
+}
@@ -0,0 +1,260 @@
+#ifndef telemetry_hpp
+#define telemetry_hpp
+
+#include "Functions.h"
+
+#include <atomic>
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @file Telemetry.hpp
+ * @brief Real-time CPU meter and xrun telemetry.
+ *
+ * The audio thread and the auxiliary tasks time their work with a cycle counter and push one
+ * measurement per block into a lock-free ring buffer per probe. A single reader thread drains
+ * the buffers and condenses them into min/avg/max per probe, relative to the time budget of one block.
+ *
+ * When the meter is disabled, a measurement costs one relaxed atomic load and a branch.
+ */
+
+namespace Telemetry
+{
+
+// =======================================================================================
+// MARK: - PROBES
+// =======================================================================================
+
+/**
+ * @brief The measuring points.
+ * @attention every probe must only be written from one thread
+ */
+enum Probe {
+    ENGINE,             ///< AudioEngine::processAudioBlock (audio thread)
+    EFFECT1,            ///< processAudioBlock of effect processor 0 (audio thread)
+    EFFECT2,            ///< processAudioBlock of effect processor 1 (audio thread)
+    EFFECT3,            ///< processAudioBlock of effect processor 2 (audio thread)
+    TASK_AUDIOBLOCK,    ///< AudioEngine::updateAudioBlock (audio thread)
+    TASK_CONTROL,       ///< the control tasks of one wakeup of the TaskScheduler worker
+    TASK_WAKEUP,        ///< the time from a wakeup request of the TaskScheduler until its worker runs
+    NUM_PROBES
+};
+
+static const String probeNames[NUM_PROBES] {
+    "Engine",
+    effectNames[0],
+    effectNames[1],
+    effectNames[2],
+    "Block Task",
+    "Control Task",
+    "Control Wakeup"
+};
+
+/** @brief Returns the probe of the effect processor with the given index. */
+inline Probe getEffectProbe(const uint effectIndex_) { return static_cast<Probe>(EFFECT1 + effectIndex_); }
+
+
+// =======================================================================================
+// MARK: - CYCLE COUNTER
+// =======================================================================================
+
+/**
+ * @brief Reads a free running counter.
+ *
+ * - x86: the time stamp counter
+ * - everywhere else: the monotonic clock in nanoseconds. The ARM cycle counter is not readable
+ *   from user space unless the kernel allows it, on BELA the monotonic clock is served by Xenomai
+ *   and safe to call from the audio thread.
+ */
+inline uint64_t readCycleCounter()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000000ull + (uint64_t)time.tv_nsec;
+#endif
+}
+
+
+// =======================================================================================
+// MARK: - RING BUFFER
+// =======================================================================================
+
+/**
+ * @class RingBuffer
+ * @brief A lock-free single producer, single consumer ring buffer.
+ *
+ * `push()` must only be called from one thread and `pop()` from one (other) thread.
+ * Neither allocates nor blocks. If the buffer is full, `push()` drops the value.
+ */
+template <typename T, size_t CAPACITY>
+class RingBuffer
+{
+public:
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "the capacity of the ring buffer has to be a power of two");
+    
+    /** @brief Adds a value, returns false if the buffer is full. */
+    bool push(const T& value_)
+    {
+        const size_t write = writeIndex.load(std::memory_order_relaxed);
+        const size_t next = (write + 1) & WRAP;
+        
+        if (next == readIndex.load(std::memory_order_acquire)) return false;
+        
+        buffer[write] = value_;
+        writeIndex.store(next, std::memory_order_release);
+        return true;
+    }
+    
+    /** @brief Removes the oldest value, returns false if the buffer is empty. */
+    bool pop(T& value_)
+    {
+        const size_t read = readIndex.load(std::memory_order_relaxed);
+        
+        if (read == writeIndex.load(std::memory_order_acquire)) return false;
+        
+        value_ = buffer[read];
+        readIndex.store((read + 1) & WRAP, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static const size_t WRAP = CAPACITY - 1;
+    
+    std::array<T, CAPACITY> buffer;
+    alignas(64) std::atomic<size_t> writeIndex { 0 }; ///< written by the producer only
+    alignas(64) std::atomic<size_t> readIndex { 0 }; ///< written by the consumer only
+};
+
+
+// =======================================================================================
+// MARK: - CPU METER
+// =======================================================================================
+
+/**
+ * @struct Statistics
+ * @brief Load of one probe over a report interval, in percent of the time budget of one audio block.
+ */
+struct Statistics
+{
+    float min = 0.f;
+    float avg = 0.f;
+    float max = 0.f;
+    uint numBlocks = 0; ///< number of measurements in the interval
+};
+
+/**
+ * @class CpuMeter
+ * @brief Collects the per-block cost of the engine, the effects and the auxiliary tasks.
+ *
+ * Producer side (audio thread and auxiliary tasks): `Measurement` objects or `addMeasurement()`, and `blockStarted()`
+ * once per audio callback.
+ *
+ * Consumer side (one thread only): `collect()` drains the ring buffers, every REPORT_INTERVAL seconds a new report
+ * is published and can be read with `getStatistics()`, `getNumXruns()` and `getNumOverruns()`.
+ */
+class CpuMeter
+{
+public:
+    /**
+     * @class Measurement
+     * @brief Times its own lifetime and adds it to a probe, does nothing while the meter is disabled.
+     */
+    class Measurement
+    {
+    public:
+        Measurement(CpuMeter& meter_, const Probe probe_)
+            : meter(meter_)
+            , probe(probe_)
+            , startTicks(meter_.isEnabled() ? readCycleCounter() : 0) {}
+        
+        ~Measurement() { if (startTicks) meter.addMeasurement(probe, readCycleCounter() - startTicks); }
+    
+    private:
+        CpuMeter& meter;
+        const Probe probe;
+        const uint64_t startTicks;
+    };
+    
+    /**
+     * @brief Sets up the time budget and measures the rate of the cycle counter.
+     * @param sampleRate_ the sample rate
+     * @param blockSize_ num samples in one audio block
+     */
+    void setup(const float sampleRate_, const uint blockSize_);
+    
+    void setEnabled(const bool enabled_) { enabled.store(enabled_, std::memory_order_relaxed); }
+    
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief Adds the cost of one block to a probe.
+     * @param probe_ the probe, has to be written from the same thread every time
+     * @param ticks_ the elapsed ticks of the cycle counter
+     */
+    void addMeasurement(const Probe probe_, const uint64_t ticks_)
+    {
+        buffers[probe_].push((uint32_t)std::min(ticks_, (uint64_t)UINT32_MAX));
+    }
+    
+    /**
+     * @brief Has to be called at the start of every audio callback.
+     *
+     * If the time since the last callback exceeds 1.5 block periods, a block was missed and an xrun is counted.
+     */
+    void blockStarted();
+    
+    /**
+     * @brief Drains the ring buffers, call regularly from one (non-audio) thread.
+     * @return true if a new report has been published
+     */
+    bool collect();
+    
+    const Statistics& getStatistics(const Probe probe_) const { return report[probe_]; }
+    
+    /** @brief Returns the number of missed audio callbacks since setup. */
+    uint getNumXruns() const { return numXruns.load(std::memory_order_relaxed); }
+    
+    /** @brief Returns the number of blocks in which the engine took longer than the block budget since setup. */
+    uint getNumOverruns() const { return numOverruns; }
+    
+    /** @brief Returns a short, human readable line for a probe, e.g. "Reverb 12/14/19%". */
+    String getReportLine(const Probe probe_) const;
+    
+    static const float REPORT_INTERVAL; ///< seconds between two reports
+
+private:
+    /** @brief Accumulates the measurements of one probe over a report interval. */
+    struct Accumulator
+    {
+        uint32_t min = UINT32_MAX;
+        uint32_t max = 0;
+        uint64_t sum = 0;
+        uint count = 0;
+    };
+    
+    static const size_t BUFFER_CAPACITY = 512; ///< blocks per probe between two `collect()` calls
+    
+    std::atomic<bool> enabled { false };
+    
+    RingBuffer<uint32_t, BUFFER_CAPACITY> buffers[NUM_PROBES];
+    Accumulator accumulators[NUM_PROBES];
+    Statistics report[NUM_PROBES];
+    
+    double ticksPerBlock = 1.0; ///< the time budget of one block in ticks
+    uint blocksPerReport = 1;
+    
+    uint64_t lastBlockTicks = 0; ///< audio thread only
+    uint64_t xrunThresholdTicks = 0;
+    std::atomic<uint> numXruns { 0 };
+    uint numOverruns = 0;
+};
+
+} // namespace Telemetry
+
+#endif /* telemetry_hpp */
@@ -100,43 +100,55 @@ bool Debouncer::update (const bool _rawvalue)
 
 
 // =======================================================================================
-// MARK: - EFFECT AVERAGER
+// MARK: - SILENCE DETECTOR
 // =======================================================================================
 
 
-EffectAverager::EffectAverager()
+void SilenceDetector::setup(const float sampleRate_, const float holdTime_, const float threshold_)
 {
-    // setup buffer, all zeros
-    for (uint n = 0; n < bufferLength; ++n)
-        buffer[n] = vdup_n_f32(0.f);
+    threshold = threshold_;
+    wakeThreshold = threshold_ * HYSTERESIS;
+    holdSamples = (uint)(holdTime_ * sampleRate_);
+    
+    // start silent, like a freshly set up effect
+    silentSamples = holdSamples;
+    silent = true;
 }
 
 
-void EffectAverager::processAudioSamples(float32x2_t input_)
+void SilenceDetector::processAudioSamples(float32x2_t input_)
 {
-    // average -= buffer[writePointer];
-    average = vsub_f32(average, buffer[writePointer]);
+    float32x2_t peak = vabs_f32(input_);
     
-    // buffer[writePointer] = input_ * fracment;
-    buffer[writePointer] = vmul_n_f32(vabs_f32(input_), fracment);
+    update(std::max(vget_lane_f32(peak, 0), vget_lane_f32(peak, 1)), 1);
+}
+
+
+void SilenceDetector::processAudioBlock(const float* const input_[2], const uint numFrames_)
+{
+    float peak = 0.f;
     
-    // average += buffer[writePointer];
-    average = vadd_f32(average, buffer[writePointer]);
+    for (uint ch = 0; ch < 2; ++ch)
+        for (uint n = 0; n < numFrames_; ++n)
+            peak = std::max(peak, fabsf(input_[ch][n]));
     
-    // increase pointer
-    if (++writePointer >= bufferLength) writePointer = 0;
+    update(peak, numFrames_);
 }
 
 
-bool EffectAverager::isNearZero()
+void SilenceDetector::update(const float peak_, const uint numFrames_)
 {
-    static float32x2_t epsilonVec = vdup_n_f32(0.0001f);
-
-    // average <= epsilon?
-    uint32x2_t comparison = vcle_f32(average, epsilonVec);
-    
-    // return true if both values are true
-    if (vget_lane_u32(comparison, 0) != 0 && vget_lane_u32(comparison, 1) != 0) return true;
+    // a silent signal has to exceed the higher wake threshold to count as sounding again
+    if (peak_ > (silent ? wakeThreshold : threshold))
+    {
+        silentSamples = 0;
+        silent = false;
+    }
     
-    return false;
+    // below the threshold: silent after the hold time
+    else if (!silent)
+    {
+        silentSamples += numFrames_;
+        if (silentSamples >= holdSamples) silent = true;
+    }
 }
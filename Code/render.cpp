@@ -27,29 +27,11 @@ bool setup (BelaContext *context, void *userData)
     midi.enableParser(true);
     midi.getParser()->setCallback(midiInputMessageCallback, (void*) "hw:0,0,0");
     
-    // display
-    DISPLAY_BLOCKS_PER_FRAME = context->audioSampleRate / ( DISPLAY_FRAMERATE * context->audioFrames );
-    displayBlockCtr = DISPLAY_BLOCKS_PER_FRAME;
-    
     // leds
-    LED_BLOCKS_PER_FRAME = context->audioSampleRate / ( LED_FRAMERATE * context->audioFrames );
-    ledBlockCtr = LED_BLOCKS_PER_FRAME;
-    std::fill(ledCache.begin(), ledCache.end(), 0.f);
-    
-    // ui rate
-    UI_BLOCKS_PER_FRAME = context->audioSampleRate / ( UI_FRAMERATE * context->audioFrames );
-    uiBlockCtr = UI_BLOCKS_PER_FRAME;
+    for (auto& value : ledCache) value.store(0.f, std::memory_order_relaxed);
     
-    // scrolling
-    SCROLLING_BLOCKS_PER_FRAME = context->audioSampleRate / ( SCROLLING_FRAMERATE * context->audioFrames );
-    scrollingBlockCtr = SCROLLING_BLOCKS_PER_FRAME;
-    
-    // aux tasks
-    if((THREAD_updateUserInterface = Bela_createAuxiliaryTask(&updateUserInterface, 88, "updateUserInterface", context)) == 0) 
-        return false;
-    if((THREAD_updateNonAudioTasks = Bela_createAuxiliaryTask(&updateNonAudioTasks, 87, "updateNonAudioTasks", nullptr)) == 0) 
-        return false;
-    if((THREAD_updateAudioBlock = Bela_createAuxiliaryTask(&updateAudioBlock, 90, "updateAudioBlock", nullptr)) == 0)
+    // aux task
+    if((THREAD_runControlTasks = Bela_createAuxiliaryTask(&runControlTasks, 88, "runControlTasks", nullptr)) == 0)
         return false;
     
     // digital pinmodes
@@ -58,6 +40,13 @@ bool setup (BelaContext *context, void *userData)
     // effect engine
     engine.setup(context->audioSampleRate, context->audioFrames);
     
+    // audio buffers
+    for (uint ch = 0; ch < 2; ++ch)
+    {
+        audioInputBuffer[ch].resize(context->audioFrames, 0.f);
+        audioOutputBuffer[ch].resize(context->audioFrames, 0.f);
+    }
+    
     // userinterface
     for (uint n = 0; n < NUM_POTENTIOMETERS; ++n)
         userinterface.potentiometer[n].setAnalogDefault(analogRead(context, 0, HARDWARE_PIN_POTENTIOMETER[n]));
@@ -66,6 +55,15 @@ bool setup (BelaContext *context, void *userData)
     // midi output
     for (uint n = 0; n < NUM_POTENTIOMETERS; ++n)
         userinterface.potentiometer[n].setupMIDI(n+1, midiOutputMessageCallback);
+    
+    // control tasks
+    scheduler.setup(context->audioSampleRate, context->audioFrames, CONTROL_WAKEUP_RATE, engine.getCpuMeter());
+    
+    TASK_readControls = scheduler.addTask(UI_FRAMERATE, [] { readControls(); });
+    scheduler.addTask(MIDI_FRAMERATE, [] { userinterface.processMidiControlChanges(); });
+    scheduler.addTask(SCROLLING_FRAMERATE, [] { userinterface.updateNonAudioTasks(); });
+    scheduler.addTask(DISPLAY_FRAMERATE, [] { userinterface.display.update(); });
+    scheduler.addTask(LED_FRAMERATE, [] { updateLEDs(); });
         
     return true;
 }
@@ -77,32 +75,39 @@ bool setup (BelaContext *context, void *userData)
 
 void render (BelaContext *context, void *userData)
 {
+    // xrun detection of the CPU meter
+    engine.getCpuMeter().blockStarted();
+    
     // BLOCKWISE PROCESSING
     // ===================================================================================
     
-    // update Effects blockwise
-    Bela_scheduleAuxiliaryTask(THREAD_updateAudioBlock);
+    // update effects blockwise, on the audio thread, so the update always precedes the block
+    {
+        Telemetry::CpuMeter::Measurement measurement(engine.getCpuMeter(), Telemetry::TASK_AUDIOBLOCK);
+        
+        engine.updateAudioBlock();
+    }
     
-    // update user interface reading
-    Bela_scheduleAuxiliaryTask(THREAD_updateUserInterface);
+    // the control tasks that are due in this block
+    uint32_t dueTasks = scheduler.advanceBlock();
     
-    // update Non Audio Tasks
-    Bela_scheduleAuxiliaryTask(THREAD_updateNonAudioTasks);
+    // read the buttons and potentiometers for the control thread
+    if (dueTasks & (1u << TASK_readControls))
+    {
+        for (unsigned int n = 0; n < NUM_BUTTONS; ++n)
+            buttonCache[n].store(digitalRead(context, 0, HARDWARE_PIN_BUTTON[n]), std::memory_order_relaxed);
+        for (unsigned int n = 0; n < NUM_POTENTIOMETERS; ++n)
+            potentiometerCache[n].store(analogRead(context, 0, HARDWARE_PIN_POTENTIOMETER[n]), std::memory_order_relaxed);
+    }
     
-    // update leds (doesnt work as an auxiliary task)
-    updateLEDs();
+    // hand the tasks over to the control thread, it is only woken up if it isn't running and wasn't woken up recently
+    if (scheduler.postTasks(dueTasks))
+        Bela_scheduleAuxiliaryTask(THREAD_runControlTasks);
         
     // write led analog output
     // this has to live here, running it in the thread doesnt seem to work
     for (unsigned int n = 0; n < NUM_LEDS; ++n)
-        analogWrite(context, 0, HARDWARE_PIN_LED[n], ledCache[n]);
-    
-    // update display
-    if (--displayBlockCtr <= 0)
-    {
-        displayBlockCtr = DISPLAY_BLOCKS_PER_FRAME;
-        userinterface.display.update();
-    }
+        analogWrite(context, 0, HARDWARE_PIN_LED[n], ledCache[n].load(std::memory_order_relaxed));
 
     // SAMPLEWISE PROCESSING
     // ===================================================================================
@@ -111,16 +116,28 @@ void render (BelaContext *context, void *userData)
     {
         userinterface.processNonAudioTasks();
         
-        float32x2_t input = { audioRead(context, sampleIndex, 0), audioRead(context, sampleIndex, 1) };
-        float32x2_t output = engine.processAudioSamples(input, sampleIndex);
-        
+        // read input buffer
+        audioInputBuffer[0][sampleIndex] = audioRead(context, sampleIndex, 0);
+        audioInputBuffer[1][sampleIndex] = audioRead(context, sampleIndex, 1);
+    }
+    
+    // AUDIO PROCESSING
+    // ===================================================================================
+    
+    const float* const input[2] = { audioInputBuffer[0].data(), audioInputBuffer[1].data() };
+    float* const output[2] = { audioOutputBuffer[0].data(), audioOutputBuffer[1].data() };
+    
+    engine.processAudioBlock(input, output, context->audioFrames);
+    
+    for(sampleIndex = 0; sampleIndex < context->audioFrames; ++sampleIndex)
+    {
         // write output buffer
-        audioWrite(context, sampleIndex, 0, output[0]);
-        audioWrite(context, sampleIndex, 1, output[1]);
+        audioWrite(context, sampleIndex, 0, output[0][sampleIndex]);
+        audioWrite(context, sampleIndex, 1, output[1][sampleIndex]);
         
         #ifdef SCOPE_ACTIVE
         // scope output
-        scope.log(output[0], output[1]);
+        scope.log(output[0][sampleIndex], output[1][sampleIndex]);
         #endif
     }
 }
@@ -139,63 +156,35 @@ void cleanup (BelaContext *context, void *userData)
 // MARK: - FUNCTIONS
 // =======================================================================================
 
-void updateUserInterface(void* arg_)
+void runControlTasks(void* arg_)
+{
+    scheduler.runDueTasks();
+}
+
+
+void readControls()
 {
-    BelaContext* context = static_cast<BelaContext*>(arg_);
-    
     static bool firstFunctionCall = true;
     if (firstFunctionCall)
     {
         firstFunctionCall = false;
         
         for (unsigned int n = 0; n < NUM_POTENTIOMETERS; ++n)
-        {
-            float initialRawPotValue = analogRead(context, 0, HARDWARE_PIN_POTENTIOMETER[n]);
-            userinterface.potentiometer[n].setAnalogDefault(initialRawPotValue);
-        }
+            userinterface.potentiometer[n].setAnalogDefault(potentiometerCache[n].load(std::memory_order_relaxed));
     }
     
-    // buttons & potentiometer
-    if (--uiBlockCtr <= 0)
-    {
-        // reset counter
-        uiBlockCtr = UI_BLOCKS_PER_FRAME;
-        
-        // update buttons and potentiometers
-        for (unsigned int n = 0; n < NUM_BUTTONS; ++n)
-            userinterface.button[n].update(0.f, digitalRead(context, 0, HARDWARE_PIN_BUTTON[n]));
-        for (unsigned int n = 0; n < NUM_POTENTIOMETERS; ++n)
-            userinterface.potentiometer[n].update(0.f, analogRead(context, 0, HARDWARE_PIN_POTENTIOMETER[n]));
-    }
-}
-
-
-void updateNonAudioTasks(void* arg_)
-{
-    if (--scrollingBlockCtr == 0)
-    {
-        scrollingBlockCtr = SCROLLING_BLOCKS_PER_FRAME;
-        
-        userinterface.updateNonAudioTasks();
-    }
-}
-
-
-void updateAudioBlock(void* arg_)
-{
-    engine.updateAudioBlock();
+    // update buttons and potentiometers
+    for (unsigned int n = 0; n < NUM_BUTTONS; ++n)
+        userinterface.button[n].update(0.f, buttonCache[n].load(std::memory_order_relaxed));
+    for (unsigned int n = 0; n < NUM_POTENTIOMETERS; ++n)
+        userinterface.potentiometer[n].update(0.f, potentiometerCache[n].load(std::memory_order_relaxed));
 }
 
 
 void updateLEDs()
 {
-    if (--ledBlockCtr <= 0)
-    {
-        ledBlockCtr = LED_BLOCKS_PER_FRAME;
-        
-        for (unsigned int n = 0; n < NUM_LEDS; ++n)
-            ledCache[n] = userinterface.led[n].getValue();
-    }
+    for (unsigned int n = 0; n < NUM_LEDS; ++n)
+        ledCache[n].store(userinterface.led[n].getValue(), std::memory_order_relaxed);
 }
 
 
@@ -211,7 +200,7 @@ void midiInputMessageCallback(MidiChannelMessage message, void* arg)
         {
             uint presetIndex = message.getDataByte(0);
                         
-            userinterface.menu.handleMidiProgramChangeMessage(presetIndex);
+            userinterface.handleMidiProgramChangeMessage(presetIndex);
         }
         
         else if (message.getType() == kmmControlChange)
@@ -0,0 +1,195 @@
+/**
+ * @file OfflineRenderer.cpp
+ * @brief Standalone host that streams a WAV file through the AudioEngine without a BELA board.
+ *
+ * The renderer builds the AudioEngine together with a headless UserInterface and Menu, loads
+ * a preset from presets.json and processes the input file block by block, exactly like
+ * render() does on the device. It runs as fast as the machine allows and writes a 32 bit float WAV file.
+ *
+ * Build (from the repository root, on ARM or x86, see Simd.h):
+ *
+ *     g++ -std=c++17 -O2 -DGRAINMOTHER_OFFLINE -ICode -o grainmother-offline \
+ *         $(find Offline Code -name '*.cpp')
+ *
+ * Usage:
+ *
+ *     grainmother-offline <input.wav> <output.wav> [--preset <index>] [--blocksize <frames>]
+ *                         [--json <directory>] [--tail <seconds>] [--seed <number>]
+ *
+ * - preset: index into presets.json (0 is the default preset), default 0
+ * - blocksize: frames per block, default 16 (the BELA default)
+ * - json: directory containing presets.json and globals.json, default Code/
+ * - tail: seconds of silence appended to the input to let reverb and delays ring out, default 0
+ * - seed: seed of the random grain properties and noise, the same seed renders the same file, default 1
+ *
+ * The JSON files are only read, never written.
+ */
+
+#include "../Code/Engine.h"
+#include "WavFile.h"
+
+#include <chrono>
+
+// =======================================================================================
+// MARK: - VARIABLES
+// =======================================================================================
+
+namespace OfflineVariables
+{
+
+AudioEngine engine;
+UserInterface userinterface;
+
+static const uint DEFAULT_BLOCKSIZE = 16;
+
+} // namespace OfflineVariables
+
+using namespace OfflineVariables;
+
+
+// =======================================================================================
+// MARK: - FUNCTIONS
+// =======================================================================================
+
+void printUsage()
+{
+    rt_printf("usage: grainmother-offline <input.wav> <output.wav> [--preset <index>] [--blocksize <frames>] "
+              "[--json <directory>] [--tail <seconds>] [--seed <number>]\n");
+}
+
+
+// =======================================================================================
+// MARK: - MAIN
+// =======================================================================================
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        printUsage();
+        return 1;
+    }
+    
+    String inputPath = argv[1];
+    String outputPath = argv[2];
+    uint presetIndex = 0;
+    uint blockSize = DEFAULT_BLOCKSIZE;
+    String jsonDirectory = "Code/";
+    float tailSeconds = 0.f;
+    uint32_t randomSeed = DEFAULT_RANDOM_SEED;
+    
+    // parse the options
+    for (int n = 3; n < argc; ++n)
+    {
+        String option = argv[n];
+        
+        if (n + 1 >= argc)
+        {
+            printUsage();
+            return 1;
+        }
+        
+        String value = argv[++n];
+        
+        if (option == "--preset") presetIndex = (uint)std::stoul(value);
+        else if (option == "--blocksize") blockSize = (uint)std::stoul(value);
+        else if (option == "--json") jsonDirectory = (value.back() == '/') ? value : value + "/";
+        else if (option == "--tail") tailSeconds = std::stof(value);
+        else if (option == "--seed") randomSeed = (uint32_t)std::stoul(value);
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+    
+    if (presetIndex >= NUM_PRESETS || blockSize == 0)
+    {
+        printUsage();
+        return 1;
+    }
+    
+    // read the input file
+    WavFile input;
+    String errorMessage;
+    
+    if (!input.read(inputPath, errorMessage))
+    {
+        rt_printf("%s\n", errorMessage.c_str());
+        return 1;
+    }
+    
+    // the engine is true stereo, mono files are copied to both channels,
+    // additional channels are ignored
+    if (input.channels.size() == 1) input.channels.push_back(input.channels[0]);
+    
+    const float sampleRate = input.sampleRate;
+    const size_t numInputFrames = input.getNumFrames();
+    const size_t numFrames = numInputFrames + (size_t)(tailSeconds * sampleRate);
+    
+    // effect engine and headless user interface
+    engine.setup(sampleRate, blockSize);
+    
+    userinterface.menu.setJSONLocation(jsonDirectory, false);
+    userinterface.setup(&engine, sampleRate);
+    userinterface.menu.handleMidiProgramChangeMessage(presetIndex);
+    
+    // seeded after the preset is loaded, the sequences start with the first block
+    engine.setRandomSeed(randomSeed);
+    
+    // audio buffers
+    std::vector<float> inputBuffer[2], outputBuffer[2];
+    for (uint ch = 0; ch < 2; ++ch)
+    {
+        inputBuffer[ch].resize(blockSize, 0.f);
+        outputBuffer[ch].resize(blockSize, 0.f);
+    }
+    
+    WavFile output;
+    output.sampleRate = sampleRate;
+    output.channels.assign(2, std::vector<float>(numFrames, 0.f));
+    
+    const float* const inputPointers[2] = { inputBuffer[0].data(), inputBuffer[1].data() };
+    float* const outputPointers[2] = { outputBuffer[0].data(), outputBuffer[1].data() };
+    
+    auto startTime = std::chrono::steady_clock::now();
+    
+    // process the file blockwise, following render() on the device
+    for (size_t frame = 0; frame < numFrames; frame += blockSize)
+    {
+        uint numBlockFrames = (uint)std::min((size_t)blockSize, numFrames - frame);
+        
+        // update effects blockwise
+        engine.updateAudioBlock();
+        
+        // read input buffer (zeros in the tail)
+        for (uint n = 0; n < numBlockFrames; ++n)
+        {
+            userinterface.processNonAudioTasks();
+            
+            for (uint ch = 0; ch < 2; ++ch)
+                inputBuffer[ch][n] = (frame + n < numInputFrames) ? input.channels[ch][frame + n] : 0.f;
+        }
+        
+        engine.processAudioBlock(inputPointers, outputPointers, numBlockFrames);
+        
+        // write output buffer
+        for (uint ch = 0; ch < 2; ++ch)
+            std::copy(outputBuffer[ch].begin(), outputBuffer[ch].begin() + numBlockFrames,
+                      output.channels[ch].begin() + frame);
+    }
+    
+    double renderSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    double audioSeconds = (double)numFrames / sampleRate;
+    
+    if (!output.write(outputPath, errorMessage))
+    {
+        rt_printf("%s\n", errorMessage.c_str());
+        return 1;
+    }
+    
+    rt_printf("rendered %.2f s of audio in %.2f s (%.1fx real time) with preset %u\n",
+              audioSeconds, renderSeconds, audioSeconds / std::max(renderSeconds, 1e-9), presetIndex);
+    
+    return 0;
+}
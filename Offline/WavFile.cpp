@@ -0,0 +1,184 @@
+#include "WavFile.h"
+
+#include <fstream>
+
+// =======================================================================================
+// MARK: - HELPERS
+// =======================================================================================
+
+namespace
+{
+
+static const uint16_t FORMAT_PCM = 1;
+static const uint16_t FORMAT_FLOAT = 3;
+static const uint16_t FORMAT_EXTENSIBLE = 0xFFFE;
+
+uint32_t readLE(const uint8_t* data_, const uint numBytes_)
+{
+    uint32_t value = 0;
+    for (uint n = 0; n < numBytes_; ++n) value |= (uint32_t)data_[n] << (8 * n);
+    return value;
+}
+
+void writeLE(std::ofstream& file_, const uint32_t value_, const uint numBytes_)
+{
+    for (uint n = 0; n < numBytes_; ++n) file_.put((char)((value_ >> (8 * n)) & 0xFF));
+}
+
+} // namespace
+
+
+// =======================================================================================
+// MARK: - READ
+// =======================================================================================
+
+bool WavFile::read(const String& path_, String& errorMessage_)
+{
+    std::ifstream file(path_, std::ios::binary);
+    if (!file.is_open())
+    {
+        errorMessage_ = "could not open " + path_;
+        return false;
+    }
+    
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    
+    if (bytes.size() < 12 || memcmp(bytes.data(), "RIFF", 4) != 0 || memcmp(bytes.data() + 8, "WAVE", 4) != 0)
+    {
+        errorMessage_ = path_ + " is not a RIFF/WAVE file";
+        return false;
+    }
+    
+    uint16_t format = 0, numChannels = 0, bitsPerSample = 0;
+    const uint8_t* audioData = nullptr;
+    size_t audioDataSize = 0;
+    
+    // walk through the chunks, each chunk is padded to an even size
+    size_t pos = 12;
+    while (pos + 8 <= bytes.size())
+    {
+        const uint8_t* chunk = bytes.data() + pos;
+        size_t chunkSize = readLE(chunk + 4, 4);
+        size_t available = std::min(chunkSize, bytes.size() - pos - 8);
+        
+        if (memcmp(chunk, "fmt ", 4) == 0 && available >= 16)
+        {
+            format = readLE(chunk + 8, 2);
+            numChannels = readLE(chunk + 10, 2);
+            sampleRate = (float)readLE(chunk + 12, 4);
+            bitsPerSample = readLE(chunk + 22, 2);
+            
+            // the actual format is the first two bytes of the subformat GUID
+            if (format == FORMAT_EXTENSIBLE && available >= 26) format = readLE(chunk + 32, 2);
+        }
+        else if (memcmp(chunk, "data", 4) == 0)
+        {
+            audioData = chunk + 8;
+            audioDataSize = available;
+        }
+        
+        pos += 8 + chunkSize + (chunkSize & 1);
+    }
+    
+    if (numChannels == 0 || audioData == nullptr)
+    {
+        errorMessage_ = path_ + " has no fmt or data chunk";
+        return false;
+    }
+    
+    bool isFloat = (format == FORMAT_FLOAT && bitsPerSample == 32);
+    bool isPCM = (format == FORMAT_PCM && (bitsPerSample == 16 || bitsPerSample == 24 || bitsPerSample == 32));
+    
+    if (!isFloat && !isPCM)
+    {
+        errorMessage_ = path_ + " has an unsupported sample format (format " + std::to_string(format)
+                        + ", " + std::to_string(bitsPerSample) + " bit)";
+        return false;
+    }
+    
+    uint bytesPerSample = bitsPerSample / 8;
+    size_t numFrames = audioDataSize / (bytesPerSample * numChannels);
+    float pcmScale = 1.f / (float)(1u << (bitsPerSample - 1));
+    
+    channels.assign(numChannels, std::vector<float>(numFrames, 0.f));
+    
+    for (size_t frame = 0; frame < numFrames; ++frame)
+    {
+        for (uint ch = 0; ch < numChannels; ++ch)
+        {
+            const uint8_t* sample = audioData + (frame * numChannels + ch) * bytesPerSample;
+            uint32_t raw = readLE(sample, bytesPerSample);
+            
+            if (isFloat)
+            {
+                float value;
+                memcpy(&value, &raw, sizeof(float));
+                channels[ch][frame] = value;
+            }
+            else
+            {
+                // sign extend to 32 bit
+                int32_t value = (int32_t)(raw << (32 - bitsPerSample)) >> (32 - bitsPerSample);
+                channels[ch][frame] = (float)value * pcmScale;
+            }
+        }
+    }
+    
+    return true;
+}
+
+
+// =======================================================================================
+// MARK: - WRITE
+// =======================================================================================
+
+bool WavFile::write(const String& path_, String& errorMessage_) const
+{
+    std::ofstream file(path_, std::ios::binary);
+    if (!file.is_open())
+    {
+        errorMessage_ = "could not create " + path_;
+        return false;
+    }
+    
+    uint numChannels = (uint)channels.size();
+    size_t numFrames = getNumFrames();
+    uint32_t dataSize = (uint32_t)(numFrames * numChannels * sizeof(float));
+    
+    // RIFF header
+    file.write("RIFF", 4);
+    writeLE(file, 36 + dataSize, 4);
+    file.write("WAVE", 4);
+    
+    // format chunk
+    file.write("fmt ", 4);
+    writeLE(file, 16, 4);
+    writeLE(file, FORMAT_FLOAT, 2);
+    writeLE(file, numChannels, 2);
+    writeLE(file, (uint32_t)sampleRate, 4);
+    writeLE(file, (uint32_t)sampleRate * numChannels * sizeof(float), 4);
+    writeLE(file, numChannels * sizeof(float), 2);
+    writeLE(file, 32, 2);
+    
+    // interleaved audio data
+    file.write("data", 4);
+    writeLE(file, dataSize, 4);
+    
+    for (size_t frame = 0; frame < numFrames; ++frame)
+    {
+        for (uint ch = 0; ch < numChannels; ++ch)
+        {
+            uint32_t raw;
+            memcpy(&raw, &channels[ch][frame], sizeof(float));
+            writeLE(file, raw, 4);
+        }
+    }
+    
+    if (!file.good())
+    {
+        errorMessage_ = "could not write " + path_;
+        return false;
+    }
+    
+    return true;
+}
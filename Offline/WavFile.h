@@ -0,0 +1,45 @@
+#ifndef WavFile_h
+#define WavFile_h
+
+#include "../Code/ConstantVariables.h"
+
+/**
+ * @file WavFile.h
+ * @brief Minimal reader and writer for RIFF/WAVE files, used by the offline renderer.
+ *
+ * Supported formats for reading are 16, 24 and 32 bit integer PCM and 32 bit float,
+ * plain or as WAVE_FORMAT_EXTENSIBLE. Files are always written as 32 bit float.
+ */
+
+/**
+ * @struct WavFile
+ * @brief Holds the non-interleaved audio data of a WAV file.
+ */
+struct WavFile
+{
+    float sampleRate = 44100.f;             ///< The sample rate of the file.
+    std::vector<std::vector<float>> channels; ///< The audio data, one vector per channel.
+    
+    /** @brief Returns the number of frames (samples per channel). */
+    size_t getNumFrames() const { return channels.empty() ? 0 : channels[0].size(); }
+    
+    /**
+     * @brief Reads a WAV file from disk.
+     *
+     * @param path_ The path of the file.
+     * @param errorMessage_ Receives a description of the problem if reading fails.
+     * @return True on success.
+     */
+    bool read(const String& path_, String& errorMessage_);
+    
+    /**
+     * @brief Writes the data as a 32 bit float WAV file.
+     *
+     * @param path_ The path of the file, an existing file will be overwritten.
+     * @param errorMessage_ Receives a description of the problem if writing fails.
+     * @return True on success.
+     */
+    bool write(const String& path_, String& errorMessage_) const;
+};
+
+#endif /* WavFile_h */
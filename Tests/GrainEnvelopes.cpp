@@ -0,0 +1,117 @@
+/**
+ * @file GrainEnvelopes.cpp
+ * @brief Checks that the grain clouds read their envelope tables within bounds, for every envelope type.
+ *
+ * Short, dense and varied grains die and are recycled often, so the free slots behind the active grains
+ * hold the state of grains that just died. Their lanes are masked but still gathered from the envelope
+ * tables, with a phase beyond the end of the table. A phase that isn't clamped reads the next table, and
+ * past the end of the tables for the last type. Run it with AddressSanitizer to catch that read:
+ *
+ *     g++ -std=c++17 -O1 -g -fsanitize=address -DGRAINMOTHER_OFFLINE -ICode -o grain-envelopes \
+ *         Tests/GrainEnvelopes.cpp $(find Code -name '*.cpp')
+ *     ./grain-envelopes
+ *
+ * Without the sanitizer only the output is checked. Returns 0 if every output is finite and not silent, 1 otherwise.
+ */
+
+#include "../Code/Engine.h"
+
+// =======================================================================================
+// MARK: - VARIABLES
+// =======================================================================================
+
+namespace TestVariables
+{
+
+static const float SAMPLE_RATE = 44100.f;
+static const uint BLOCKSIZE = 16;
+static const uint NUM_BLOCKS = 10000;  ///< about 3.6 seconds, thousands of grains at this length and density
+
+} // namespace TestVariables
+
+using namespace TestVariables;
+
+
+// =======================================================================================
+// MARK: - FUNCTIONS
+// =======================================================================================
+
+/**
+ * @brief Runs a granulator with short, dense and fully varied grains of one envelope type.
+ * @param type_ The envelope type.
+ * @return true if the output is finite and not silent
+ */
+bool testEnvelopeType(const uint type_)
+{
+    using namespace Granulation;
+    
+    std::unique_ptr<Granulator> granulator = std::make_unique<Granulator>();
+    granulator->setup(SAMPLE_RATE, BLOCKSIZE);
+    granulator->parameterChanged(Parameters::ENVELOPE_TYPE, (float)type_);
+    granulator->parameterChanged(Parameters::VARIATION, 100.f);
+    granulator->parameterChanged(Parameters::GRAINLENGTH, 7.f);
+    granulator->parameterChanged(Parameters::DENSITY, 30.f);
+    
+    std::vector<float> input[2], output[2];
+    RandomGenerator random;
+    
+    for (uint ch = 0; ch < 2; ++ch)
+    {
+        input[ch].resize(BLOCKSIZE, 0.f);
+        output[ch].resize(BLOCKSIZE, 0.f);
+    }
+    
+    bool finite = true;
+    float energy = 0.f;
+    
+    for (uint block = 0; block < NUM_BLOCKS; ++block)
+    {
+        for (uint ch = 0; ch < 2; ++ch)
+            for (uint k = 0; k < BLOCKSIZE; ++k) input[ch][k] = 0.5f * random.getBipolar();
+        
+        const float* const in[2] = { input[0].data(), input[1].data() };
+        float* const out[2] = { output[0].data(), output[1].data() };
+        
+        granulator->processAudioBlock(in, out, BLOCKSIZE);
+        
+        for (uint ch = 0; ch < 2; ++ch)
+        {
+            for (float sample : output[ch])
+            {
+                finite &= std::isfinite(sample);
+                energy += sample * sample;
+            }
+        }
+    }
+    
+    if (!finite)
+    {
+        rt_printf("FAILED %s: the output isn't finite\n", envelopeTypeNames[type_].c_str());
+        return false;
+    }
+    
+    if (energy == 0.f)
+    {
+        rt_printf("FAILED %s: the output is silent\n", envelopeTypeNames[type_].c_str());
+        return false;
+    }
+    
+    rt_printf("ok     %s\n", envelopeTypeNames[type_].c_str());
+    
+    return true;
+}
+
+
+// =======================================================================================
+// MARK: - MAIN
+// =======================================================================================
+
+int main()
+{
+    bool passed = true;
+    
+    for (uint type = 0; type < Granulation::numEnvelopeTypes; ++type)
+        passed &= testEnvelopeType(type);
+    
+    return passed ? 0 : 1;
+}
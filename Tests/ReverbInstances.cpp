@@ -0,0 +1,175 @@
+/**
+ * @file ReverbInstances.cpp
+ * @brief Checks that several Reverb instances in one process don't share any state.
+ *
+ * Two instances are fed the same noise and processed in turns, block by block, a third instance is processed on
+ * its own. All three have to produce bit-identical output, for every reverb type, through type switches and
+ * changes of the modulation. A delay line state that is shared between instances (e.g. a static write pointer)
+ * advances once per instance and block and makes the outputs differ.
+ *
+ * Build and run (from the repository root, on ARM or x86, see Simd.h):
+ *
+ *     g++ -std=c++17 -O2 -DGRAINMOTHER_OFFLINE -ICode -o reverb-instances \
+ *         Tests/ReverbInstances.cpp $(find Code -name '*.cpp')
+ *     ./reverb-instances
+ *
+ * Returns 0 if all outputs are identical, 1 otherwise.
+ */
+
+#include "../Code/Engine.h"
+
+// =======================================================================================
+// MARK: - VARIABLES
+// =======================================================================================
+
+namespace TestVariables
+{
+
+static const float SAMPLE_RATE = 44100.f;
+static const uint BLOCKSIZE = 16;
+static const uint NUM_BLOCKS = 20000;  ///< about 7 seconds, long enough for the modulated lines and the decay tails
+
+/** @brief The number of instances, the first two are processed in turns, the last one on its own. */
+static const uint NUM_INSTANCES = 3;
+
+} // namespace TestVariables
+
+using namespace TestVariables;
+
+
+// =======================================================================================
+// MARK: - FUNCTIONS
+// =======================================================================================
+
+/**
+ * @brief Changes the type and the modulation of a reverb in the middle of the run, the same for every instance.
+ * @param reverb_ The reverb.
+ * @param type_ The type the run started with.
+ * @param block_ The index of the block that is about to be processed.
+ */
+void changeParameters(Reverberation::Reverb& reverb_, const uint type_, const uint block_)
+{
+    using namespace Reverberation;
+    
+    if (block_ == NUM_BLOCKS / 4)
+    {
+        reverb_.parameterChanged(Parameters::MODRATE, 3.f);
+        reverb_.parameterChanged(Parameters::MODDEPTH, 80.f);
+    }
+    // switch to the next type and back while the first crossfade is still running
+    else if (block_ == NUM_BLOCKS / 2)
+    {
+        reverb_.parameterChanged(Parameters::TYPE, (type_ + 1) % NUM_TYPES);
+    }
+    else if (block_ == NUM_BLOCKS / 2 + 50)
+    {
+        reverb_.parameterChanged(Parameters::TYPE, type_);
+    }
+}
+
+
+/**
+ * @brief Runs all instances with one reverb type.
+ * @param type_ The type the run starts with.
+ * @return true if the outputs of all instances are identical
+ */
+bool testType(const uint type_)
+{
+    std::vector<std::unique_ptr<Reverberation::Reverb>> reverbs;
+    std::vector<float> outputs[NUM_INSTANCES][2];
+    
+    for (uint n = 0; n < NUM_INSTANCES; ++n)
+    {
+        reverbs.push_back(std::make_unique<Reverberation::Reverb>());
+        reverbs[n]->setup(SAMPLE_RATE, BLOCKSIZE);
+        reverbs[n]->parameterChanged(Reverberation::Parameters::TYPE, type_);
+        
+        for (uint ch = 0; ch < 2; ++ch) outputs[n][ch].resize(NUM_BLOCKS * BLOCKSIZE, 0.f);
+    }
+    
+    // the same noise for every instance, silence in the last quarter to check the tails as well
+    std::vector<float> input[2];
+    RandomGenerator random;
+    
+    for (uint ch = 0; ch < 2; ++ch)
+    {
+        input[ch].resize(NUM_BLOCKS * BLOCKSIZE, 0.f);
+        
+        for (uint k = 0; k < input[ch].size() * 3 / 4; ++k) input[ch][k] = 0.5f * random.getBipolar();
+    }
+    
+    // process the first instances in turns
+    for (uint block = 0; block < NUM_BLOCKS; ++block)
+    {
+        const uint offset = block * BLOCKSIZE;
+        const float* const in[2] = { input[0].data() + offset, input[1].data() + offset };
+        
+        for (uint n = 0; n < NUM_INSTANCES - 1; ++n)
+        {
+            changeParameters(*reverbs[n], type_, block);
+            
+            float* const out[2] = { outputs[n][0].data() + offset, outputs[n][1].data() + offset };
+            reverbs[n]->processAudioBlock(in, out, BLOCKSIZE);
+        }
+    }
+    
+    // and the last one on its own
+    Reverberation::Reverb& single = *reverbs[NUM_INSTANCES - 1];
+    
+    for (uint block = 0; block < NUM_BLOCKS; ++block)
+    {
+        const uint offset = block * BLOCKSIZE;
+        const float* const in[2] = { input[0].data() + offset, input[1].data() + offset };
+        float* const out[2] = { outputs[NUM_INSTANCES - 1][0].data() + offset, outputs[NUM_INSTANCES - 1][1].data() + offset };
+        
+        changeParameters(single, type_, block);
+        single.processAudioBlock(in, out, BLOCKSIZE);
+    }
+    
+    // compare sample by sample, bitwise
+    bool identical = true;
+    
+    for (uint n = 1; n < NUM_INSTANCES; ++n)
+    {
+        for (uint ch = 0; ch < 2; ++ch)
+        {
+            if (std::memcmp(outputs[0][ch].data(), outputs[n][ch].data(), outputs[0][ch].size() * sizeof(float)) == 0) continue;
+            
+            uint k = 0;
+            while (outputs[0][ch][k] == outputs[n][ch][k]) ++k;
+            
+            rt_printf("FAILED %s: instance %u differs from instance 0 in channel %u at sample %u (%g / %g)\n",
+                      Reverberation::reverbTypeNames[type_].c_str(), n, ch, k, outputs[0][ch][k], outputs[n][ch][k]);
+            identical = false;
+        }
+    }
+    
+    // silent outputs would be identical as well
+    float energy = 0.f;
+    for (float sample : outputs[0][0]) energy += sample * sample;
+    
+    if (energy == 0.f)
+    {
+        rt_printf("FAILED %s: the output is silent\n", Reverberation::reverbTypeNames[type_].c_str());
+        identical = false;
+    }
+    
+    if (identical) rt_printf("ok     %s\n", Reverberation::reverbTypeNames[type_].c_str());
+    
+    return identical;
+}
+
+
+// =======================================================================================
+// MARK: - MAIN
+// =======================================================================================
+
+int main()
+{
+    bool passed = true;
+    
+    for (uint type = 0; type < Reverberation::NUM_TYPES; ++type)
+        passed &= testType(type);
+    
+    return passed ? 0 : 1;
+}